@@ -50,9 +50,15 @@ typedef enum {
   InstrumentBeforeOp,
   InstrumentAfterOp,
   InstrumentReportTime,
-  InstrumentReportMemory
+  InstrumentReportMemory,
+  InstrumentReportCounters
 } InstrumentActions;
 
+/* Bits of the instrumentation tag above the actions hold the estimated number
+ * of floating point operations of the instrumented op, 0 if unknown. Must
+ * match OM_INSTRUMENT_FLOPS_SHIFT in OMInstrument.h. */
+#define InstrumentFlopsShift 8
+
 /* Onnx Mlir Compiler return code on errors; zero is success */
 typedef enum {
   CompilerSuccess = 0,            /* Zero is success. */
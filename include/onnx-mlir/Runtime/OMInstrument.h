@@ -42,6 +42,34 @@
 extern "C" {
 #endif
 
+/* Bits of the tag of an instrument point above the actions hold the estimated
+ * number of floating point operations of the op, 0 if unknown.
+ */
+#define OM_INSTRUMENT_FLOPS_SHIFT 8
+
+/* Binary trace file, written when env variable OMINSTRUMENTTRACE is set to a
+ * path not ending with ".json". The file is an OMTraceFileHeader followed by
+ * OMTraceEvent records in host byte order, the events of each thread being in
+ * time order.
+ */
+#define OM_TRACE_MAGIC "OMTRACE"
+#define OM_TRACE_VERSION 1
+
+typedef struct OMTraceFileHeader {
+  char magic[8];      /* OM_TRACE_MAGIC, including the null terminator. */
+  uint32_t version;   /* OM_TRACE_VERSION. */
+  uint32_t eventSize; /* sizeof(OMTraceEvent). */
+} OMTraceFileHeader;
+
+typedef struct OMTraceEvent {
+  uint64_t timeNs;    /* Monotonic time since OMInstrumentInit. */
+  int64_t vMemKB;     /* Virtual memory size, -1 if not reported. */
+  uint32_t tid;       /* Index of the thread, in order of first event. */
+  uint32_t tag;       /* Low bits of the tag of the instrument point. */
+  char opName[32];    /* Null terminated, truncated op name. */
+  char nodeName[64];  /* Null terminated, truncated node name, or empty. */
+} OMTraceEvent;
+
 /**
  * Initialize instrument.
  * Initialize counter and read env variables for control
@@ -65,6 +93,61 @@ OM_EXTERNAL_VISIBILITY void OMInstrumentInit();
 OM_EXTERNAL_VISIBILITY void OMInstrumentPoint(
     const char *opName, int64_t tag, const char *nodeName);
 
+/**
+ * Write the trace recorded since OMInstrumentInit.
+ * Tracing is enabled by setting env variable OMINSTRUMENTTRACE to a file path
+ * before OMInstrumentInit. The trace is also written to that file at exit.
+ * It should be called when no instrumented model is running.
+ *
+ * @param path of the trace file, or NULL for the path of OMINSTRUMENTTRACE.
+ * A path ending with ".json" gets a Chrome trace_event file, which can be
+ * opened with chrome://tracing or Perfetto, and other paths a binary trace.
+ * @return 0 on success, -1 if tracing is disabled or the file cannot be
+ * written.
+ *
+ */
+OM_EXTERNAL_VISIBILITY int OMInstrumentTraceFlush(const char *path);
+
+/**
+ * Return the profile report of the instrumented ops.
+ * Profiling is enabled by setting env variable OMINSTRUMENTPROFILE before
+ * OMInstrumentInit. The durations of the ops are aggregated per ONNX node
+ * since OMInstrumentInit or omInstrumentReset, and the report is also
+ * printed at exit.
+ *
+ * @return a table of the nodes sorted by decreasing total time, with their
+ * number of calls, total, mean, p50 and p99 time, and FLOP rate. The caller
+ * must free it. NULL if profiling is disabled.
+ *
+ */
+OM_EXTERNAL_VISIBILITY char *omInstrumentReport();
+
+/**
+ * Clear the profile of the instrumented ops.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void omInstrumentReset();
+
+/**
+ * Allocate memory for a model compiled with --instrument-allocations.
+ * The allocation is attributed to the op whose before instrument point was
+ * the last one of the thread, and accounted in the live and peak bytes of
+ * the report returned by omInstrumentReport.
+ *
+ * @param size in bytes, as for malloc.
+ * @return the allocated memory, which is freed by omInstrumentFree.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void *omInstrumentMalloc(size_t size);
+
+/**
+ * Free memory allocated by omInstrumentMalloc, or by malloc.
+ *
+ * @param ptr to the memory to free, or NULL.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void omInstrumentFree(void *ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------- OMRunStats.h - OMRunStats Declaration header -----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of API functions for the statistics of the
+// inferences of a model: number of calls and errors, and latency histogram per
+// entry point.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMRUNSTATS_H
+#define ONNX_MLIR_OMRUNSTATS_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdbool.h>
+#include <stdint.h>
+#endif // #ifdef __cplusplus
+
+#include "onnx-mlir/Compiler/OMCompilerMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct OMRunStats;
+
+#ifndef __cplusplus
+typedef struct OMRunStats OMRunStats;
+#endif
+
+/**
+ * Create the statistics of the inferences of a model.
+ * Recording is thread safe, and takes a few atomic additions, on compilers
+ * with GNU atomic builtins.
+ *
+ * @param modelName of the model, given as label of the exported metrics, or
+ * NULL for no label.
+ * @return a pointer to the statistics, NULL on allocation failure.
+ *
+ */
+OM_EXTERNAL_VISIBILITY OMRunStats *omRunStatsCreate(const char *modelName);
+
+/**
+ * Destroy the statistics.
+ *
+ * @param stats to destroy, or NULL.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void omRunStatsDestroy(OMRunStats *stats);
+
+/**
+ * Return the time of a monotonic clock, used to measure latencies.
+ *
+ * @return time in nanoseconds.
+ *
+ */
+OM_EXTERNAL_VISIBILITY uint64_t omRunStatsGetTimeNs();
+
+/**
+ * Record an inference.
+ *
+ * @param stats of the model.
+ * @param entryPointName of the inference, e.g. "run_main_graph". At most
+ * OM_RUN_STATS_MAX_ENTRY_POINTS different names are recorded.
+ * @param latencyNs of the inference, measured with omRunStatsGetTimeNs.
+ * @param failed is true if the inference returned an error, in which case
+ * its latency is not recorded.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void omRunStatsRecord(OMRunStats *stats,
+    const char *entryPointName, uint64_t latencyNs, bool failed);
+
+#define OM_RUN_STATS_MAX_ENTRY_POINTS 64
+
+/**
+ * Return the number of inferences of an entry point, including failed ones.
+ *
+ */
+OM_EXTERNAL_VISIBILITY int64_t omRunStatsGetCalls(
+    OMRunStats *stats, const char *entryPointName);
+
+/**
+ * Return the number of failed inferences of an entry point.
+ *
+ */
+OM_EXTERNAL_VISIBILITY int64_t omRunStatsGetErrors(
+    OMRunStats *stats, const char *entryPointName);
+
+/**
+ * Return a latency quantile of the successful inferences of an entry point.
+ * Latencies are counted in a histogram with 32 buckets per power of two, so
+ * quantiles are within 1.6% of the measured latencies.
+ *
+ * @param quantile between 0 and 1, e.g. 0.99 for p99.
+ * @return the latency in nanoseconds, or -1 if there is no inference.
+ *
+ */
+OM_EXTERNAL_VISIBILITY double omRunStatsGetLatencyNs(
+    OMRunStats *stats, const char *entryPointName, double quantile);
+
+/**
+ * Return the statistics in the Prometheus text exposition format: counters
+ * onnx_mlir_inference_calls_total and onnx_mlir_inference_errors_total, and
+ * summary onnx_mlir_inference_latency_seconds with the 0.5, 0.9, 0.99 and
+ * 0.999 quantiles, labelled by entry point and model.
+ *
+ * @return a null terminated string that the caller must free, or NULL on
+ * allocation failure.
+ *
+ */
+OM_EXTERNAL_VISIBILITY char *omRunStatsToPrometheus(OMRunStats *stats);
+
+/**
+ * Write the statistics in the Prometheus text format to a file, e.g. for the
+ * textfile collector of node_exporter. The file is written next to 'path' and
+ * renamed, so that it is never read partially written.
+ *
+ * @return 0 on success, -1 otherwise.
+ *
+ */
+OM_EXTERNAL_VISIBILITY int omRunStatsWritePrometheus(
+    OMRunStats *stats, const char *path);
+
+/**
+ * Clear the statistics of all entry points.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void omRunStatsReset(OMRunStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMRUNSTATS_H
@@ -167,6 +167,23 @@ OM_EXTERNAL_VISIBILITY void omTensorDestroy(OMTensor *tensor);
  */
 OM_EXTERNAL_VISIBILITY void *omTensorGetDataPtr(const OMTensor *tensor);
 
+/**
+ * \brief OMTensor data pointer setter.
+ *
+ * If the OMTensor owns its current data buffer, the buffer is freed first.
+ * This allows an OMTensor to be reused from one inference to the next, only
+ * changing the buffer of its numerical data.
+ *
+ * @param tensor pointer to the OMTensor
+ * @param owning whether allocatedPtr should be freed after tensor is destroyed.
+ * @param allocatedPtr allocated pointer to tensor content.
+ * @param alignedPtr aligned pointer to tensor content. If NULL will be set to
+ * allocatedPtr.
+ *
+ */
+OM_EXTERNAL_VISIBILITY void omTensorSetDataPtr(
+    OMTensor *tensor, int64_t owning, void *allocatedPtr, void *alignedPtr);
+
 /**
  * \brief OMTensor data shape getter.
  *
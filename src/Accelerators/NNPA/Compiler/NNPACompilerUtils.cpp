@@ -131,7 +131,7 @@ void addPassesNNPA(mlir::OwningOpRef<mlir::ModuleOp> &module,
         optLevel = OptLevel::O3;
       // Lower ONNX to Krnl, ZHigh to ZLow.
       addONNXToKrnlPasses(pm, optLevel, /*enableCSE*/ true,
-          instrumentONNXSignature, ONNXOpStats);
+          instrumentONNXSignature, ONNXOpStats, onnxCostModel);
 
       if (nnpaEmissionTarget >= EmitZLowIR)
         emissionTarget = EmitMLIR;
@@ -159,7 +159,8 @@ void addPassesNNPA(mlir::OwningOpRef<mlir::ModuleOp> &module,
 
   if (emissionTarget >= EmitLLVMIR)
     // Lower the remaining Krnl and all ZLow ops to LLVM dialect.
-    addKrnlToLLVMPasses(pm, /*enableCSE=*/true, verifyInputTensors);
+    addKrnlToLLVMPasses(
+        pm, /*enableCSE=*/true, verifyInputTensors, instrumentAllocations);
 }
 
 } // namespace onnx_mlir
@@ -12,6 +12,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "mlir/IR/AsmState.h"
+#include "mlir/IR/BuiltinAttributes.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -176,10 +178,30 @@ T swappedBytes(T x) {
     return llvm::sys::getSwappedBytes(x);
 }
 
-// Returns DenseElementsAttr with tp's data.
+// Returns a DenseResourceElementsAttr that references the external data in
+// place. The blob takes ownership of the (typically memory mapped) buffer and
+// releases it when the attribute's resource is dropped, so the data is only
+// paged in when something, e.g. the KrnlGlobal lowering, actually reads it.
+mlir::DenseResourceElementsAttr createDenseResourceElmAttr(
+    mlir::ShapedType tensorType, const onnx::TensorProto &tp,
+    std::unique_ptr<llvm::MemoryBuffer> externalData) {
+  llvm::StringRef buffer = externalData->getBuffer();
+  llvm::ArrayRef<char> data(buffer.data(), buffer.size());
+  mlir::AsmResourceBlob blob(data, alignof(char),
+      [externalData = std::move(externalData)](
+          void *, size_t, size_t) mutable { externalData.reset(); },
+      /*dataIsMutable=*/false);
+  return mlir::DenseResourceElementsAttr::get(tensorType,
+      tp.name().empty() ? "onnx" : tp.name(), std::move(blob));
+}
+
+// Returns ElementsAttr with tp's data. External data of at least
+// resourceThreshold bytes is returned as a DenseResourceElementsAttr, all
+// other data as a DenseElementsAttr.
 template <typename T>
-mlir::DenseElementsAttr createDenseElmAttr(mlir::ShapedType tensorType,
-    const onnx::TensorProto &tp, const std::string &externalDataDir) {
+mlir::ElementsAttr createElmAttr(mlir::ShapedType tensorType,
+    const onnx::TensorProto &tp, const std::string &externalDataDir,
+    int64_t resourceThreshold) {
   std::unique_ptr<llvm::MemoryBuffer> externalData =
       (tp.has_data_location() &&
           tp.data_location() == onnx::TensorProto::EXTERNAL)
@@ -195,6 +217,11 @@ mlir::DenseElementsAttr createDenseElmAttr(mlir::ShapedType tensorType,
       copy.resize_for_overwrite(size);
       std::transform(array.begin(), array.end(), copy.data(), swappedBytes<T>);
       return mlir::DenseElementsAttr::get(tensorType, llvm::makeArrayRef(copy));
+    } else if (externalData && !std::is_same_v<T, bool> &&
+               resourceThreshold >= 0 &&
+               buffer.size() >= static_cast<uint64_t>(resourceThreshold)) {
+      return createDenseResourceElmAttr(
+          tensorType, tp, std::move(externalData));
     } else {
       return mlir::DenseElementsAttr::get(tensorType, array);
     }
@@ -211,7 +238,7 @@ namespace onnx_mlir {
 
 mlir::Value EmitInitializerForInputTensor(mlir::Location loc,
     mlir::OpBuilder &builder, const std::string &externalDataDir,
-    const onnx::TensorProto &initializer) {
+    const onnx::TensorProto &initializer, int64_t resourceThreshold) {
   // Return none if the initializer is an empty tensor, e.g tensor<0xf32>.
   llvm::ArrayRef<int64_t> tensorDims(
       initializer.dims().data(), initializer.dims().size());
@@ -219,13 +246,14 @@ mlir::Value EmitInitializerForInputTensor(mlir::Location loc,
     return builder.create<mlir::ONNXNoneOp>(
         loc, builder.getNoneType(), builder.getUnitAttr());
 
-  mlir::DenseElementsAttr denseElmAttr =
-      onnxTensorProtoToDenseElmAttr(builder, externalDataDir, initializer);
-  return builder.create<mlir::ONNXConstantOp>(loc, nullptr, denseElmAttr);
+  mlir::ElementsAttr elmAttr = onnxTensorProtoToElmAttr(
+      builder, externalDataDir, initializer, resourceThreshold);
+  return builder.create<mlir::ONNXConstantOp>(loc, nullptr, elmAttr);
 }
 
-mlir::DenseElementsAttr onnxTensorProtoToDenseElmAttr(mlir::OpBuilder &builder,
-    const std::string &externalDataDir, const onnx::TensorProto &tp) {
+mlir::ElementsAttr onnxTensorProtoToElmAttr(mlir::OpBuilder &builder,
+    const std::string &externalDataDir, const onnx::TensorProto &tp,
+    int64_t resourceThreshold) {
   // Tensor dimensions.
   llvm::ArrayRef<int64_t> tensorDims(tp.dims().data(), tp.dims().size());
   mlir::Type elmType = convertONNXTypeToMLIRType(
@@ -233,31 +261,44 @@ mlir::DenseElementsAttr onnxTensorProtoToDenseElmAttr(mlir::OpBuilder &builder,
   auto tensorType = mlir::RankedTensorType::get(tensorDims, elmType);
   switch (tp.data_type()) {
   case (onnx::TensorProto::FLOAT16):
-    return createDenseElmAttr<float_16>(tensorType, tp, externalDataDir);
+    return createElmAttr<float_16>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::BFLOAT16):
-    return createDenseElmAttr<bfloat_16>(tensorType, tp, externalDataDir);
+    return createElmAttr<bfloat_16>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::FLOAT):
-    return createDenseElmAttr<float>(tensorType, tp, externalDataDir);
+    return createElmAttr<float>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::DOUBLE):
-    return createDenseElmAttr<double>(tensorType, tp, externalDataDir);
+    return createElmAttr<double>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::INT8):
-    return createDenseElmAttr<int8_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<int8_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::UINT8):
-    return createDenseElmAttr<uint8_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<uint8_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::INT16):
-    return createDenseElmAttr<int16_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<int16_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::UINT16):
-    return createDenseElmAttr<uint16_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<uint16_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::INT32):
-    return createDenseElmAttr<int32_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<int32_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::UINT32):
-    return createDenseElmAttr<uint32_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<uint32_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::INT64):
-    return createDenseElmAttr<int64_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<int64_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::UINT64):
-    return createDenseElmAttr<uint64_t>(tensorType, tp, externalDataDir);
+    return createElmAttr<uint64_t>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::BOOL):
-    return createDenseElmAttr<bool>(tensorType, tp, externalDataDir);
+    return createElmAttr<bool>(
+        tensorType, tp, externalDataDir, resourceThreshold);
   case (onnx::TensorProto::STRING): {
     // The string type is different from other data types in that it cannot be
     // raw or external data and it needs to be converted to StringAttr to
@@ -21,11 +21,15 @@
 
 namespace onnx_mlir {
 
+// Tensors stored as external data of at least resourceThreshold bytes are
+// imported as DenseResourceElementsAttr that reference the memory mapped data
+// instead of copying it. A negative resourceThreshold disables this.
 mlir::Value EmitInitializerForInputTensor(mlir::Location loc,
     mlir::OpBuilder &builder, const std::string &externalDataDir,
-    const onnx::TensorProto &initializer);
+    const onnx::TensorProto &initializer, int64_t resourceThreshold = -1);
 
-mlir::DenseElementsAttr onnxTensorProtoToDenseElmAttr(mlir::OpBuilder &builder,
-    const std::string &externalDataDir, const onnx::TensorProto &initializer);
+mlir::ElementsAttr onnxTensorProtoToElmAttr(mlir::OpBuilder &builder,
+    const std::string &externalDataDir, const onnx::TensorProto &initializer,
+    int64_t resourceThreshold = -1);
 
 } // namespace onnx_mlir
@@ -137,8 +137,8 @@ private:
   }
 
   Value ImportTensor(const onnx::TensorProto &tensor) {
-    return EmitInitializerForInputTensor(
-        UnknownLoc(), builder_, options_.externalDataDir, tensor);
+    return EmitInitializerForInputTensor(UnknownLoc(), builder_,
+        options_.externalDataDir, tensor, options_.resourceThreshold);
   }
 
   /*!
@@ -253,8 +253,8 @@ private:
           llvm::makeArrayRef(attr.ints().data(), attr.ints().size()));
       break;
     case onnx::AttributeProto::TENSOR:
-      mlirAttr = onnxTensorProtoToDenseElmAttr(
-          builder_, options_.externalDataDir, attr.t());
+      mlirAttr = onnxTensorProtoToElmAttr(builder_, options_.externalDataDir,
+          attr.t(), options_.resourceThreshold);
       break;
     case onnx::AttributeProto::STRINGS: {
       llvm::SmallVector<StringRef, 4> vectorStringRef;
@@ -56,6 +56,11 @@ struct ImportOptions {
   // Directory to look for external data if any tensor has external
   // data location. If empty then external data is disabled.
   std::string externalDataDir = "";
+  // External data tensors of at least this many bytes are imported as
+  // DenseResourceElementsAttr backed by a memory map of the external data
+  // file, so that weights are neither read nor copied during import.
+  // A negative value imports all tensors as DenseElementsAttr.
+  int64_t resourceThreshold = -1;
 };
 
 /*!
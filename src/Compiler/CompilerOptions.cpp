@@ -58,6 +58,15 @@ llvm::cl::opt<bool> useOnnxModelTypes("useOnnxModelTypes",
     llvm::cl::desc("use types and shapes from ONNX model"),
     llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<int64_t> externalDataResourceThreshold(
+    "externalDataResourceThreshold",
+    llvm::cl::desc(
+        "Import initializers stored as external data of at least this many "
+        "bytes as\n"
+        "memory mapped dense resources instead of copying them into the IR.\n"
+        "Set to -1 (default) to import all initializers as dense elements."),
+    llvm::cl::init(-1), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<int> repeatOnnxTransform("repeatOnnxTransform",
     llvm::cl::desc(
         "invoke extra onnx transform pass(shape inference, constant and etc.)"),
@@ -139,6 +148,14 @@ llvm::cl::opt<InstrumentStages> instrumentStage("instrument-stage",
             APPLY_TO_ACCELERATORS(ACCEL_INSTRUMENTSTAGE_CL_ENUM)),
     llvm::cl::init(Onnx), llvm::cl::cat(OnnxMlirCommonOptions));
 
+llvm::cl::opt<std::string> tilingDatabase("tiling-db",
+    llvm::cl::desc("JSON database of MatMul and Gemm tile sizes tuned per "
+                   "problem size, element type and --mcpu (see "
+                   "utils/TuneMatMulTiles.py). Problem sizes not in the "
+                   "database use the default tiling heuristics."),
+    llvm::cl::value_desc("path"), llvm::cl::init(""),
+    llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<std::string> instrumentOps("instrument-ops",
     llvm::cl::desc("Specify operations operations to be instrumented:\n"
                    "\"NONE\" or \"\" for no instrument,\n"
@@ -156,9 +173,19 @@ llvm::cl::bits<InstrumentActions> instrumentControlBits(
         clEnumVal(
             InstrumentReportTime, "instrument runtime reports time usage,"),
         clEnumVal(InstrumentReportMemory,
-            "instrument runtime reports memory usage.")),
+            "instrument runtime reports memory usage,"),
+        clEnumVal(InstrumentReportCounters,
+            "instrument runtime reports hardware performance counters.")),
     llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<bool> instrumentAllocations("instrument-allocations",
+    llvm::cl::desc("Allocate the buffers of the model through the runtime, "
+                   "which reports the live and peak bytes and the number of "
+                   "allocations per ONNX op (see omInstrumentReport).\n"
+                   "Allocations are attributed to the ops instrumented with "
+                   "--instrument-ops."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<bool> instrumentONNXSignature("instrument-onnx-signature",
     llvm::cl::desc("Instrument ONNX ops to print the type of their inputs"),
     llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
@@ -172,6 +199,34 @@ llvm::cl::opt<std::string> ONNXOpStats("onnx-op-stats",
         "commands."),
     llvm::cl::init(""), llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<bool> onnxCostModel("onnx-cost-model",
+    llvm::cl::desc("Report the FLOPs, bytes moved and arithmetic intensity of "
+                   "each ONNX node and of each function in JSON format.\n"
+                   "Dynamic dimensions are named after the model inputs.\n"
+                   "Requires targets like --EmitMLIR, --EmitLLVMIR, or "
+                   "binary-generating commands."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<PrecisionKind> precision("precision",
+    llvm::cl::desc("Precision of the float computations of the model:"),
+    llvm::cl::values(clEnumValN(FP32, "fp32",
+                         "Compute in the float types of the model (default),"),
+        clEnumValN(BF16Mixed, "bf16-mixed",
+            "Compute the f32 ops selected by --precision-ops in bf16. "
+            "Reductions, Softmax and normalizations stay in f32.")),
+    llvm::cl::init(FP32), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<std::string> precisionOps("precision-ops",
+    llvm::cl::desc("Specify operations to be computed in bf16 with "
+                   "--precision=bf16-mixed:\n"
+                   "\"ops1,ops2, ...\" for the multiple ops or node names.\n"
+                   "e.g. \"onnx.MatMul,onnx.Gemm\" for MatMul and Gemm ops.\n"
+                   "Asterisk is also available.\n"
+                   "Entries starting with '!' are kept in f32.\n"
+                   "e.g. \"!onnx.Conv\" to keep Conv ops in f32.\n"
+                   "Default is \"onnx.MatMul,onnx.Gemm,onnx.Conv\".\n"),
+    llvm::cl::init(""), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<bool> enableMemoryBundling("enable-memory-bundling",
     llvm::cl::desc(
         "Enable memory bundling related optimizations (default=false)\n"
@@ -189,6 +244,32 @@ llvm::cl::opt<bool> onnxOpTransformReport("onnx-op-transform-report",
     llvm::cl::desc("Report diagnostic info for op transform passes."),
     llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<int> onnxConstPropExpansionBound(
+    "onnx-const-prop-expansion-bound",
+    llvm::cl::desc(
+        "Max size in bytes of a constant produced by constant propagation "
+        "when\n"
+        "it is larger than the constants it is computed from, e.g. when "
+        "expanding\n"
+        "a broadcast. Larger results are not folded. Set to -1 (default) for "
+        "no bound."),
+    llvm::cl::init(-1), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> enableQDQFusion("enable-qdq-fusion",
+    llvm::cl::desc("Fuse the QDQ MatMul and Gemm islands of quantized models "
+                   "into QLinearMatMul for CPU targets (default=false).\n"
+                   "The fused ops run on scalar integer kernels, which may be "
+                   "slower than the float ones."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<std::string> qdqFusionReport("qdq-fusion-report",
+    llvm::cl::desc(
+        "Report the fused QDQ islands and the ones left in float, with the "
+        "reason, with --enable-qdq-fusion:\n"
+        "\"TXT\" for report as text,\n"
+        "\"JSON\" for report as JSON."),
+    llvm::cl::init(""), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<bool> enableParallel("parallel",
     llvm::cl::desc("Enable parallelization (default=false)\n"
                    "Set to 'true' if you want to enable parallelization."),
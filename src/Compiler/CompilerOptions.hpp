@@ -34,6 +34,13 @@ typedef enum {
   // clang-format on
 } InstrumentStages;
 
+typedef enum {
+  // Compute in the float types of the model.
+  FP32,
+  // Compute the ops selected by --precision-ops in bf16.
+  BF16Mixed,
+} PrecisionKind;
+
 // Options for onnx-mlir only.
 extern llvm::cl::OptionCategory OnnxMlirOptions;
 // Common options shared between onnx-mlir and onnx-mlir-opt.
@@ -46,6 +53,7 @@ extern llvm::cl::opt<bool> preserveBitcode;
 extern llvm::cl::opt<bool> preserveLLVMIR;
 extern llvm::cl::opt<bool> preserveMLIR;
 extern llvm::cl::opt<bool> useOnnxModelTypes;
+extern llvm::cl::opt<int64_t> externalDataResourceThreshold;
 extern llvm::cl::opt<int> repeatOnnxTransform;
 extern llvm::cl::opt<std::string> shapeInformation;
 extern llvm::cl::opt<onnx_mlir::OptLevel> OptimizationLevel;
@@ -62,13 +70,21 @@ extern llvm::cl::opt<bool> verifyInputTensors;
 extern llvm::cl::opt<bool> allowSorting;
 
 extern llvm::cl::opt<InstrumentStages> instrumentStage;
+extern llvm::cl::opt<std::string> tilingDatabase;
 extern llvm::cl::opt<std::string> instrumentOps;
 extern llvm::cl::bits<InstrumentActions> instrumentControlBits;
+extern llvm::cl::opt<bool> instrumentAllocations;
 extern llvm::cl::opt<bool> instrumentONNXSignature;
 extern llvm::cl::opt<std::string> ONNXOpStats;
+extern llvm::cl::opt<bool> onnxCostModel;
+extern llvm::cl::opt<PrecisionKind> precision;
+extern llvm::cl::opt<std::string> precisionOps;
 extern llvm::cl::opt<bool> enableMemoryBundling;
 extern llvm::cl::opt<int> onnxOpTransformThreshold;
 extern llvm::cl::opt<bool> onnxOpTransformReport;
+extern llvm::cl::opt<int> onnxConstPropExpansionBound;
+extern llvm::cl::opt<bool> enableQDQFusion;
+extern llvm::cl::opt<std::string> qdqFusionReport;
 extern llvm::cl::opt<bool> enableParallel;
 extern llvm::cl::opt<bool> enableSimdDataLayout;
 
@@ -57,26 +57,39 @@ void addONNXToMLIRPasses(mlir::PassManager &pm, int transformThreshold,
   pm.addPass(mlir::createCanonicalizerPass());
   pm.addPass(onnx_mlir::createShapeInferencePass());
   // Convolution Optimization for CPU: enable when there are no accelerators.
+  // QDQ islands of quantized models are fused into integer ops on request,
+  // for which only the CPU has kernels.
   if (targetCPU) {
+    if (enableQDQFusion)
+      pm.addNestedPass<func::FuncOp>(
+          onnx_mlir::createQDQFusionONNXToONNXPass(qdqFusionReport));
     pm.addNestedPass<func::FuncOp>(
         onnx_mlir::createConvOptONNXToONNXPass(enableSimdDataLayoutOpt));
     pm.addPass(onnx_mlir::createShapeInferencePass());
+    // Casts to bf16 are inserted before constant propagation, so that the
+    // casts of weights are folded.
+    if (precision == BF16Mixed)
+      pm.addNestedPass<func::FuncOp>(
+          onnx_mlir::createMixedPrecisionONNXToONNXPass(precisionOps));
   }
   // There are more opportunities for const propagation once all tensors have
   // inferred shapes.
-  pm.addNestedPass<func::FuncOp>(onnx_mlir::createConstPropONNXToONNXPass());
+  pm.addNestedPass<func::FuncOp>(
+      onnx_mlir::createConstPropONNXToONNXPass(onnxConstPropExpansionBound));
 
   if (transformThreshold > 0) {
     // Dynamic iterate in ONNXOpTransformPass
     pm.addPass(onnx_mlir::createONNXOpTransformPass(transformThreshold,
-        transformReport, targetCPU, enableSimdDataLayoutOpt));
+        transformReport, targetCPU, enableSimdDataLayoutOpt,
+        onnxConstPropExpansionBound));
   } else {
     // Statically add extra passes
     for (int i = 0; i < repeatOnnxTransform; i++) {
       pm.addPass(mlir::createCanonicalizerPass());
       pm.addPass(onnx_mlir::createShapeInferencePass());
       pm.addNestedPass<func::FuncOp>(
-          onnx_mlir::createConstPropONNXToONNXPass());
+          onnx_mlir::createConstPropONNXToONNXPass(
+              onnxConstPropExpansionBound));
     }
   }
 
@@ -88,7 +101,8 @@ void addONNXToMLIRPasses(mlir::PassManager &pm, int transformThreshold,
 }
 
 void addONNXToKrnlPasses(mlir::PassManager &pm, int optLevel, bool enableCSE,
-    bool enableInstrumentONNXSignature, std::string ONNXOpsStatFormat) {
+    bool enableInstrumentONNXSignature, std::string ONNXOpsStatFormat,
+    bool enableCostModel) {
   if (enableCSE)
     // Eliminate common sub-expressions before lowering to Krnl.
     // TODO: enable this by default when we make sure it works flawlessly.
@@ -111,6 +125,9 @@ void addONNXToKrnlPasses(mlir::PassManager &pm, int optLevel, bool enableCSE,
                    << ONNXOpsStatFormat << "\"\n";
     }
   }
+  // Report the cost of ONNX ops if enabled.
+  if (enableCostModel)
+    pm.addPass(onnx_mlir::createONNXCostModelPass());
   // Add instrumentation for Onnx Ops
   if (maccel.empty() && instrumentStage == Onnx)
     pm.addNestedPass<func::FuncOp>(onnx_mlir::createInstrumentPass(
@@ -121,7 +138,8 @@ void addONNXToKrnlPasses(mlir::PassManager &pm, int optLevel, bool enableCSE,
   if (enableInstrumentONNXSignature)
     pm.addNestedPass<func::FuncOp>(
         onnx_mlir::createInstrumentONNXSignaturePass());
-  pm.addPass(onnx_mlir::createLowerToKrnlPass(optLevel, enableParallel));
+  pm.addPass(onnx_mlir::createLowerToKrnlPass(
+      optLevel, enableParallel, tilingDatabase, mcpu));
   // An additional pass of canonicalization is helpful because lowering
   // from ONNX dialect to Standard dialect exposes additional canonicalization
   // opportunities.
@@ -136,8 +154,8 @@ void addKrnlToAffinePasses(mlir::PassManager &pm) {
       onnx_mlir::krnl::createConvertKrnlToAffinePass());
 }
 
-void addKrnlToLLVMPasses(
-    mlir::OpPassManager &pm, bool enableCSE, bool verifyInputTensors) {
+void addKrnlToLLVMPasses(mlir::OpPassManager &pm, bool enableCSE,
+    bool verifyInputTensors, bool instrumentAllocations) {
   if (enableCSE)
     // Eliminate common sub-expressions before lowering to Krnl.
     // TODO: enable this by default when we make sure it works flawlessly.
@@ -167,7 +185,8 @@ void addKrnlToLLVMPasses(
   pm.addNestedPass<func::FuncOp>(krnl::createConvertSeqToMemrefPass());
   pm.addNestedPass<func::FuncOp>(mlir::createConvertSCFToCFPass());
 
-  pm.addPass(krnl::createConvertKrnlToLLVMPass(verifyInputTensors));
+  pm.addPass(krnl::createConvertKrnlToLLVMPass(
+      verifyInputTensors, instrumentAllocations));
   pm.addPass(mlir::createReconcileUnrealizedCastsPass());
   pm.addPass(mlir::createCanonicalizerPass());
 }
@@ -208,13 +227,14 @@ void addPasses(mlir::OwningOpRef<ModuleOp> &module, mlir::PassManager &pm,
   if (emissionTarget >= EmitMLIR) {
     if (inputIRLevel <= ONNXLevel)
       addONNXToKrnlPasses(pm, OptimizationLevel, /*enableCSE*/ true,
-          instrumentONNXSignature, ONNXOpStats);
+          instrumentONNXSignature, ONNXOpStats, onnxCostModel);
     if (inputIRLevel <= MLIRLevel)
       addKrnlToAffinePasses(pm);
   }
 
   if (inputIRLevel <= LLVMLevel && emissionTarget >= EmitLLVMIR)
-    addKrnlToLLVMPasses(pm, /*enableCSE=*/true, verifyInputTensors);
+    addKrnlToLLVMPasses(
+        pm, /*enableCSE=*/true, verifyInputTensors, instrumentAllocations);
 }
 
 } // namespace onnx_mlir
@@ -19,10 +19,11 @@ namespace onnx_mlir {
 void addONNXToMLIRPasses(mlir::PassManager &pm, int transformThreshold,
     bool transformReport, bool targetCPU, bool enableSimdDataLayoutOpt);
 void addONNXToKrnlPasses(mlir::PassManager &pm, int optLevel, bool enableCSE,
-    bool enableInstrumentONNXSignature, std::string ONNXOpsStatFilename);
+    bool enableInstrumentONNXSignature, std::string ONNXOpsStatFilename,
+    bool enableCostModel);
 void addKrnlToAffinePasses(mlir::PassManager &pm);
-void addKrnlToLLVMPasses(
-    mlir::OpPassManager &pm, bool enableCSE, bool verifyInputTensors);
+void addKrnlToLLVMPasses(mlir::OpPassManager &pm, bool enableCSE,
+    bool verifyInputTensors, bool instrumentAllocations);
 InputIRLevelType determineInputIRLevel(
     mlir::OwningOpRef<mlir::ModuleOp> &module);
 void addPasses(mlir::OwningOpRef<mlir::ModuleOp> &module, mlir::PassManager &pm,
@@ -653,6 +653,7 @@ int processInputFile(StringRef inputFilename, mlir::MLIRContext &context,
     options.shapeInformation = shapeInformation;
     options.allowSorting = allowSorting;
     options.externalDataDir = dirName(inputFilename);
+    options.resourceThreshold = externalDataResourceThreshold;
     return ImportFrontendModelFile(
         inputFilename, context, module, errorMessage, options);
   } else if (inputIsMLIR)
@@ -84,9 +84,11 @@ public:
     // Option.
     bool fullUnrollAndJam = matmulOp.unroll();
 
-    // Operands and types.
+    // Operands and types. Computations are performed in the element type of
+    // C, which may be f32 when A and B hold 16-bit floats, or i32 when A and B
+    // hold 8-bit integers.
     Type elementType =
-        operandAdaptor.A().getType().cast<MemRefType>().getElementType();
+        operandAdaptor.C().getType().cast<MemRefType>().getElementType();
     bool simdize = matmulOp.simdize();
     // Init scope and emit constants.
     Location loc = matmulOp.getLoc();
@@ -305,6 +307,50 @@ public:
   }
 
 private:
+  // Extend a scalar or vector of A or B, whose elements are of type
+  // 'memElementType', to the computation type 'computeType'. Unsigned integers
+  // are zero extended, and other integers sign extended.
+  Value extendOperand(OpBuilder &builder, Location loc, Type memElementType,
+      Type computeType, Value val) const {
+    if (!memElementType.isa<IntegerType>())
+      return builder.create<arith::ExtFOp>(loc, computeType, val);
+    if (!memElementType.isUnsignedInteger())
+      return builder.create<arith::ExtSIOp>(loc, computeType, val);
+    // Arith ops only take signless integers.
+    Type signlessType =
+        builder.getIntegerType(memElementType.getIntOrFloatBitWidth());
+    if (VectorType vecType = val.getType().dyn_cast<VectorType>())
+      signlessType = VectorType::get(vecType.getShape(), signlessType);
+    Value signless =
+        builder.create<UnrealizedConversionCastOp>(loc, signlessType, val)
+            .getResult(0);
+    return builder.create<arith::ExtUIOp>(loc, computeType, signless);
+  }
+
+  // Load a scalar of A or B, extended to the computation type 'elementType'
+  // when A or B hold narrower floats or integers.
+  Value loadOperandIE(AffineBuilderKrnlMem &createAffine, Type elementType,
+      Value mem, ArrayRef<IndexExpr> start, ValueRange offsets) const {
+    Value val = createAffine.loadIE(mem, start, offsets);
+    if (val.getType() == elementType)
+      return val;
+    return extendOperand(createAffine.getBuilder(), createAffine.getLoc(),
+        val.getType(), elementType, val);
+  }
+
+  // Load a vector of A or B, extended to the computation type of 'vecType'
+  // when A or B hold narrower floats or integers.
+  Value loadVectorOperandIE(VectorBuilder &createVec, VectorType vecType,
+      Value mem, ArrayRef<IndexExpr> start, ValueRange offsets) const {
+    Type memElementType = mem.getType().cast<MemRefType>().getElementType();
+    if (memElementType == vecType.getElementType())
+      return createVec.loadIE(vecType, mem, start, offsets);
+    VectorType memVecType = VectorType::get(vecType.getShape(), memElementType);
+    Value val = createVec.loadIE(memVecType, mem, start, offsets);
+    return extendOperand(createVec.getBuilder(), createVec.getLoc(),
+        memElementType, vecType, val);
+  }
+
   void genScalar(AffineBuilderKrnlMem &createAffine, KrnlMatMulOp op,
       Type elementType, ArrayRef<IndexExpr> aStart, ArrayRef<IndexExpr> bStart,
       ArrayRef<IndexExpr> cStart, IndexExpr I, IndexExpr J, IndexExpr K,
@@ -339,8 +385,10 @@ private:
                 createAffine.forIE(zeroIE, K, 1,
                     [&](AffineBuilderKrnlMem &createAffine, Value k) {
                       MathBuilder createMath(createAffine);
-                      Value a = createAffine.loadIE(A, aStart, {i, k});
-                      Value b = createAffine.loadIE(B, bStart, {k, j});
+                      Value a = loadOperandIE(
+                          createAffine, elementType, A, aStart, {i, k});
+                      Value b = loadOperandIE(
+                          createAffine, elementType, B, bStart, {k, j});
                       Value res = createMath.mul(a, b);
                       res = createMath.add(
                           res, createAffine.load(TmpC, tmpCAccess));
@@ -408,11 +456,13 @@ private:
           // Iterates over the I indices (K is SIMD dim).
           // First compute A[i,k]*B[k, 1] for i=0..iUnrollFactor explicitly.
           // We reuse B[k][0] vector for each iteration of i.
-          Value vb = create.vec.loadIE(vecType, B, bStart, {k, iZero});
+          Value vb =
+              loadVectorOperandIE(create.vec, vecType, B, bStart, {k, iZero});
           // Generate computation for each i, manually unrolled for simplicity.
           for (int64_t i = 0; i < iUnrollFactor; ++i) {
             Value iVal = create.math.constantIndex(i);
-            Value va = create.vec.loadIE(vecType, A, aStart, {iVal, k});
+            Value va =
+                loadVectorOperandIE(create.vec, vecType, A, aStart, {iVal, k});
             Value vTmpProd = create.vec.load(vecType, TmpProd, {iVal});
             Value vres = create.vec.fma(va, vb, vTmpProd);
             create.vec.store(vres, TmpProd, {iVal});
@@ -488,9 +538,11 @@ private:
                 MultiDialectBuilder<MathBuilder, VectorBuilder> create(
                     createAffine);
                 kSaved = k;
-                Value a = createAffine.loadIE(A, aStart, {i, k});
+                Value a = loadOperandIE(
+                    createAffine, elementType, A, aStart, {i, k});
                 Value va = create.vec.broadcast(vecType, a);
-                Value vb = create.vec.loadIE(vecType, B, bStart, {k, iZero});
+                Value vb = loadVectorOperandIE(
+                    create.vec, vecType, B, bStart, {k, iZero});
                 // TTmpC() = vector_fma(va, vb, TTmpC());
                 Value tmpVal = createAffine.load(TmpC, tmpCAccess);
                 Value res = create.vec.fma(va, vb, tmpVal);
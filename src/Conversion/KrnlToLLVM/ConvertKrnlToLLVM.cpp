@@ -349,6 +349,27 @@ void genSignatureFunction(ModuleOp &module,
   }
 }
 
+/// Route the heap allocations of the module through the runtime, which
+/// records the live and peak bytes and the ONNX op that allocates them.
+void routeAllocationsToRuntime(ModuleOp module) {
+  OpBuilder b(module.getContext());
+  MultiDialectBuilder<LLVMBuilder> create(b, module.getLoc());
+  const std::pair<StringRef, StringRef> hooks[] = {
+      {"malloc", "omInstrumentMalloc"}, {"free", "omInstrumentFree"}};
+  for (const auto &hook : hooks) {
+    auto funcOp = module.lookupSymbol<LLVM::LLVMFuncOp>(hook.first);
+    if (!funcOp)
+      continue;
+    LLVM::LLVMFunctionType funcType = funcOp.getFunctionType();
+    FlatSymbolRefAttr hookRef = create.llvm.getOrInsertSymbolRef(module,
+        hook.second, funcType.getReturnType(), funcType.getParams());
+    module.walk([&](LLVM::CallOp callOp) {
+      if (callOp.getCallee() == hook.first)
+        callOp.setCalleeAttr(hookRef);
+    });
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // Krnl Dialect lowering pass
 //===----------------------------------------------------------------------===//
@@ -362,8 +383,9 @@ struct ConvertKrnlToLLVMPass
   ConvertKrnlToLLVMPass() = default;
   ConvertKrnlToLLVMPass(const ConvertKrnlToLLVMPass &pass)
       : PassWrapper<ConvertKrnlToLLVMPass, OperationPass<ModuleOp>>() {}
-  ConvertKrnlToLLVMPass(bool verifyInputTensors) {
+  ConvertKrnlToLLVMPass(bool verifyInputTensors, bool instrumentAllocations) {
     this->verifyInputTensors = verifyInputTensors;
+    this->instrumentAllocations = instrumentAllocations;
   }
 
   StringRef getArgument() const override { return "convert-krnl-to-llvm"; }
@@ -380,6 +402,12 @@ struct ConvertKrnlToLLVMPass
           "Data type and shape are verified. Enable this may introduce "
           "overhead in inferencing."),
       llvm::cl::init(false)};
+
+  Option<bool> instrumentAllocations{*this, "instrument-allocations",
+      llvm::cl::desc("Call omInstrumentMalloc and omInstrumentFree instead of "
+                     "malloc and free, so that the runtime reports the live "
+                     "and peak bytes allocated by each ONNX op."),
+      llvm::cl::init(false)};
 };
 
 void ConvertKrnlToLLVMPass::runOnOperation() {
@@ -445,14 +473,21 @@ void ConvertKrnlToLLVMPass::runOnOperation() {
   if (entryGlobalOps.size() >= 1)
     genSignatureFunction(
         module, entryGlobalOps, inSigGlobalOps, outSigGlobalOps);
+
+  // Allocations, including the ones of the entry points for the outputs, are
+  // all lowered to malloc and free calls by now.
+  if (instrumentAllocations)
+    routeAllocationsToRuntime(module);
 }
 
 /// Create the pass for lowering `Krnl`, `Affine` and `Std` dialects to LLVM.
 std::unique_ptr<Pass> createConvertKrnlToLLVMPass() {
   return std::make_unique<ConvertKrnlToLLVMPass>();
 }
-std::unique_ptr<Pass> createConvertKrnlToLLVMPass(bool verifyInputTensors) {
-  return std::make_unique<ConvertKrnlToLLVMPass>(verifyInputTensors);
+std::unique_ptr<Pass> createConvertKrnlToLLVMPass(
+    bool verifyInputTensors, bool instrumentAllocations) {
+  return std::make_unique<ConvertKrnlToLLVMPass>(
+      verifyInputTensors, instrumentAllocations);
 }
 
 void populateKrnlToLLVMConversion(LLVMTypeConverter &typeConverter,
@@ -42,8 +42,9 @@ public:
     ModuleOp module = op->getParentOfType<ModuleOp>();
     llvm::SmallVector<Type, 4> parameterTypeList;
     llvm::SmallVector<Value, 4> parameterList;
+    llvm::SmallVector<Value, 4> omTensors;
     handleOneParameter(rewriter, op, krnlCallAdaptor.result(),
-        krnlCallOp.result(), parameterTypeList, parameterList);
+        krnlCallOp.result(), parameterTypeList, parameterList, omTensors);
 
     // Some type of operands has been converted.
     // It is better to check the type of original operands.
@@ -53,7 +54,7 @@ public:
     for (; itConverted != krnlCallAdaptor.parameters().end();
          itConverted++, itOriginal++) {
       handleOneParameter(rewriter, op, *itConverted, *itOriginal,
-          parameterTypeList, parameterList);
+          parameterTypeList, parameterList, omTensors);
     }
 
     // Handle the Attributes
@@ -62,7 +63,7 @@ public:
       if (namedAttr.getName().getValue().equals("funcName"))
         continue;
       handleOneAttribute(rewriter, getTypeConverter(), op, namedAttr.getValue(),
-          parameterTypeList, parameterList);
+          parameterTypeList, parameterList, omTensors);
     }
 
     FlatSymbolRefAttr callRef =
@@ -70,6 +71,18 @@ public:
             LLVM::LLVMVoidType::get(module.getContext()), parameterTypeList);
     create.llvm.call({}, callRef, parameterList);
 
+    // The OMTensors only wrap the memrefs, and do not own their data. Destroy
+    // them so that calls in loops do not leak them.
+    if (!omTensors.empty()) {
+      Type opaquePtrTy =
+          LLVM::LLVMPointerType::get(IntegerType::get(module.getContext(), 8));
+      FlatSymbolRefAttr destroyRef =
+          create.llvm.getOrInsertSymbolRef(module, "omTensorDestroy",
+              LLVM::LLVMVoidType::get(module.getContext()), {opaquePtrTy});
+      for (Value omTensor : omTensors)
+        create.llvm.call({}, destroyRef, {omTensor});
+    }
+
     rewriter.eraseOp(op);
     return success();
   }
@@ -78,7 +91,8 @@ private:
   static void handleOneParameter(PatternRewriter &rewriter, Operation *op,
       Value parameter, Value original,
       llvm::SmallVector<Type, 4> &parameterTypeList,
-      llvm::SmallVector<Value, 4> &parameterList) {
+      llvm::SmallVector<Value, 4> &parameterList,
+      llvm::SmallVector<Value, 4> &omTensors) {
     MLIRContext *context = op->getContext();
     Location loc = op->getLoc();
     ModuleOp module = op->getParentOfType<ModuleOp>();
@@ -101,6 +115,7 @@ private:
       auto opaquePtrTy = LLVM::LLVMPointerType::get(int8Ty);
       parameterTypeList.emplace_back(opaquePtrTy);
       parameterList.emplace_back(omTensor);
+      omTensors.emplace_back(omTensor);
     } else {
       parameterTypeList.emplace_back(parameter.getType());
       parameterList.emplace_back(parameter);
@@ -110,7 +125,8 @@ private:
   static void handleOneAttribute(PatternRewriter &rewriter,
       TypeConverter *typeConverter, Operation *op, Attribute attribute,
       llvm::SmallVector<Type, 4> &parameterTypeList,
-      llvm::SmallVector<Value, 4> &parameterList) {
+      llvm::SmallVector<Value, 4> &parameterList,
+      llvm::SmallVector<Value, 4> &omTensors) {
     auto *context = op->getContext();
     Location loc = op->getLoc();
     ModuleOp module = op->getParentOfType<ModuleOp>();
@@ -176,6 +192,7 @@ private:
           auto opaquePtrTy = LLVM::LLVMPointerType::get(int8Ty);
           parameterTypeList.emplace_back(opaquePtrTy);
           parameterList.emplace_back(omTensor);
+          omTensors.emplace_back(omTensor);
         })
         .Default([&](Attribute attr) {
           llvm_unreachable("This type of Attribute used by krnl.call is not "
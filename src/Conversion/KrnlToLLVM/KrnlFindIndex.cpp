@@ -8,7 +8,7 @@
 //
 // =============================================================================
 //
-// This file lowers the KrnlFindIndexOp operator.
+// This file lowers the KrnlFindIndexOp and KrnlFindIndexBatchOp operators.
 //
 //===----------------------------------------------------------------------===//
 
@@ -120,9 +120,92 @@ private:
   }
 };
 
+class KrnlFindIndexBatchOpLowering : public ConversionPattern {
+public:
+  explicit KrnlFindIndexBatchOpLowering(
+      TypeConverter &typeConverter, MLIRContext *context)
+      : ConversionPattern(typeConverter,
+            KrnlFindIndexBatchOp::getOperationName(), 1, context) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const override {
+    auto findIndexBatchOp = cast<KrnlFindIndexBatchOp>(op);
+    Location loc = findIndexBatchOp.getLoc();
+    KrnlFindIndexBatchOpAdaptor operandAdaptor(operands);
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, loc);
+
+    // Get a symbol reference to the runtime function to use, creating one if
+    // necessary.
+    ModuleOp module = findIndexBatchOp->getParentOfType<ModuleOp>();
+    Type elementType = findIndexBatchOp.input()
+                           .getType()
+                           .cast<MemRefType>()
+                           .getElementType();
+    FlatSymbolRefAttr findIndexBatchRef =
+        getOrInsertFindIndexBatch(rewriter, module, elementType);
+
+    // Extract the aligned pointers of the memrefs.
+    auto alignedPtr = [&](Value memRef) {
+      Type ptrType =
+          memRef.getType().cast<LLVM::LLVMStructType>().getBody()[1];
+      return create.llvm.extractValue(ptrType, memRef, {1});
+    };
+    Value inputPtr = alignedPtr(operandAdaptor.input());
+    Value keysPtr = alignedPtr(operandAdaptor.keys());
+    SmallVector<Value, 8> callOperands = {inputPtr,
+        operandAdaptor.numberOfValues(), alignedPtr(operandAdaptor.G()),
+        alignedPtr(operandAdaptor.V()), operandAdaptor.len(), keysPtr};
+    // Strings are stored as i64 in memrefs, pass them as arrays of i8*,
+    // followed by the lengths of the keys.
+    if (elementType.isa<StringType>()) {
+      callOperands[0] = create.llvm.bitcastI8PtrPtr(inputPtr);
+      callOperands[5] = create.llvm.bitcastI8PtrPtr(keysPtr);
+      callOperands.emplace_back(alignedPtr(operandAdaptor.keyLens()));
+    }
+    callOperands.emplace_back(alignedPtr(operandAdaptor.indices()));
+
+    // Generate the call to the runtime function.
+    create.llvm.call({}, findIndexBatchRef, callOperands);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  /// Return a symbol reference to the appropriate 'find_index_*_batch'
+  /// runtime function, inserting it into the module if necessary.
+  static FlatSymbolRefAttr getOrInsertFindIndexBatch(
+      PatternRewriter &rewriter, ModuleOp module, Type elementType) {
+    MLIRContext *ctx = module.getContext();
+    Type voidType = LLVM::LLVMVoidType::get(ctx);
+    Type i8Type = IntegerType::get(ctx, 8);
+    Type i32Type = IntegerType::get(ctx, 32);
+    Type i64Type = IntegerType::get(ctx, 64);
+    Type i8PtrPtrType =
+        LLVM::LLVMPointerType::get(LLVM::LLVMPointerType::get(i8Type));
+    Type i32PtrType = LLVM::LLVMPointerType::get(i32Type);
+    Type i64PtrType = LLVM::LLVMPointerType::get(i64Type);
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, module.getLoc());
+
+    // Create 'find_index_*_batch' signature:
+    // `void (i8**, i64, i32*, i32*, i32, i8**, i32*, i64*)` for strings and
+    // `void (i64*, i64, i32*, i32*, i32, i64*, i64*)` for integers.
+    if (elementType.isa<StringType>())
+      return create.llvm.getOrInsertSymbolRef(module,
+          StringRef("find_index_str_batch"), voidType,
+          {i8PtrPtrType, i64Type, i32PtrType, i32PtrType, i32Type,
+              i8PtrPtrType, i32PtrType, i64PtrType});
+    return create.llvm.getOrInsertSymbolRef(module,
+        StringRef("find_index_i64_batch"), voidType,
+        {i64PtrType, i64Type, i32PtrType, i32PtrType, i32Type, i64PtrType,
+            i64PtrType});
+  }
+};
+
 void populateLoweringKrnlFindIndexOpPattern(TypeConverter &typeConverter,
     RewritePatternSet &patterns, MLIRContext *ctx) {
   patterns.insert<KrnlFindIndexOpLowering>(typeConverter, ctx);
+  patterns.insert<KrnlFindIndexBatchOpLowering>(typeConverter, ctx);
 }
 
 } // namespace krnl
@@ -45,8 +45,9 @@ public:
 
     // Get a symbol reference to the memcpy function, inserting it if necessary.
     ModuleOp parentModule = op->getParentOfType<ModuleOp>();
+    bool isRange = static_cast<bool>(operandAdaptor.firstValue());
     auto randomNormalFuncRef =
-        getOrInsertRandomNormal(rewriter, parentModule, inType);
+        getOrInsertRandomNormal(rewriter, parentModule, inType, isRange);
 
     // First operand.
     Type outputType = operandAdaptor.output()
@@ -56,10 +57,20 @@ public:
     Value alignedOutput =
         create.llvm.extractValue(outputType, operandAdaptor.output(), {1});
 
-    // Memcpy call
-    create.llvm.call({}, randomNormalFuncRef,
-        {alignedOutput, operandAdaptor.numberOfValues(), operandAdaptor.mean(),
-            operandAdaptor.scale(), operandAdaptor.seed()});
+    // Call with either the number of values, or the [begin, end) range of the
+    // values to generate.
+    SmallVector<Value, 6> callOperands{alignedOutput};
+    if (isRange) {
+      Value begin = operandAdaptor.firstValue();
+      callOperands.emplace_back(begin);
+      callOperands.emplace_back(rewriter.create<LLVM::AddOp>(
+          loc, begin.getType(), begin, operandAdaptor.numberOfValues()));
+    } else {
+      callOperands.emplace_back(operandAdaptor.numberOfValues());
+    }
+    callOperands.append({operandAdaptor.mean(), operandAdaptor.scale(),
+        operandAdaptor.seed()});
+    create.llvm.call({}, randomNormalFuncRef, callOperands);
 
     rewriter.eraseOp(op);
     return success();
@@ -67,17 +78,25 @@ public:
 
 private:
   FlatSymbolRefAttr getOrInsertRandomNormal(
-      PatternRewriter &rewriter, ModuleOp module, Type inType) const {
+      PatternRewriter &rewriter, ModuleOp module, Type inType,
+      bool isRange) const {
     MLIRContext *context = module.getContext();
     MultiDialectBuilder<LLVMBuilder> create(rewriter, module.getLoc());
-    StringRef functionName = inType.isF64() ? "get_random_normal_value_f64"
-                                            : "get_random_normal_value_f32";
+    StringRef functionName;
+    if (isRange)
+      functionName = inType.isF64() ? "get_random_normal_range_value_f64"
+                                    : "get_random_normal_range_value_f32";
+    else
+      functionName = inType.isF64() ? "get_random_normal_value_f64"
+                                    : "get_random_normal_value_f32";
     // Signature of the input is:
     //  "krnl.random_normal"(%0, %c60, %cst, %cst_0, %cst_1)
     // with types:
     //  (memref<3x4x5xf32>, index, f32, f32, f32)
     // or
     //  (memref<3x4x5xf64>, index, f64, f64, f64)
+    // and the range functions take the begin and end indices instead of the
+    // number of values.
     Type llvmVoidTy = LLVM::LLVMVoidType::get(context);
     Type llvmOptionsTy = FloatType::getF32(context);
     Type llvmOutputTy = LLVM::LLVMPointerType::get(llvmOptionsTy);
@@ -86,8 +105,12 @@ private:
       llvmOutputTy = LLVM::LLVMPointerType::get(llvmOptionsTy);
     }
     Type llvmI64Ty = IntegerType::get(context, 64);
-    return create.llvm.getOrInsertSymbolRef(module, functionName, llvmVoidTy,
-        {llvmOutputTy, llvmI64Ty, llvmOptionsTy, llvmOptionsTy, llvmOptionsTy});
+    SmallVector<Type, 6> argTypes{llvmOutputTy, llvmI64Ty};
+    if (isRange)
+      argTypes.emplace_back(llvmI64Ty);
+    argTypes.append({llvmOptionsTy, llvmOptionsTy, llvmOptionsTy});
+    return create.llvm.getOrInsertSymbolRef(
+        module, functionName, llvmVoidTy, argTypes);
   }
 };
 
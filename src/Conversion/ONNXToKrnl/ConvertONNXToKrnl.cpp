@@ -19,6 +19,7 @@
 
 #include "src/Accelerators/Accelerator.hpp"
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/TilingDatabase.hpp"
 
 using namespace mlir;
 
@@ -167,7 +168,7 @@ std::map<std::string, std::string> ONNXEntryPointLowering::typeMap = {
 
 void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
     TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling,
-    bool enableParallel) {
+    bool enableParallel, const TilingDatabase &tilingDB) {
   // Type conversion for function signatures.
   // Call MLIR FuncOp signature conversion when result type is
   // a ranked tensor.
@@ -185,14 +186,16 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
   populateLoweringONNXClipOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXCumSumOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXElementwiseOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXGemmOpPattern(patterns, typeConverter, ctx, enableTiling);
+  populateLoweringONNXGemmOpPattern(
+      patterns, typeConverter, ctx, enableTiling, tilingDB);
   populateLoweringONNXHardmaxOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXReductionOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXSoftmaxOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXTopKOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXMatMulOpPattern(
-      patterns, typeConverter, ctx, enableTiling);
-  populateLoweringONNXRandomNormalOpPattern(patterns, typeConverter, ctx);
+      patterns, typeConverter, ctx, enableTiling, tilingDB);
+  populateLoweringONNXRandomNormalOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
   populateLoweringONNXRandomNormalLikeOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXLRNOpPattern(patterns, typeConverter, ctx);
   // ML
@@ -230,7 +233,8 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
   populateLoweringONNXTileOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXFlattenOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXRangeOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXResizeOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXResizeOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
   populateLoweringONNXNonZeroOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXReverseSequenceOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXExpandOpPattern(patterns, typeConverter, ctx);
@@ -244,6 +248,19 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
       patterns, typeConverter, ctx, enableParallel);
   populateLoweringONNXNormalizationOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXPoolingOpPattern(patterns, typeConverter, ctx);
+  // Quantization
+  populateLoweringONNXConvIntegerOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
+  populateLoweringONNXDequantizeLinearOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXDynamicQuantizeLinearOpPattern(
+      patterns, typeConverter, ctx);
+  populateLoweringONNXMatMulIntegerOpPattern(
+      patterns, typeConverter, ctx, enableTiling);
+  populateLoweringONNXQLinearConvOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
+  populateLoweringONNXQLinearMatMulOpPattern(
+      patterns, typeConverter, ctx, enableTiling);
+  populateLoweringONNXQuantizeLinearOpPattern(patterns, typeConverter, ctx);
   // Recurrent neural network
   populateLoweringONNXGRUOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXLSTMOpPattern(patterns, typeConverter, ctx);
@@ -287,10 +304,14 @@ struct FrontendToKrnlLoweringPass
     this->enableTiling = enableTiling;
     this->enableParallel = enableParallel;
   }
-  FrontendToKrnlLoweringPass(int optLevel, bool enableParallel)
+  FrontendToKrnlLoweringPass(int optLevel, bool enableParallel,
+      const std::string &tilingDatabase, const std::string &mcpu)
       : FrontendToKrnlLoweringPass(
             /*emitDealloc=*/false, /*enableTiling=*/optLevel >= 3,
-            enableParallel) {}
+            enableParallel) {
+    this->tilingDatabase = tilingDatabase;
+    this->targetCPU = mcpu;
+  }
 
   void runOnOperation() final;
 
@@ -318,6 +339,18 @@ public:
       llvm::cl::init(false)};
   Option<bool> enableParallel{*this, "enable-parallel",
       llvm::cl::desc("Enable parallelization"), llvm::cl::init(false)};
+  Option<std::string> tilingDatabase{*this, "tiling-db",
+      llvm::cl::desc("JSON database of tuned MatMul/Gemm tile sizes, used "
+                     "when tiling is enabled"),
+      llvm::cl::init("")};
+  Option<std::string> targetCPU{*this, "mcpu",
+      llvm::cl::desc("Target cpu used to select the tiling database entries"),
+      llvm::cl::init("")};
+
+private:
+  // Tuned tile sizes read from 'tilingDatabase'. Each pass instance owns its
+  // database, which the Gemm and MatMul patterns reference.
+  TilingDatabase tilingDB;
 };
 
 void FrontendToKrnlLoweringPass::runOnOperation() {
@@ -326,6 +359,18 @@ void FrontendToKrnlLoweringPass::runOnOperation() {
   // Set up whether emitting dealloc for allocated memrefs or not.
   ONNXToKrnl_gEmitDealloc = emitDealloc;
 
+  // Load the tuned tile sizes, the lowerings falling back to their heuristics
+  // for the problem sizes not in the database.
+  tilingDB.clear();
+  if (enableTiling && !tilingDatabase.empty()) {
+    std::string errorMessage;
+    if (failed(tilingDB.load(tilingDatabase, targetCPU, errorMessage))) {
+      module.emitError(errorMessage);
+      signalPassFailure();
+      return;
+    }
+  }
+
   // The first thing to define is the conversion target. This will define the
   // final target for this lowering.
   ConversionTarget target(getContext());
@@ -405,8 +450,8 @@ void FrontendToKrnlLoweringPass::runOnOperation() {
   });
 
   // Define patterns.
-  populateONNXToKrnlConversionPattern(
-      patterns, krnlTypeConverter, &getContext(), enableTiling, enableParallel);
+  populateONNXToKrnlConversionPattern(patterns, krnlTypeConverter,
+      &getContext(), enableTiling, enableParallel, tilingDB);
 
   // Rewrite patterns for accelerators.
   for (auto *accel : onnx_mlir::accel::Accelerator::getAccelerators())
@@ -424,8 +469,10 @@ std::unique_ptr<Pass> createLowerToKrnlPass() {
   return std::make_unique<FrontendToKrnlLoweringPass>();
 }
 
-std::unique_ptr<Pass> createLowerToKrnlPass(int optLevel, bool enableParallel) {
-  return std::make_unique<FrontendToKrnlLoweringPass>(optLevel, enableParallel);
+std::unique_ptr<Pass> createLowerToKrnlPass(int optLevel, bool enableParallel,
+    const std::string &tilingDatabase, const std::string &mcpu) {
+  return std::make_unique<FrontendToKrnlLoweringPass>(
+      optLevel, enableParallel, tilingDatabase, mcpu);
 }
 
 std::unique_ptr<Pass> createLowerToKrnlPass(
@@ -129,8 +129,10 @@ struct ONNXCategoryMapperOpLowering : public ConversionPattern {
                                "default_string", default_string)
                          : nullptr;
 
-    // Lookup the index in the perfect hash table corresponding to
-    // each input value.
+    // Lookup the index in the dictionary of each input value, with one runtime
+    // call for the whole input. The index is -1 for values that are not in the
+    // dictionary. String keys are looked up with their lengths, so that most
+    // misses are detected without comparing characters.
     LiteralIndexExpr zeroIE(0);
     SmallVector<IndexExpr, 4> lbs(rank, zeroIE);
     SmallVector<IndexExpr, 4> ubs;
@@ -139,22 +141,32 @@ struct ONNXCategoryMapperOpLowering : public ConversionPattern {
     if (emitPrintStmts)
       create.krnl.printTensor("Input tensor:\n", X);
 
+    IndexExpr numberOfValues = LiteralIndexExpr(1);
+    for (IndexExpr ub : ubs)
+      numberOfValues = numberOfValues * ub;
+    MemRefType indicesMemRefType = MemRefType::get(
+        memRefType.getShape(), rewriter.getIntegerType(64));
+    Value indices = insertAllocAndDeallocSimple(rewriter, op,
+        indicesMemRefType, loc, ubs, /*insertDealloc=*/true);
+    if (elementType.isa<krnl::StringType>()) {
+      Value keyLens = createKeyLengths(cats_stringsAttr, create);
+      create.krnl.findIndexBatch(X, perfectHashTable.G, perfectHashTable.V,
+          perfectHashTable.len, constantForCatsStrings,
+          numberOfValues.getValue(), indices, keyLens);
+    } else {
+      create.krnl.findIndexBatch(X, perfectHashTable.G, perfectHashTable.V,
+          perfectHashTable.len, constantForCatsInt64s,
+          numberOfValues.getValue(), indices);
+    }
+
+    Value zero = create.math.constant(rewriter.getIntegerType(64), 0);
     ValueRange loopDef = create.krnl.defineLoops(rank);
     create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
         [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-          // Determine the index of 'inputElem' in the perfect hash table
-          // 'pHash'. Note: the index might not be valid (this happens
-          // when the 'inputElem' is not present in the perfect hash
-          // table).
-          Value inputElem =
-              loadElement(X, loopInd, elementType, rank, createKrnl);
-          if (emitPrintStmts)
-            create.krnl.printf("inputElem: ", inputElem, elementType);
-
-          Value index, isIndexValid;
-          std::tie(index, isIndexValid) =
-              emitFindIndex(inputElem, elementType, perfectHashTable,
-                  constantForCatsInt64s, constantForCatsStrings, create);
+          // The index of the input value is valid if it is not negative.
+          Value indexVal = createKrnl.load(indices, loopInd);
+          Value isIndexValid = create.math.sge(indexVal, zero);
+          Value index = create.math.castToIndex(indexVal);
 
           if (emitPrintStmts)
             create.krnl.printf("index: ", index, index.getType());
@@ -248,66 +260,18 @@ private:
     return res;
   }
 
-  Value loadElement(Value memref, ValueRange loopInd, Type elementType,
-      int64_t rank, KrnlBuilder &createKrnl) const {
-    Value inputElem;
-    TypeSwitch<Type>(elementType)
-        .Case<IntegerType>(
-            [&](IntegerType) { inputElem = createKrnl.load(memref, loopInd); })
-        .Case<krnl::StringType>([&](krnl::StringType stringType) {
-          MathBuilder createMath(createKrnl);
-          Value zero = createMath.constant(
-              createMath.getBuilder().getIntegerType(64), 0);
-          auto memRefType = MemRefType::get(
-              {rank}, krnl::StringType::get(elementType.getContext()));
-          Value stringMemRef = createKrnl.getRef(memRefType, memref, zero);
-          inputElem = createKrnl.load(stringMemRef, loopInd);
-        })
-        .Default([&](Type type) {
-          llvm::errs() << "type: " << type << "\n";
-          llvm_unreachable("Unexpected elementType");
-        });
-
-    return inputElem;
-  }
-
-  // Determine the index of 'inputElem' in the perfect hash table 'pHash'.
-  // Return the index and a true/false value depending on whether the index is
-  // valid or not.
-  std::tuple<Value, Value> emitFindIndex(Value inputElem, Type elementType,
-      const PerfectHashTable &pHash, Value constantForCatsInt64s,
-      Value constantForCatsStrings, const LocalDialectBuilder &create) const {
+  // Create a constant with the length of the string keys, in the order of
+  // the keys.
+  Value createKeyLengths(ArrayAttr cats_strings_ArrayAttr,
+      const LocalDialectBuilder &create) const {
     OpBuilder builder = create.krnl.getBuilder();
-    Value index = create.krnl.findIndex(inputElem, pHash.G, pHash.V, pHash.len);
-
-    std::tuple<Value, Value> res;
-    TypeSwitch<Type>(elementType)
-        .Case<IntegerType>([&](IntegerType type) {
-          // Determine whether the index returned is valid.
-          // The index is valid if 'inputElem' compares equal to the string in
-          // 'constantForCatsInt64s'.
-          Value compareVal = create.krnl.load(constantForCatsInt64s, {index});
-          Value isIndexValid = create.math.eq(inputElem, compareVal);
-          res = std::make_tuple(index, isIndexValid);
-        })
-        .Case<krnl::StringType>([&](krnl::StringType type) {
-          // Determine whether the index returned is valid.
-          // The index is valid if 'inputElem' compares equal to the string in
-          // 'constantForCatsStrings'.
-          Value compareVal = create.krnl.load(constantForCatsStrings, {index});
-          Value strlenRes = create.krnl.strlen(compareVal);
-          Value strncmpRes =
-              create.krnl.strncmp(inputElem, compareVal, strlenRes);
-          Value zeroVal = create.math.constant(builder.getIntegerType(32), 0);
-          Value isIndexValid = create.math.eq(strncmpRes, zeroVal);
-          res = std::make_tuple(index, isIndexValid);
-        })
-        .Default([&](Type type) {
-          llvm::errs() << "type: " << type << "\n";
-          llvm_unreachable("Illegal KeyTy");
-        });
-
-    return res;
+    SmallVector<int32_t> keyLens;
+    for (Attribute elemAttr : cats_strings_ArrayAttr.getValue())
+      keyLens.emplace_back(elemAttr.cast<StringAttr>().getValue().size());
+    MemRefType type = MemRefType::get(
+        {static_cast<int64_t>(keyLens.size())}, builder.getIntegerType(32));
+    return create.krnl.constant(
+        type, "cats_strings_lens", builder.getI32TensorAttr(keyLens));
   }
 
   // Store the result in the 'alloc' buffer.
@@ -771,49 +771,7 @@ Value emitScalarOpFor<ONNXRoundOp>(ConversionPatternRewriter &rewriter,
     ArrayRef<Value> scalarOperands) {
   Value x = scalarOperands[0];
   if (elementType.isa<FloatType>()) {
-    // Use numpy algorithm for rint as follows.
-    // ```
-    // double y, r;
-    // y = npy_floor(x);
-    // r = x - y;
-    //
-    // if (r > 0.5) {
-    //     y += 1.0;
-    // }
-    //
-    // /* Round to nearest even */
-    // if (r == 0.5) {
-    //     r = y - 2.0*npy_floor(0.5*y);
-    //     if (r == 1.0) {
-    //         y += 1.0;
-    //     }
-    // }
-    // return y;
-    // ```
-    MathBuilder createMath(rewriter, loc);
-    Value one = createMath.constant(elementType, 1.0);
-    Value two = createMath.constant(elementType, 2.0);
-    Value half = createMath.constant(elementType, 0.5);
-    Value y = rewriter.create<math::FloorOp>(loc, x);
-    Value r = createMath.sub(x, y);
-
-    // r > 0.5
-    Value rGreaterThanHalf =
-        rewriter.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OGT, r, half);
-    Value y1 = createMath.select(rGreaterThanHalf, createMath.add(y, one), y);
-
-    // r == 0.5: round to nearest even.
-    Value y2 = createMath.mul(half, y);
-    y2 = rewriter.create<math::FloorOp>(loc, y2);
-    y2 = createMath.mul(y2, two);
-    Value rr = createMath.sub(y, y2);
-    Value rrEqualOne =
-        rewriter.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, rr, one);
-    y2 = createMath.select(rrEqualOne, createMath.add(y, one), y);
-
-    Value rEqualHalf =
-        rewriter.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, r, half);
-    return createMath.select(rEqualHalf, y2, y1);
+    return emitRoundHalfToEven(rewriter, loc, x);
   } else {
     llvm_unreachable("unsupported element type");
   }
@@ -834,7 +792,7 @@ struct ONNXElementwiseUnaryOpLowering : public ConversionPattern {
     // call scalar computation and return the result. This is efficient when
     // elementwise ops are used as activations for ops like LSTM/GRU/RNN.
     if (!X.getType().isa<TensorType>() && !X.getType().isa<MemRefType>()) {
-      Value res = emitScalarOpFor<ElementwiseUnaryOp>(
+      Value res = emitScalarOpInComputeType<ElementwiseUnaryOp>(
           rewriter, loc, op, X.getType(), {X});
       rewriter.replaceOp(op, res);
       return success();
@@ -868,14 +826,15 @@ struct ONNXElementwiseUnaryOpLowering : public ConversionPattern {
       create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
           [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
             Value loadedVal = createKrnl.load(X, loopInd);
-            auto loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
-                rewriter, loc, op, memRefType.getElementType(), {loadedVal});
+            Value loweredOpResult =
+                emitScalarOpInComputeType<ElementwiseUnaryOp>(rewriter, loc, op,
+                    memRefType.getElementType(), {loadedVal});
             // Store result in the resulting array.
             createKrnl.store(loweredOpResult, alloc, loopInd);
           });
     } else {
       Value loadedVal = create.krnl.load(X);
-      auto loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
+      auto loweredOpResult = emitScalarOpInComputeType<ElementwiseUnaryOp>(
           rewriter, loc, op, memRefType.getElementType(), {loadedVal});
       // Store result in the resulting array.
       create.krnl.store(loweredOpResult, alloc);
@@ -956,7 +915,7 @@ struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
             Value rhs = createKrnl.loadIE(operands[1], rhsAccessExprs);
 
             // Apply the element-wise function.
-            Value result = emitScalarOpFor<ElementwiseBinaryOp>(
+            Value result = emitScalarOpInComputeType<ElementwiseBinaryOp>(
                 rewriter, loc, op, outputElementType, {lhs, rhs});
 
             // Store result in the resulting array.
@@ -967,7 +926,7 @@ struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
       Value rhs = create.krnl.load(operands[1]);
 
       // Apply the element-wise function.
-      Value result = emitScalarOpFor<ElementwiseBinaryOp>(
+      Value result = emitScalarOpInComputeType<ElementwiseBinaryOp>(
           rewriter, loc, op, outputElementType, {lhs, rhs});
 
       // Store result in the resulting array.
@@ -1004,6 +963,8 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
            "Failed to convert type to MemRefType");
     MemRefType outputMemRefType = convertedType.cast<MemRefType>();
     Type outputElementType = outputMemRefType.getElementType();
+    // 16-bit floats are accumulated in f32.
+    Type computeType = MathBuilder::getComputeType(outputElementType);
     uint64_t outputRank = outputMemRefType.getRank();
 
     // Shape helper.
@@ -1035,7 +996,9 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
             LogicalResult res = shapeHelper.getAccessExprs(
                 operands[0], 0, outputAccessExprs, oprdAccessExprs);
             assert(succeeded(res) && "Could not compute access indices");
-            Value accumulated = createKrnl.loadIE(operands[0], oprdAccessExprs);
+            MathBuilder createMath(createKrnl);
+            Value accumulated = createMath.extendToComputeType(
+                createKrnl.loadIE(operands[0], oprdAccessExprs));
 
             // Iterate over the remaining operands.
             for (unsigned i = 1; i < numArgs; i++) {
@@ -1044,31 +1007,39 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
               LogicalResult res = shapeHelper.getAccessExprs(
                   operands[i], i, outputAccessExprs, oprdAccessExprs);
               assert(succeeded(res) && "Could not compute access indices");
-              Value next = createKrnl.loadIE(operands[i], oprdAccessExprs);
+              Value next = createMath.extendToComputeType(
+                  createKrnl.loadIE(operands[i], oprdAccessExprs));
               // Fold.
               accumulated = emitScalarOpFor<ElementwiseVariadicOp>(
-                  rewriter, loc, op, outputElementType, {accumulated, next});
+                  rewriter, loc, op, computeType, {accumulated, next});
             }
 
             Value finalResult = emitPostProcessingFor<ElementwiseVariadicOp>(
-                rewriter, loc, op, outputElementType, accumulated);
+                rewriter, loc, op, computeType, accumulated);
+            finalResult = createMath.truncateToStorageType(
+                outputElementType, finalResult);
 
             // Store result in the resulting array.
             createKrnl.storeIE(finalResult, alloc, outputAccessExprs);
           });
     } else {
-      Value accumulated = create.krnl.load(operands[0]);
+      MathBuilder createMath(rewriter, loc);
+      Value accumulated =
+          createMath.extendToComputeType(create.krnl.load(operands[0]));
 
       // Iterate over the remaining operands.
       for (unsigned i = 1; i < numArgs; i++) {
         // Obtain the next operand.
-        Value next = create.krnl.load(operands[i]);
+        Value next =
+            createMath.extendToComputeType(create.krnl.load(operands[i]));
         // Fold.
         accumulated = emitScalarOpFor<ElementwiseVariadicOp>(
-            rewriter, loc, op, outputElementType, {accumulated, next});
+            rewriter, loc, op, computeType, {accumulated, next});
       }
       Value finalResult = emitPostProcessingFor<ElementwiseVariadicOp>(
-          rewriter, loc, op, outputElementType, accumulated);
+          rewriter, loc, op, computeType, accumulated);
+      finalResult =
+          createMath.truncateToStorageType(outputElementType, finalResult);
       // Store result in the resulting array.
       create.krnl.store(finalResult, alloc);
     }
@@ -15,6 +15,7 @@
 #include "llvm/Support/Debug.h"
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/TilingDatabase.hpp"
 #include "src/Dialect/Krnl/DialectBuilder.hpp"
 #include "src/Dialect/Krnl/KrnlHelper.hpp"
 #include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
@@ -24,6 +25,7 @@
 #define DEBUG_SIMD_OFF 0
 #define DEBUG_UNROLL_OFF 0
 #define DEBUG_OPTIMIZED_OFF 0
+#define DEBUG_PACK_OFF 0
 
 static constexpr int BUFFER_ALIGN = 128;
 
@@ -33,12 +35,14 @@ namespace onnx_mlir {
 
 template <typename GemmOp>
 struct ONNXGemmOpLowering : public ConversionPattern {
-  ONNXGemmOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling)
+  ONNXGemmOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableTiling, const TilingDatabase &tilingDB)
       : ConversionPattern(typeConverter, GemmOp::getOperationName(), 1, ctx),
-        enableTiling(enableTiling) {}
+        enableTiling(enableTiling), tilingDB(tilingDB) {}
 
   bool enableTiling;
+  // Tuned tile sizes, owned by the lowering pass.
+  const TilingDatabase &tilingDB;
 
   void genericGemm(ONNXGemmOp &gemmOp, ONNXGemmOpAdaptor &operandAdaptor,
       Type elementType, ONNXGemmOpShapeHelper &shapeHelper, Value alloc,
@@ -85,6 +89,8 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                 // Perform the reduction by adding a*b to reduction.
                 Value aVal = create.krnl.load(A, aAccess);
                 Value bVal = create.krnl.load(B, bAccess);
+                aVal = create.math.extendToComputeType(aVal);
+                bVal = create.math.extendToComputeType(bVal);
                 Value tmp = create.math.mul(aVal, bVal);
                 Value rVal = create.krnl.load(red);
                 create.krnl.store(create.math.add(tmp, rVal), red);
@@ -101,13 +107,43 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                   IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
                       .getValue());
             }
-            Value c = create.krnl.load(operandAdaptor.C(), cAccess);
+            Value c = create.math.extendToComputeType(
+                create.krnl.load(operandAdaptor.C(), cAccess));
             res = create.math.add(res, create.math.mul(betaVal, c));
           }
           create.krnl.store(res, R, outerIndices);
         });
   }
 
+  // Override the given tile sizes by the ones in the tiling database for this
+  // problem size, if any. Tuned sizes that cannot be used are ignored.
+  void applyTunedTileSizes(int64_t I, int64_t J, int64_t K, Type elementType,
+      int64_t &iCacheTile, int64_t &jCacheTile, int64_t &kCacheTile,
+      int64_t &iRegTile, int64_t &jRegTile) const {
+    Optional<MatMulTileSizes> tuned =
+        tilingDB.lookup("gemm", elementType, I, J, K);
+    if (!tuned)
+      return;
+    // Register tiles must divide their cache tiles.
+    int64_t iCache = tuned->iCacheTile > 0 ? tuned->iCacheTile : iCacheTile;
+    int64_t jCache = tuned->jCacheTile > 0 ? tuned->jCacheTile : jCacheTile;
+    int64_t kCache = tuned->kCacheTile > 0 ? tuned->kCacheTile : kCacheTile;
+    int64_t iReg = tuned->iRegTile > 0 ? tuned->iRegTile : iRegTile;
+    int64_t jReg = tuned->jRegTile > 0 ? tuned->jRegTile : jRegTile;
+    if (iCache % iReg != 0 || jCache % jReg != 0) {
+      LLVM_DEBUG(llvm::dbgs() << "Gemm: ignore invalid tuned tile sizes\n");
+      return;
+    }
+    iCacheTile = iCache;
+    jCacheTile = jCache;
+    kCacheTile = kCache;
+    iRegTile = iReg;
+    jRegTile = jReg;
+    LLVM_DEBUG(llvm::dbgs() << "Gemm: tuned tiles cache " << iCacheTile << ", "
+                            << jCacheTile << ", " << kCacheTile << ", reg "
+                            << iRegTile << ", " << jRegTile << "\n");
+  }
+
   void tiledTransposedGemm(ONNXGemmOp &gemmOp,
       ONNXGemmOpAdaptor &operandAdaptor, Type elementType,
       ONNXGemmOpShapeHelper &shapeHelper, Value alloc, Value zeroVal,
@@ -124,14 +160,20 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     LiteralIndexExpr zeroIE(0);
     Value z = zeroIE.getValue();
 
-    // Initialize alloc/R to zero.
+    // Initialize alloc/R to zero. R is in f32 when A and B are 16-bit floats,
+    // in which case the A and B tiles are padded with a 16-bit zero.
     KrnlBuilder createKrnl(rewriter, loc);
     createKrnl.memset(R, zeroVal);
+    Value abZero = MathBuilder(createKrnl).constant(elementType, 0);
 
     // Prepare for the computations.
-    // 1) Define blocking, with simdization along the j axis.
-    const int64_t iCacheTile(32), jCacheTile(64), kCacheTile(256);
-    const int64_t iRegTile(4), jRegTile(16);
+    // 1) Define blocking, with simdization along the j axis. Use the tile
+    // sizes tuned for this problem size, if any.
+    int64_t iCacheTile(32), jCacheTile(64), kCacheTile(256);
+    int64_t iRegTile(4), jRegTile(16);
+    if (I.isLiteral() && J.isLiteral() && K.isLiteral())
+      applyTunedTileSizes(I.getLiteral(), J.getLiteral(), K.getLiteral(),
+          elementType, iCacheTile, jCacheTile, kCacheTile, iRegTile, jRegTile);
 
     bool unrollAndJam = DEBUG_UNROLL_OFF ? false : true;
     // Simdize with jRegTile as the vector length.
@@ -158,7 +200,41 @@ struct ONNXGemmOpLowering : public ConversionPattern {
       }
     }
 
-    // 2) Alloc data for tiles.
+    // 2) Alloc data for tiles. A constant B is packed at compile time into
+    // the panels of B tiles used by the matmul, so that B tiles are not copied
+    // into a buffer at runtime. The packing clamps the K and J cache tiles to
+    // the size of a small B, and the loops below are tiled accordingly.
+    Value bPacked;
+    int64_t numKPanels = 0;
+    if (!DEBUG_PACK_OFF) {
+      DenseElementsAttr bAttr =
+          getDenseElementAttributeFromConstantValue(operandAdaptor.B());
+      if (!bAttr)
+        bAttr = getDenseElementAttributeFromConstantValue(gemmOp.B());
+      bPacked = emitPackedMatMulBPanels(
+          createKrnl, bAttr, bTrans, kCacheTile, jCacheTile, jRegTile);
+      if (bPacked) {
+        int64_t bK = bAttr.getType().getShape()[bTrans ? 1 : 0];
+        numKPanels = (bK + kCacheTile - 1) / kCacheTile;
+        LLVM_DEBUG(llvm::dbgs() << "Gemm with packed constant B\n");
+      }
+    }
+    // Return the start indices in the packed B for the B tile at (k1, j1).
+    // Packed panels are stacked along the rows, with panel (j1 / jCacheTile,
+    // k1 / kCacheTile) starting at row (j1 / jCacheTile * numKPanels + k1 /
+    // kCacheTile) * kCacheTile.
+    auto getPackedBStart = [&](Value k1, Value j1) -> SmallVector<Value, 2> {
+      IndexExprScope scope(createKrnl);
+      DimIndexExpr kStart(k1), jStart(j1);
+      IndexExpr panel = jStart.floorDiv(jCacheTile) * numKPanels +
+                        kStart.floorDiv(kCacheTile);
+      IndexExpr kMemStart = kStart - panel * kCacheTile;
+      return {kMemStart.getValue(), jStart.getValue()};
+    };
+    SmallVector<int64_t, 2> bTileSize;
+    if (bPacked)
+      bTileSize = {kCacheTile, jCacheTile};
+
     MemRefType aTileType =
         MemRefType::get({iCacheTile, kCacheTile}, elementType);
     MemRefType bTileType =
@@ -166,12 +242,17 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     SmallVector<IndexExpr, 1> empty;
     Value aBuff = insertAllocAndDeallocSimple(
         rewriter, gemmOp, aTileType, loc, empty, true, BUFFER_ALIGN);
-    Value bBuff = insertAllocAndDeallocSimple(
-        rewriter, gemmOp, bTileType, loc, empty, true, BUFFER_ALIGN);
+    Value bBuff = bPacked;
+    if (!bPacked)
+      bBuff = insertAllocAndDeallocSimple(
+          rewriter, gemmOp, bTileType, loc, empty, true, BUFFER_ALIGN);
     Value rBuff;
-    if (mustTileR)
+    if (mustTileR) {
+      MemRefType rTileType = MemRefType::get(aTileType.getShape(),
+          R.getType().cast<MemRefType>().getElementType());
       rBuff = insertAllocAndDeallocSimple(
-          rewriter, gemmOp, aTileType, loc, empty, true, BUFFER_ALIGN);
+          rewriter, gemmOp, rTileType, loc, empty, true, BUFFER_ALIGN);
+    }
 
     // 3) introduce the loops and permute them
     // I, J, K loop.
@@ -205,24 +286,27 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                 [&](KrnlBuilder &createKrnl, ValueRange k1_index) {
                   Value k1(k1_index[0]);
                   if (aTrans)
-                    createKrnl.copyToBuffer(aBuff, A, {k1, i1}, zeroVal, true);
+                    createKrnl.copyToBuffer(aBuff, A, {k1, i1}, abZero, true);
                   else
-                    createKrnl.copyToBuffer(aBuff, A, {i1, k1}, zeroVal, false);
-                  if (bTrans)
-                    createKrnl.copyToBuffer(bBuff, B, {j1, k1}, zeroVal, true);
+                    createKrnl.copyToBuffer(aBuff, A, {i1, k1}, abZero, false);
+                  SmallVector<Value, 2> bStart{k1, j1};
+                  if (bPacked)
+                    bStart = getPackedBStart(k1, j1);
+                  else if (bTrans)
+                    createKrnl.copyToBuffer(bBuff, B, {j1, k1}, abZero, true);
                   else
-                    createKrnl.copyToBuffer(bBuff, B, {k1, j1}, zeroVal, false);
+                    createKrnl.copyToBuffer(bBuff, B, {k1, j1}, abZero, false);
                   createKrnl.iterate({}, {jj2, ii2}, {}, {},
                       [&](KrnlBuilder &createKrnl, ValueRange j2_i2_indices) {
                         Value j2(j2_i2_indices[0]), i2(j2_i2_indices[1]);
                         ArrayRef<int64_t> empty;
-                        createKrnl.matmul(aBuff, {i1, k1}, bBuff, {k1, j1},
+                        createKrnl.matmul(aBuff, {i1, k1}, bBuff, bStart,
                             rBuff, {i1, j1},
                             /*loops*/ {ii3, jj3, kk2},
                             /*compute start*/ {i2, j2, k1},
                             /*ubs*/ {I.getValue(), J.getValue(), K.getValue()},
                             /*compute tile*/ {iRegTile, jRegTile, kCacheTile},
-                            /* a/b/c tiles*/ empty, empty, empty, simdize,
+                            /* a/b/c tiles*/ empty, bTileSize, empty, simdize,
                             unrollAndJam, false);
                       });
                 });
@@ -246,28 +330,31 @@ struct ONNXGemmOpLowering : public ConversionPattern {
       createKrnl.iterateIE({jj, kk, ii}, {jj1, kk1}, {zeroIE, zeroIE, zeroIE},
           {J, K, I}, [&](KrnlBuilder &createKrnl, ValueRange j1_k1_indices) {
             Value j1(j1_k1_indices[0]), k1(j1_k1_indices[1]);
-            if (bTrans)
-              createKrnl.copyToBuffer(bBuff, B, {j1, k1}, zeroVal, true);
+            SmallVector<Value, 2> bStart{k1, j1};
+            if (bPacked)
+              bStart = getPackedBStart(k1, j1);
+            else if (bTrans)
+              createKrnl.copyToBuffer(bBuff, B, {j1, k1}, abZero, true);
             else
-              createKrnl.copyToBuffer(bBuff, B, {k1, j1}, zeroVal, false);
+              createKrnl.copyToBuffer(bBuff, B, {k1, j1}, abZero, false);
             createKrnl.iterateIE({}, {ii1}, {}, {},
                 [&](KrnlBuilder &createKrnl, ValueRange i1_index) {
                   Value i1(i1_index[0]);
                   if (aTrans)
-                    createKrnl.copyToBuffer(aBuff, A, {k1, i1}, zeroVal, true);
+                    createKrnl.copyToBuffer(aBuff, A, {k1, i1}, abZero, true);
                   else
-                    createKrnl.copyToBuffer(aBuff, A, {i1, k1}, zeroVal, false);
+                    createKrnl.copyToBuffer(aBuff, A, {i1, k1}, abZero, false);
                   createKrnl.iterate({}, {jj2, ii2}, {}, {},
                       [&](KrnlBuilder &createKrnl, ValueRange j2_i2_indices) {
                         Value j2(j2_i2_indices[0]), i2(j2_i2_indices[1]);
-                        createKrnl.matmul(aBuff, {i1, k1}, bBuff, {k1, j1}, R,
+                        createKrnl.matmul(aBuff, {i1, k1}, bBuff, bStart, R,
                             {z, z},
                             /*loops*/ {ii3, jj3, kk2},
                             /*compute start*/ {i2, j2, k1},
                             /*ubs*/ {I.getValue(), J.getValue(), K.getValue()},
                             /*compute tile*/ {iRegTile, jRegTile, kCacheTile},
-                            /* a/b/c tiles*/ {}, {}, {}, simdize, unrollAndJam,
-                            false);
+                            /* a/b/c tiles*/ {}, bTileSize, {}, simdize,
+                            unrollAndJam, false);
                       });
                 });
           });
@@ -298,7 +385,8 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                   IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
                       .getValue());
             }
-            Value c = createKrnl.load(operandAdaptor.C(), cAccess);
+            Value c = createMath.extendToComputeType(
+                createKrnl.load(operandAdaptor.C(), cAccess));
             if (betaLit != 1.0)
               c = createMath.mul(betaVal, c);
             res = createMath.add(res, c);
@@ -329,13 +417,19 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     Value alloc = insertAllocAndDeallocSimple(rewriter, op, outputMemRefType,
         loc, shapeHelper.getOutputDims(), (int64_t)BUFFER_ALIGN);
 
+    // Products of 16-bit floats are accumulated in f32, in a temporary result
+    // that is truncated into the output at the end.
+    Type computeType = MathBuilder::getComputeType(elementType);
+    Value result = insertComputeTypeAlloc(
+        rewriter, op, alloc, loc, (int64_t)BUFFER_ALIGN);
+
     // Get the constants: zero, alpha,and beta.
     float alphaLit = gemmOp.alpha().convertToFloat();
     float betaLit = gemmOp.beta().convertToFloat();
     MathBuilder createMath(rewriter, loc);
-    Value alpha = createMath.constant(elementType, alphaLit);
-    Value beta = createMath.constant(elementType, betaLit);
-    Value zero = createMath.constant(elementType, 0);
+    Value alpha = createMath.constant(computeType, alphaLit);
+    Value beta = createMath.constant(computeType, betaLit);
+    Value zero = createMath.constant(computeType, 0);
 
     LLVM_DEBUG({
       if (DEBUG_SIMD_OFF)
@@ -373,20 +467,22 @@ struct ONNXGemmOpLowering : public ConversionPattern {
 
     if (enableTiling && !DEBUG_OPTIMIZED_OFF) {
       tiledTransposedGemm(gemmOp, operandAdaptor, elementType, shapeHelper,
-          alloc, zero, alpha, beta, rewriter, loc);
+          result, zero, alpha, beta, rewriter, loc);
     } else {
-      genericGemm(gemmOp, operandAdaptor, elementType, shapeHelper, alloc, zero,
-          alpha, beta, rewriter, loc);
+      genericGemm(gemmOp, operandAdaptor, computeType, shapeHelper, result,
+          zero, alpha, beta, rewriter, loc);
     }
+    emitTruncateToStorageType(KrnlBuilder(rewriter, loc), result, alloc);
     rewriter.replaceOp(op, alloc);
     return success();
   }
 };
 
 void populateLoweringONNXGemmOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling,
+    const TilingDatabase &tilingDB) {
   patterns.insert<ONNXGemmOpLowering<ONNXGemmOp>>(
-      typeConverter, ctx, enableTiling);
+      typeConverter, ctx, enableTiling, tilingDB);
 }
 
 } // namespace onnx_mlir
@@ -15,6 +15,7 @@
 #include "llvm/Support/Debug.h"
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/TilingDatabase.hpp"
 #include "src/Dialect/Krnl/DialectBuilder.hpp"
 #include "src/Dialect/Krnl/KrnlHelper.hpp"
 #include "src/Dialect/Mlir/DialectBuilder.hpp"
@@ -29,12 +30,14 @@ using namespace mlir;
 namespace onnx_mlir {
 
 struct ONNXMatMulOpLowering : public ConversionPattern {
-  ONNXMatMulOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling)
+  ONNXMatMulOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableTiling, const TilingDatabase &tilingDB)
       : ConversionPattern(
             typeConverter, mlir::ONNXMatMulOp::getOperationName(), 1, ctx),
-        enableTiling(enableTiling) {}
+        enableTiling(enableTiling), tilingDB(tilingDB) {}
   bool enableTiling;
+  // Tuned tile sizes, owned by the lowering pass.
+  const TilingDatabase &tilingDB;
   // Handle the generic cases, including when there are broadcasts.
   void replaceGenericMatmul(ONNXMatMulOp &matMulOp,
       ONNXMatMulOpAdaptor &operandAdaptor, Type elementType,
@@ -104,10 +107,10 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
                   }
                 }
                 // Add mat mul operation.
-                Value loadedA =
-                    create.krnl.load(operandAdaptor.A(), aAccessFct);
-                Value loadedB =
-                    create.krnl.load(operandAdaptor.B(), bAccessFct);
+                Value loadedA = create.math.extendToComputeType(
+                    create.krnl.load(operandAdaptor.A(), aAccessFct));
+                Value loadedB = create.math.extendToComputeType(
+                    create.krnl.load(operandAdaptor.B(), bAccessFct));
                 Value loadedY = create.krnl.load(reductionVal);
                 Value AB = create.math.mul(loadedA, loadedB);
                 Value accumulated = create.math.add(loadedY, AB);
@@ -118,15 +121,41 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
         });
   }
 
-  void computeTileSizeForMatMatProduct(DimIndexExpr dimI, DimIndexExpr dimJ,
-      DimIndexExpr dimK, int64_t &iRegTile, int64_t &jRegTile,
-      int64_t &kRegTile, bool &simdize) const {
+  void computeTileSizeForMatMatProduct(Type elementType, DimIndexExpr dimI,
+      DimIndexExpr dimJ, DimIndexExpr dimK, int64_t &iRegTile,
+      int64_t &jRegTile, int64_t &kRegTile, bool &simdize) const {
 
     // Default values
     iRegTile = 4;
     jRegTile = 8;
     kRegTile = 8; // SIMD dim.
 
+    // Use the tile sizes tuned for this problem size, if any.
+    if (dimI.isLiteral() && dimJ.isLiteral() && dimK.isLiteral()) {
+      int64_t constI = dimI.getLiteral();
+      int64_t constJ = dimJ.getLiteral();
+      int64_t constK = dimK.getLiteral();
+      Optional<MatMulTileSizes> tuned =
+          tilingDB.lookup("matmul", elementType, constI, constJ, constK);
+      if (tuned) {
+        iRegTile = std::min(tuned->iRegTile > 0 ? tuned->iRegTile : iRegTile,
+            constI);
+        jRegTile = std::min(tuned->jRegTile > 0 ? tuned->jRegTile : jRegTile,
+            constJ);
+        kRegTile = std::min(tuned->kRegTile > 0 ? tuned->kRegTile : kRegTile,
+            constK);
+        // Simdization occurs along j and jRegTile.
+        if (jRegTile == 1)
+          simdize = false;
+        LLVM_DEBUG({
+          llvm::dbgs() << "MatMul mat: Tuned tiling I " << iRegTile << ", J "
+                       << jRegTile << ", K " << kRegTile << ", simd "
+                       << simdize << "\n";
+        });
+        return;
+      }
+    }
+
     if (dimI.isLiteral()) {
       int64_t constI = dimI.getLiteral();
       if (constI < iRegTile) {
@@ -256,8 +285,8 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
       computeTileSizeForMatVectProduct(
           mVL, dimI, dimJ, dimK, iRegTile, jRegTile, kRegTile, simdize);
     } else {
-      computeTileSizeForMatMatProduct(
-          dimI, dimJ, dimK, iRegTile, jRegTile, kRegTile, simdize);
+      computeTileSizeForMatMatProduct(elementType, dimI, dimJ, dimK,
+          iRegTile, jRegTile, kRegTile, simdize);
     }
 
     // I, J, K loop.
@@ -326,8 +355,8 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
       computeTileSizeForMatVectProduct(
           mVL, dimI, dimJ, dimK, iRegTile, jRegTile, kRegTile, simdize);
     } else {
-      computeTileSizeForMatMatProduct(
-          dimI, dimJ, dimK, iRegTile, jRegTile, kRegTile, simdize);
+      computeTileSizeForMatMatProduct(elementType, dimI, dimJ, dimK,
+          iRegTile, jRegTile, kRegTile, simdize);
     }
 
     // Broadcast loops
@@ -409,34 +438,39 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
     MemRefType outputMemRefType = convertedType.cast<MemRefType>();
 
     // Insert an allocation and deallocation for the output of this operation.
-    Type elementType = outputMemRefType.getElementType();
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, outputMemRefType, loc, shapeHelper.getOutputDims());
 
+    // Products of 16-bit floats are accumulated in f32, in a temporary result
+    // that is truncated into the output at the end.
+    Type elementType =
+        MathBuilder::getComputeType(outputMemRefType.getElementType());
+    Value result = insertComputeTypeAlloc(rewriter, op, alloc, loc);
+
     // Get the constants: zero.
     Value zero = create.math.constant(elementType, 0);
 
     Value A(operandAdaptor.A()), B(operandAdaptor.B());
     int aRank = A.getType().cast<MemRefType>().getShape().size();
     int bRank = B.getType().cast<MemRefType>().getShape().size();
-    int cRank = alloc.getType().cast<MemRefType>().getShape().size();
+    int cRank = result.getType().cast<MemRefType>().getShape().size();
     if (enableTiling && aRank == 2 && bRank == 2) {
       // Optimized Matmul only when 2D and allowed to tile and unroll.
       assert(cRank == 2 && "expected IxK * KxJ = IxJ 2D result");
       replace2x2Matmul2d(matMulOp, operandAdaptor, elementType, shapeHelper,
-          alloc, zero, rewriter, loc);
+          result, zero, rewriter, loc);
     } else if (enableTiling && aRank == 2 && bRank > 2) {
       // Broadcasting B.
       assert(cRank == bRank && "expected IxK * *xKxJ = *xIxJ result");
       replace2x2Matmul2dBroadcasting(matMulOp, operandAdaptor, elementType,
           shapeHelper, /*broadcasting B*/ true,
-          /*same static broadcast*/ false, alloc, zero, rewriter, loc);
+          /*same static broadcast*/ false, result, zero, rewriter, loc);
     } else if (enableTiling && aRank > 2 && bRank == 2) {
       // Broadcasting A.
       assert(cRank == aRank && "expected IxK * *xKxJ = *xIxJ result");
       replace2x2Matmul2dBroadcasting(matMulOp, operandAdaptor, elementType,
           shapeHelper, /*broadcasting B*/ false,
-          /*same static broadcast*/ false, alloc, zero, rewriter, loc);
+          /*same static broadcast*/ false, result, zero, rewriter, loc);
     } else {
       // Test if have A and B have identical static broadcast shapes.
       bool sameStaticBroadcast = (enableTiling && aRank > 2 && aRank == bRank);
@@ -455,12 +489,13 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
         assert(cRank == aRank && "expected IxK * *xKxJ = *xIxJ result");
         replace2x2Matmul2dBroadcasting(matMulOp, operandAdaptor, elementType,
             shapeHelper, /*broadcasting B*/ true,
-            /*same static broadcast*/ true, alloc, zero, rewriter, loc);
+            /*same static broadcast*/ true, result, zero, rewriter, loc);
       } else {
         replaceGenericMatmul(matMulOp, operandAdaptor, elementType, shapeHelper,
-            alloc, zero, rewriter, loc);
+            result, zero, rewriter, loc);
       }
     }
+    emitTruncateToStorageType(KrnlBuilder(rewriter, loc), result, alloc);
     // Done.
     rewriter.replaceOp(op, alloc);
     return success();
@@ -468,8 +503,10 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
 }; // namespace onnx_mlir
 
 void populateLoweringONNXMatMulOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling) {
-  patterns.insert<ONNXMatMulOpLowering>(typeConverter, ctx, enableTiling);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling,
+    const TilingDatabase &tilingDB) {
+  patterns.insert<ONNXMatMulOpLowering>(
+      typeConverter, ctx, enableTiling, tilingDB);
 }
 
 } // namespace onnx_mlir
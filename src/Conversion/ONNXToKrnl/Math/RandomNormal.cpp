@@ -24,10 +24,18 @@ using namespace mlir;
 
 namespace onnx_mlir {
 
+// Number of values generated by each iteration of the parallel loop.
+static constexpr int64_t RANDOM_NORMAL_PARALLEL_CHUNK = 1 << 16;
+
 struct ONNXRandomNormalOpLowering : public ConversionPattern {
-  ONNXRandomNormalOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  ONNXRandomNormalOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(typeConverter,
-            mlir::ONNXRandomNormalOp::getOperationName(), 1, ctx) {}
+            mlir::ONNXRandomNormalOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+
+  bool enableParallel;
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     Location loc = op->getLoc();
@@ -51,7 +59,8 @@ struct ONNXRandomNormalOpLowering : public ConversionPattern {
     int64_t randomValues = 1;
     for (decltype(outputRank) i = 0; i < outputRank; ++i)
       randomValues *= outputMemRefShape[i];
-    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, MathBuilder, SCFBuilder> create(
+        rewriter, loc);
     Value numberOfRandomValues =
         create.math.constant(rewriter.getIndexType(), randomValues);
 
@@ -68,8 +77,27 @@ struct ONNXRandomNormalOpLowering : public ConversionPattern {
       doubleSeed = seed->convertToDouble();
     Value seedValue = create.math.constant(elementType, doubleSeed);
 
-    create.krnl.randomNormal(
-        alloc, numberOfRandomValues, meanValue, scaleValue, seedValue);
+    if (enableParallel && randomValues > RANDOM_NORMAL_PARALLEL_CHUNK) {
+      // The values only depend on their index, so chunks of the output are
+      // generated in parallel.
+      int64_t numChunks =
+          (randomValues + RANDOM_NORMAL_PARALLEL_CHUNK - 1) /
+          RANDOM_NORMAL_PARALLEL_CHUNK;
+      Value zero = create.math.constantIndex(0);
+      Value one = create.math.constantIndex(1);
+      Value chunkSize = create.math.constantIndex(RANDOM_NORMAL_PARALLEL_CHUNK);
+      create.scf.parallelLoop({zero}, {create.math.constantIndex(numChunks)},
+          {one}, [&](SCFBuilder &createSCF, ValueRange chunkIndex) {
+            Value begin = create.math.mul(chunkIndex[0], chunkSize);
+            Value count = create.math.min(
+                chunkSize, create.math.sub(numberOfRandomValues, begin));
+            create.krnl.randomNormal(
+                alloc, count, meanValue, scaleValue, seedValue, begin);
+          });
+    } else {
+      create.krnl.randomNormal(
+          alloc, numberOfRandomValues, meanValue, scaleValue, seedValue);
+    }
 
     rewriter.replaceOp(op, alloc);
     return success();
@@ -77,8 +105,9 @@ struct ONNXRandomNormalOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXRandomNormalOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
-  patterns.insert<ONNXRandomNormalOpLowering>(typeConverter, ctx);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXRandomNormalOpLowering>(
+      typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
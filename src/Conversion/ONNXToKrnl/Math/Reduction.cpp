@@ -193,7 +193,6 @@ struct ONNXReductionOpLowering : public ConversionPattern {
 
     // Get type information
     auto memRefOutShape = memRefOutType.getShape();
-    auto elementOutType = memRefOutType.getElementType();
     std::map<int64_t, int64_t> outInDimMap =
         getReductionMapping(memRefInType, axes, isKeepdims);
 
@@ -219,6 +218,12 @@ struct ONNXReductionOpLowering : public ConversionPattern {
       }
     }
 
+    // 16-bit floats are accumulated in f32, in a temporary result that is
+    // truncated into the output at the end.
+    Value output = alloc;
+    alloc = insertComputeTypeAlloc(rewriter, op, output, loc);
+    Type computeType = alloc.getType().cast<MemRefType>().getElementType();
+
     // There are two required and one optional Krnl loops:
     // - One to initialize the result memref,
     // - One to do reduction, and
@@ -248,7 +253,7 @@ struct ONNXReductionOpLowering : public ConversionPattern {
       loopIVs.push_back(arg);
 
     Value identity =
-        getIdentityValue<ONNXReductionOp>(rewriter, loc, elementOutType);
+        getIdentityValue<ONNXReductionOp>(rewriter, loc, computeType);
     create.krnl.store(identity, alloc, loopIVs);
 
     // 2. Define an Krnl loop to do reduction.
@@ -289,10 +294,11 @@ struct ONNXReductionOpLowering : public ConversionPattern {
       }
     }
 
-    Value next = create.krnl.load(input, inLoopIVs);
+    Value next =
+        create.math.extendToComputeType(create.krnl.load(input, inLoopIVs));
     Value accumulated = create.krnl.load(alloc, outLoopIVs);
     accumulated = emitScalarOpFor<ONNXReductionOp>(
-        rewriter, loc, op, memRefOutType.getElementType(), {accumulated, next});
+        rewriter, loc, op, computeType, {accumulated, next});
     create.krnl.store(accumulated, alloc, outLoopIVs);
 
     // 3. Define an Krnl loop to compute mean (optional).
@@ -300,7 +306,7 @@ struct ONNXReductionOpLowering : public ConversionPattern {
     MemRefBoundsIndexCapture inputBounds(input);
     MemRefBoundsIndexCapture allocBounds(alloc);
     if (computeMean) {
-      Type elementType = memRefOutType.getElementType();
+      Type elementType = computeType;
       // Compute the divisor that is the number of elements participated in
       // reduction, i.e., 'divisor = size of input / size of output'.
       IndexExprScope scope(&rewriter, loc);
@@ -341,7 +347,8 @@ struct ONNXReductionOpLowering : public ConversionPattern {
           });
     }
 
-    rewriter.replaceOp(op, alloc);
+    emitTruncateToStorageType(KrnlBuilder(rewriter, loc), alloc, output);
+    rewriter.replaceOp(op, output);
     return success();
   }
 };
@@ -405,7 +412,6 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
 
     // Get type information
     auto memRefOutShape = memRefOutType.getShape();
-    auto elementOutType = memRefOutType.getElementType();
 
     bool dynamicAxes = false;
     Value maskVal = nullptr;
@@ -559,6 +565,12 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
       }
     }
 
+    // 16-bit floats are accumulated in f32, in a temporary result that is
+    // truncated into the output at the end.
+    Value output = alloc;
+    alloc = insertComputeTypeAlloc(rewriter, op, output, loc);
+    Type computeType = alloc.getType().cast<MemRefType>().getElementType();
+
     // There are two required and one optional Krnl loops:
     // - One to initialize the result memref,
     // - One to do reduction, and
@@ -589,7 +601,7 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
     }
 
     Value identity =
-        getIdentityValue<ONNXReduceSumOp>(rewriter, loc, elementOutType);
+        getIdentityValue<ONNXReduceSumOp>(rewriter, loc, computeType);
     create.krnl.store(identity, alloc, loopIVs);
 
     // 2. Define an Krnl loop to do reduction.
@@ -632,10 +644,11 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
         outLoopIVs.push_back(zeroIndex);
     }
 
-    Value next = create.krnl.load(input, inLoopIVs);
+    Value next =
+        create.math.extendToComputeType(create.krnl.load(input, inLoopIVs));
     Value accumulated = create.krnl.load(alloc, outLoopIVs);
     accumulated = emitScalarOpFor<ONNXReduceSumOp>(
-        rewriter, loc, op, memRefOutType.getElementType(), {accumulated, next});
+        rewriter, loc, op, computeType, {accumulated, next});
     create.krnl.store(accumulated, alloc, outLoopIVs);
 
     // 3. Define an Krnl loop to compute mean (optional).
@@ -643,7 +656,7 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
     MemRefBoundsIndexCapture inputBounds(input);
     MemRefBoundsIndexCapture allocBounds(alloc);
     if (computeMean) {
-      Type elementType = memRefOutType.getElementType();
+      Type elementType = computeType;
       // Compute the divisor that is the number of elements participated in
       // reduction, i.e., 'divisor = size of input / size of output'.
       IndexExprScope scope(&rewriter, loc);
@@ -683,7 +696,8 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
           });
     }
 
-    rewriter.replaceOp(op, alloc);
+    emitTruncateToStorageType(KrnlBuilder(rewriter, loc), alloc, output);
+    rewriter.replaceOp(op, output);
     return success();
   }
 };
@@ -25,6 +25,8 @@ static void emitInnerLoops(KrnlBuilder &createKrnl, int64_t numberOfLoops,
     ValueRange outerIndices, Value input, Value alloc, Value sumOp, Value maxOp,
     int64_t axis, bool coerced = true) {
   int64_t rank = alloc.getType().cast<MemRefType>().getRank();
+  // 16-bit float inputs are extended to f32, the type of sumOp and maxOp.
+  Type elementType = alloc.getType().cast<MemRefType>().getElementType();
 
   // Compute the maximum value along axis.
   ValueRange maxLoops = createKrnl.defineLoops(numberOfLoops);
@@ -50,6 +52,7 @@ static void emitInnerLoops(KrnlBuilder &createKrnl, int64_t numberOfLoops,
 
         Value max = create.krnl.load(maxOp, {});
         Value nextMax = create.krnl.load(input, maxLoopIVs);
+        nextMax = create.math.extendToComputeType(nextMax);
         auto maxCond = create.math.sgt(max, nextMax);
         max = create.math.select(maxCond, max, nextMax);
         create.krnl.store(max, maxOp, ArrayRef<Value>{});
@@ -81,13 +84,15 @@ static void emitInnerLoops(KrnlBuilder &createKrnl, int64_t numberOfLoops,
 
         Value sum = create.krnl.load(sumOp, {});
         Value next = create.krnl.load(input, sumLoopIVs);
+        next = create.math.extendToComputeType(next);
         Value sub = create.math.sub(next, max);
         Value exp = create.math.exp(sub);
         sum = create.math.add(sum, exp);
         create.krnl.store(sum, sumOp, ArrayRef<Value>{});
         // Store intermediate values in the result to avoid
         // recomputation.
-        create.krnl.store(exp, alloc, sumLoopIVs);
+        create.krnl.store(create.math.truncateToStorageType(elementType, exp),
+            alloc, sumLoopIVs);
       });
 
   // Load the sum value.
@@ -115,8 +120,10 @@ static void emitInnerLoops(KrnlBuilder &createKrnl, int64_t numberOfLoops,
             softmaxLoopIVs.push_back(outerIndices[i - 1]);
         }
 
-        Value expLoadedVal = create.krnl.load(alloc, softmaxLoopIVs);
+        Value expLoadedVal = create.math.extendToComputeType(
+            create.krnl.load(alloc, softmaxLoopIVs));
         Value result = create.math.div(expLoadedVal, sum);
+        result = create.math.truncateToStorageType(elementType, result);
         create.krnl.store(result, alloc, softmaxLoopIVs);
       });
 }
@@ -267,7 +274,9 @@ struct ONNXSoftmaxLowering : public ConversionPattern {
             : insertAllocAndDealloc(
                   memRefType, loc, rewriter, insertDealloc, input);
 
-    // Insert allocations and deallocations for sum and max.
+    // Insert allocations and deallocations for sum and max, which are in f32
+    // for 16-bit floats.
+    elementType = MathBuilder::getComputeType(elementType);
     MemRefType scalarMemRefType = MemRefType::get({}, elementType, {}, 0);
     Value sumOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
     Value maxOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
@@ -44,7 +44,10 @@ struct ONNXConvOpLowering : public ConversionPattern {
     bool hasBias = !biasOperand.getType().isa<NoneType>();
     int64_t groupNum = convOp.group();
     IndexExpr G = LiteralIndexExpr(groupNum);
-    Value fZero = create.math.constant(memRefType.getElementType(), 0);
+    // Accumulate 16-bit floats in f32.
+    Type elementType = memRefType.getElementType();
+    Type computeType = MathBuilder::getComputeType(elementType);
+    Value fZero = create.math.constant(computeType, 0);
 
     // Bounds for output sizes: [N x CO x HO x WO]:
     // where N is Batch Size,
@@ -87,7 +90,7 @@ struct ONNXConvOpLowering : public ConversionPattern {
     //       co = g * COPerGroup + coPerGroup;
 
     // Create a local reduction value.
-    MemRefType tmpType = MemRefType::get({}, memRefType.getElementType());
+    MemRefType tmpType = MemRefType::get({}, computeType);
     // Single scalar, no need for default alignment.
     Value reductionVal = create.mem.alloca(tmpType);
     auto bodyFunction = [&](ValueRange outerIndices) {
@@ -179,8 +182,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
                     IndexExpr t = (k * d) - pos;
                     inputAccessFct.emplace_back(t);
                   }
-                  Value image =
-                      create.krnl.loadIE(inputOperand, inputAccessFct);
+                  Value image = create.math.extendToComputeType(
+                      create.krnl.loadIE(inputOperand, inputAccessFct));
                   // Create access fct for filter: [co, ciPerG, kh, kw].
                   SmallVector<IndexExpr, 4> filterAccessFct;
                   filterAccessFct.emplace_back(DimIndexExpr(co));
@@ -190,8 +193,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
                     DimIndexExpr k(redIndices[1 + i]);
                     filterAccessFct.emplace_back(k);
                   }
-                  Value filter =
-                      create.krnl.loadIE(filterOperand, filterAccessFct);
+                  Value filter = create.math.extendToComputeType(
+                      create.krnl.loadIE(filterOperand, filterAccessFct));
                   Value oldRed = create.krnl.load(reductionVal);
                   Value mul = create.math.mul(image, filter);
                   Value newRed = create.math.add(oldRed, mul);
@@ -202,7 +205,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
             // Store the result. Optionally add bias.
             SymbolIndexExpr coInOutputSpacial(co);
             if (hasBias) {
-              Value bias = create.krnl.loadIE(biasOperand, {coInOutputSpacial});
+              Value bias = create.math.extendToComputeType(
+                  create.krnl.loadIE(biasOperand, {coInOutputSpacial}));
               result = create.math.add(result, bias);
             }
             SmallVector<IndexExpr, 4> resAccessFunc;
@@ -210,7 +214,9 @@ struct ONNXConvOpLowering : public ConversionPattern {
             resAccessFunc.emplace_back(coInOutputSpacial);
             for (Value o : outputSpatialIndices)
               resAccessFunc.emplace_back(DimIndexExpr(o));
-            create.krnl.storeIE(result, alloc, resAccessFunc);
+            create.krnl.storeIE(
+                create.math.truncateToStorageType(elementType, result), alloc,
+                resAccessFunc);
           }); // Output spacial loops.
     };
 
@@ -584,6 +584,50 @@ DenseElementsAttr getDenseElementAttributeFromConstantValue(Value value) {
   return nullptr;
 }
 
+Value emitPackedMatMulBPanels(const KrnlBuilder &createKrnl,
+    DenseElementsAttr bAttr, bool bTrans, int64_t &kTile, int64_t &jTile,
+    int64_t jRegTile) {
+  // A splat B would be expanded into a large non-splat global.
+  if (!bAttr || bAttr.isSplat())
+    return nullptr;
+  ShapedType bType = bAttr.getType();
+  Type elementType = bType.getElementType();
+  if (bType.getRank() != 2 || !elementType.isa<FloatType>())
+    return nullptr;
+  int64_t K = bType.getShape()[bTrans ? 1 : 0];
+  int64_t J = bType.getShape()[bTrans ? 0 : 1];
+  // A B narrower than a register tile would mostly be padding.
+  if (J < jRegTile)
+    return nullptr;
+  // Do not pad a small B to a full cache tile: clamp the panels to K, and to
+  // J rounded up to a multiple of the register tile.
+  kTile = std::min(kTile, K);
+  jTile = std::min(jTile, (J + jRegTile - 1) / jRegTile * jRegTile);
+  int64_t numKPanels = (K + kTile - 1) / kTile;
+  int64_t numJPanels = (J + jTile - 1) / jTile;
+  int64_t eltBytes = elementType.getIntOrFloatBitWidth() / 8;
+
+  // Copy the elements of B.
+  ArrayRef<char> rawData = bAttr.getRawData();
+  std::vector<char> packed(
+      numJPanels * numKPanels * kTile * jTile * eltBytes, 0);
+  for (int64_t k = 0; k < K; ++k) {
+    for (int64_t j = 0; j < J; ++j) {
+      int64_t src = bTrans ? j * K + k : k * J + j;
+      int64_t panel = (j / jTile) * numKPanels + k / kTile;
+      int64_t dst = (panel * kTile + k % kTile) * jTile + j % jTile;
+      memcpy(packed.data() + dst * eltBytes, rawData.data() + src * eltBytes,
+          eltBytes);
+    }
+  }
+
+  SmallVector<int64_t, 2> packedShape{numJPanels * numKPanels * kTile, jTile};
+  DenseElementsAttr packedAttr = DenseElementsAttr::getFromRawBuffer(
+      RankedTensorType::get(packedShape, elementType), packed);
+  return createKrnl.constant(MemRefType::get(packedShape, elementType),
+      "constant_packed_", packedAttr);
+}
+
 /// This function returns a scalar of type 'dtype' from an optional value.
 /// Optional value must be: NoneType, memref<1xdtype> or memref<dtype>. Default
 /// value is used in case of NoneType.
@@ -600,6 +644,152 @@ Value getOptionalScalarValue(ConversionPatternRewriter &rewriter, Location loc,
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Support functions for quantized ops.
+//===----------------------------------------------------------------------===//
+
+Value emitRoundHalfToEven(OpBuilder &builder, Location loc, Value x) {
+  // Use numpy algorithm for rint as follows.
+  // ```
+  // double y, r;
+  // y = npy_floor(x);
+  // r = x - y;
+  //
+  // if (r > 0.5) {
+  //     y += 1.0;
+  // }
+  //
+  // /* Round to nearest even */
+  // if (r == 0.5) {
+  //     r = y - 2.0*npy_floor(0.5*y);
+  //     if (r == 1.0) {
+  //         y += 1.0;
+  //     }
+  // }
+  // return y;
+  // ```
+  Type elementType = x.getType();
+  assert(elementType.isa<FloatType>() && "expected float type");
+  MathBuilder createMath(builder, loc);
+  Value one = createMath.constant(elementType, 1.0);
+  Value two = createMath.constant(elementType, 2.0);
+  Value half = createMath.constant(elementType, 0.5);
+  Value y = builder.create<math::FloorOp>(loc, x);
+  Value r = createMath.sub(x, y);
+
+  // r > 0.5
+  Value rGreaterThanHalf =
+      builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OGT, r, half);
+  Value y1 = createMath.select(rGreaterThanHalf, createMath.add(y, one), y);
+
+  // r == 0.5: round to nearest even.
+  Value y2 = createMath.mul(half, y);
+  y2 = builder.create<math::FloorOp>(loc, y2);
+  y2 = createMath.mul(y2, two);
+  Value rr = createMath.sub(y, y2);
+  Value rrEqualOne =
+      builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, rr, one);
+  y2 = createMath.select(rrEqualOne, createMath.add(y, one), y);
+
+  Value rEqualHalf =
+      builder.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ, r, half);
+  return createMath.select(rEqualHalf, y2, y1);
+}
+
+Value emitQuantizeScalar(OpBuilder &builder, Location loc, Value x,
+    Value scale, Value zeroPoint, Type quantizedType) {
+  MathBuilder createMath(builder, loc);
+  Type f32Type = builder.getF32Type();
+  bool isUnsigned = quantizedType.isUnsignedInteger();
+  Value qMin = createMath.constant(f32Type, isUnsigned ? 0.0 : -128.0);
+  Value qMax = createMath.constant(f32Type, isUnsigned ? 255.0 : 127.0);
+  Value y = emitRoundHalfToEven(builder, loc, createMath.div(x, scale));
+  y = createMath.add(y, zeroPoint);
+  y = createMath.max(createMath.min(y, qMax), qMin);
+  // Saturated values fit in i8 for signed types, but not for unsigned ones, so
+  // convert through i32 and truncate.
+  Value i32Val = builder.create<arith::FPToSIOp>(loc, builder.getI32Type(), y);
+  Value i8Val =
+      builder.create<arith::TruncIOp>(loc, builder.getI8Type(), i32Val);
+  return isUnsigned ? createMath.castToUnsigned(i8Val, 8) : i8Val;
+}
+
+Value emitExtendQuantizedToI32(OpBuilder &builder, Location loc, Value x) {
+  MathBuilder createMath(builder, loc);
+  Type i32Type = builder.getI32Type();
+  IntegerType type = x.getType().cast<IntegerType>();
+  if (type.getWidth() == 32)
+    return type.isUnsigned() ? createMath.castToSignless(x, 32) : x;
+  if (type.isUnsigned())
+    return builder.create<arith::ExtUIOp>(
+        loc, i32Type, createMath.castToSignless(x, type.getWidth()));
+  return builder.create<arith::ExtSIOp>(loc, i32Type, x);
+}
+
+Value loadQuantizationParam(const KrnlBuilder &createKrnl, Value param,
+    ValueRange loopInd, int64_t axis) {
+  MemRefType type = param.getType().cast<MemRefType>();
+  if (type.getRank() == 0)
+    return createKrnl.load(param, {});
+  assert(type.getRank() == 1 && "expected scalar or 1-D quantization param");
+  if (type.getShape()[0] == 1) {
+    MathBuilder createMath(createKrnl);
+    return createKrnl.load(param, {createMath.constantIndex(0)});
+  }
+  assert(axis >= 0 && axis < (int64_t)loopInd.size() && "axis out of bound");
+  return createKrnl.load(param, {loopInd[axis]});
+}
+
+Value loadZeroPointAsI32(const KrnlBuilder &createKrnl, Value zeroPoint,
+    ValueRange loopInd, int64_t axis) {
+  if (zeroPoint.getType().isa<NoneType>()) {
+    MathBuilder createMath(createKrnl);
+    return createMath.constant(createKrnl.getBuilder().getI32Type(), 0);
+  }
+  Value zp = loadQuantizationParam(createKrnl, zeroPoint, loopInd, axis);
+  return emitExtendQuantizedToI32(
+      createKrnl.getBuilder(), createKrnl.getLoc(), zp);
+}
+
+//===----------------------------------------------------------------------===//
+// Support functions for 16-bit float ops.
+//===----------------------------------------------------------------------===//
+
+Value insertComputeTypeAlloc(PatternRewriter &rewriter, Operation *op,
+    Value alloc, Location loc, int64_t alignment) {
+  MemRefType type = alloc.getType().cast<MemRefType>();
+  Type computeType = MathBuilder::getComputeType(type.getElementType());
+  if (computeType == type.getElementType())
+    return alloc;
+  IndexExprScope scope(&rewriter, loc);
+  SmallVector<IndexExpr, 4> dims;
+  MemRefBoundsIndexCapture(alloc).getDimList(dims);
+  MemRefType computeMemRefType =
+      MemRefType::get(type.getShape(), computeType);
+  return insertAllocAndDeallocSimple(rewriter, op, computeMemRefType, loc,
+      dims, /*insertDealloc=*/true, alignment);
+}
+
+void emitTruncateToStorageType(
+    const KrnlBuilder &createKrnl, Value computeAlloc, Value alloc) {
+  if (computeAlloc == alloc)
+    return;
+  Type elementType = alloc.getType().cast<MemRefType>().getElementType();
+  IndexExprScope scope(&createKrnl.getBuilder(), createKrnl.getLoc());
+  SmallVector<IndexExpr, 4> ubs;
+  MemRefBoundsIndexCapture(alloc).getDimList(ubs);
+  int64_t rank = ubs.size();
+  ValueRange loopDef = createKrnl.defineLoops(rank);
+  SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
+  createKrnl.iterateIE(loopDef, loopDef, lbs, ubs,
+      [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+        MathBuilder createMath(createKrnl);
+        Value val = createKrnl.load(computeAlloc, loopInd);
+        createKrnl.store(
+            createMath.truncateToStorageType(elementType, val), alloc, loopInd);
+      });
+}
+
 //===----------------------------------------------------------------------===//
 // Support functions for help with custom layout.
 //===----------------------------------------------------------------------===//
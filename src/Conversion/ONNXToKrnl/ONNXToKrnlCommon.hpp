@@ -31,6 +31,7 @@
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/TypeSwitch.h"
 
+#include "src/Conversion/ONNXToKrnl/TilingDatabase.hpp"
 #include "src/Dialect/Krnl/DialectBuilder.hpp"
 #include "src/Dialect/Krnl/KrnlHelper.hpp"
 #include "src/Dialect/Krnl/KrnlOps.hpp"
@@ -189,6 +190,21 @@ mlir::Value emitArgSort(mlir::ConversionPatternRewriter &rewriter,
 mlir::DenseElementsAttr getDenseElementAttributeFromConstantValue(
     mlir::Value value);
 
+/// Pack a constant matrix B[K, J] (given as B[J, K] when bTrans is true) into
+/// the kTile x jTile panels consumed by KrnlMatMulOp and emit it as a
+/// KrnlGlobalOp. Panel (jb, kb) holds the zero padded tile
+/// B[kb * kTile : (kb + 1) * kTile, jb * jTile : (jb + 1) * jTile] and panels
+/// are stored contiguously, kb varying fastest, in a memref of shape
+/// [ceil(J / jTile) * ceil(K / kTile) * kTile, jTile]. Return a null value if
+/// B is not a 2D constant of float type, is a splat, or has fewer than jRegTile
+/// columns, in which cases B is better read unpacked. Otherwise, kTile and
+/// jTile are first clamped to K and to J rounded up to a multiple of jRegTile,
+/// so that a small B is not padded to a full cache tile; the caller must then
+/// tile its loops with the returned sizes.
+mlir::Value emitPackedMatMulBPanels(const KrnlBuilder &createKrnl,
+    mlir::DenseElementsAttr bAttr, bool bTrans, int64_t &kTile, int64_t &jTile,
+    int64_t jRegTile);
+
 //===----------------------------------------------------------------------===//
 // This is to get a scalar operation of a given type for a specific operation.
 //===----------------------------------------------------------------------===//
@@ -232,6 +248,22 @@ mlir::Value emitScalarOpFor(mlir::ConversionPatternRewriter &rewriter,
   }
 }
 
+// Same as emitScalarOpFor, but 16-bit float (f16, bf16) operands are extended
+// to f32 and the result is truncated back to 'elementType', so that only the
+// loads and stores are performed in 16-bit.
+template <typename Op>
+mlir::Value emitScalarOpInComputeType(mlir::ConversionPatternRewriter &rewriter,
+    mlir::Location loc, mlir::Operation *op, mlir::Type elementType,
+    llvm::ArrayRef<mlir::Value> scalarOperands) {
+  MathBuilder createMath(rewriter, loc);
+  llvm::SmallVector<mlir::Value, 4> computeOperands;
+  for (mlir::Value operand : scalarOperands)
+    computeOperands.emplace_back(createMath.extendToComputeType(operand));
+  mlir::Value res = emitScalarOpFor<Op>(rewriter, loc, op,
+      MathBuilder::getComputeType(elementType), computeOperands);
+  return createMath.truncateToStorageType(elementType, res);
+}
+
 //===----------------------------------------------------------------------===//
 // Type conversion from Onnx types to Krnl types:
 //   - from Tensor type to the Standard dialect MemRef type
@@ -271,7 +303,8 @@ public:
 
 // For all ONNX operations.
 void populateONNXToKrnlConversionPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling,
+    bool enableParallel, const TilingDatabase &tilingDB);
 
 // `ControlFlow` directory methods:
 void populateLoweringONNXIfOpPattern(
@@ -289,15 +322,17 @@ void populateLoweringONNXCumSumOpPattern(
 void populateLoweringONNXElementwiseOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXGemmOpPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling,
+    const TilingDatabase &tilingDB);
 void populateLoweringONNXHardmaxOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXLRNOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXMatMulOpPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
-void populateLoweringONNXRandomNormalOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling,
+    const TilingDatabase &tilingDB);
+void populateLoweringONNXRandomNormalOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
 void populateLoweringONNXRandomNormalLikeOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXReductionOpPattern(
@@ -323,6 +358,22 @@ void populateLoweringONNXPoolingOpPattern(
 void populateLoweringONNXNonMaxSuppressionOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 
+// `Quantization` directory methods:
+void populateLoweringONNXConvIntegerOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
+void populateLoweringONNXDequantizeLinearOpPattern(
+    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXDynamicQuantizeLinearOpPattern(
+    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXMatMulIntegerOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+void populateLoweringONNXQLinearConvOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
+void populateLoweringONNXQLinearMatMulOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+void populateLoweringONNXQuantizeLinearOpPattern(
+    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+
 // `RNN` directory methods:
 void populateLoweringONNXGRUOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
@@ -404,8 +455,8 @@ void populateLoweringONNXTileOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXFlattenOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXResizeOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXResizeOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
 void populateLoweringONNXNonZeroOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXReverseSequenceOpPattern(
@@ -453,6 +504,53 @@ mlir::Value getOptionalScalarValue(mlir::ConversionPatternRewriter &rewriter,
     mlir::Location loc, mlir::Value optionalScalar, mlir::Type elementType,
     double defaultValue);
 
+//===----------------------------------------------------------------------===//
+// Support functions for quantized ops.
+//===----------------------------------------------------------------------===//
+
+/// Emit the rounding of a float value to the nearest integer, rounding
+/// halfway cases to the nearest even integer (numpy rint).
+mlir::Value emitRoundHalfToEven(
+    mlir::OpBuilder &builder, mlir::Location loc, mlir::Value x);
+
+/// Emit saturate(round(x / scale) + zeroPoint) converted to 'quantizedType',
+/// which is i8 or ui8. 'x', 'scale' and 'zeroPoint' are f32 values.
+mlir::Value emitQuantizeScalar(mlir::OpBuilder &builder, mlir::Location loc,
+    mlir::Value x, mlir::Value scale, mlir::Value zeroPoint,
+    mlir::Type quantizedType);
+
+/// Emit the sign or zero extension of an i8, ui8 or i32 value to i32.
+mlir::Value emitExtendQuantizedToI32(
+    mlir::OpBuilder &builder, mlir::Location loc, mlir::Value x);
+
+/// Load the scale or zero point 'param' that applies to the element at
+/// 'loopInd'. 'param' is a scalar, a 1-D tensor with a single element, or a
+/// 1-D tensor indexed by the 'axis' loop index (per-axis quantization).
+mlir::Value loadQuantizationParam(const KrnlBuilder &createKrnl,
+    mlir::Value param, mlir::ValueRange loopInd, int64_t axis);
+
+/// Same as above for a zero point, extended to i32. An absent (NoneType) zero
+/// point is 0.
+mlir::Value loadZeroPointAsI32(const KrnlBuilder &createKrnl,
+    mlir::Value zeroPoint, mlir::ValueRange loopInd, int64_t axis);
+
+//===----------------------------------------------------------------------===//
+// Support functions for 16-bit float ops.
+//===----------------------------------------------------------------------===//
+
+/// Return a buffer of the shape of 'alloc' in which results of 16-bit float
+/// type (f16, bf16) are accumulated in f32, or 'alloc' itself for other types.
+/// The f32 buffer is copied into 'alloc' with emitTruncateToStorageType.
+mlir::Value insertComputeTypeAlloc(mlir::PatternRewriter &rewriter,
+    mlir::Operation *op, mlir::Value alloc, mlir::Location loc,
+    int64_t alignment = -1);
+
+/// Copy the values of the f32 buffer 'computeAlloc' into the 16-bit float
+/// buffer 'alloc' of the same shape. Nothing is emitted when both are the
+/// same buffer.
+void emitTruncateToStorageType(
+    const KrnlBuilder &createKrnl, mlir::Value computeAlloc, mlir::Value alloc);
+
 //===----------------------------------------------------------------------===//
 // Support functions for help with custom layout.
 //===----------------------------------------------------------------------===//
@@ -29,21 +29,37 @@ namespace onnx_mlir {
 
 class Utilities {
 public:
-  // Perform a 32-bit FNV (Fowler-Noll-Vo) hash on the given string.
-  static inline uint32_t hash(uint32_t hval, llvm::StringRef str) {
-    constexpr uint32_t prime = 0x01000193;
-    hval = (hval == 0) ? prime : hval;
+  // Mix the bits of a 64-bit value with the finalizer of MurmurHash3.
+  static inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
 
-    for (const char c : str) {
-      hval *= prime;
-      hval ^= c;
+  // Hash the given string 8 bytes at a time, loaded as little endian integers.
+  // Must match hash_string in the runtime (OMIndexLookup.inc).
+  static inline uint32_t hash(uint32_t hval, llvm::StringRef str) {
+    uint64_t seed = (hval == 0) ? 0x01000193 : hval;
+    uint64_t h = (seed * 0x9e3779b97f4a7c15ULL) ^ str.size();
+    for (size_t i = 0; i < str.size(); i += 8) {
+      llvm::StringRef chunk = str.substr(i, 8);
+      uint64_t word = 0;
+      for (const char c : llvm::reverse(chunk))
+        word = (word << 8) | static_cast<unsigned char>(c);
+      h = (h ^ word) * 0xbf58476d1ce4e5b9ULL;
     }
-    return hval;
+    return static_cast<uint32_t>(mix64(h));
   }
 
-  // Adaptation of 32-bit FNV for int64_t values.
+  // Hash the given int64_t value. Must match hash_int64 in the runtime
+  // (OMIndexLookup.inc).
   static inline uint32_t hash(uint32_t hval, int64_t val) {
-    return hash(hval, std::to_string(val));
+    uint64_t seed = (hval == 0) ? 0x01000193 : hval;
+    return static_cast<uint32_t>(
+        mix64(static_cast<uint64_t>(val) ^ (seed * 0x9e3779b97f4a7c15ULL)));
   }
 
   // Extracts the keys of the given map.
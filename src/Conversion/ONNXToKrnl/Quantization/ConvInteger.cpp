@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------- ConvInteger.cpp - Lowering ConvInteger Op --------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX ConvInteger Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXConvIntegerOpLowering : public ConversionPattern {
+  ONNXConvIntegerOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
+      : ConversionPattern(
+            typeConverter, ONNXConvIntegerOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = ONNXLoc<ONNXConvIntegerOp>(op);
+    ONNXConvIntegerOpAdaptor operandAdaptor(operands);
+    ONNXConvIntegerOp convOp = llvm::cast<ONNXConvIntegerOp>(op);
+    Value xZeroPoint = operandAdaptor.x_zero_point();
+    Value wZeroPoint = operandAdaptor.w_zero_point();
+    if (!isScalarQuantizationParam(xZeroPoint) ||
+        !isSupportedMatMulQuantizationParam(wZeroPoint))
+      return rewriter.notifyMatchFailure(op,
+          "only a scalar x_zero_point and a scalar or 1-D w_zero_point are "
+          "supported");
+
+    // Convert the output type to MemRefType.
+    Type convertedType = typeConverter->convertType(*op->result_type_begin());
+    assert(convertedType && convertedType.isa<MemRefType>() &&
+           "Failed to convert type to MemRefType");
+    MemRefType memRefType = convertedType.cast<MemRefType>();
+
+    // Get shape.
+    IndexExprBuilderForKrnl createIE(rewriter, loc);
+    ONNXConvIntegerOpShapeHelper shapeHelper(op, operands, &createIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+
+    // Insert an allocation and deallocation for the result of this operation.
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+
+    // Y = conv(x - x_zero_point, w - w_zero_point), accumulated in i32.
+    emitIntegerConv(rewriter, loc, operandAdaptor.x(), operandAdaptor.w(),
+        xZeroPoint, wZeroPoint, convOp.group(), shapeHelper.getOutputDims(),
+        shapeHelper.pads, shapeHelper.strides, shapeHelper.dilations,
+        enableParallel,
+        [&](KrnlBuilder &createKrnl, Value res, ValueRange outputIndices) {
+          createKrnl.store(res, alloc, outputIndices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXConvIntegerOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXConvIntegerOpLowering>(
+      typeConverter, ctx, enableParallel);
+}
+
+} // namespace onnx_mlir
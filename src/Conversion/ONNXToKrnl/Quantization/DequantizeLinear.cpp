@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----- DequantizeLinear.cpp - Lowering DequantizeLinear Op ------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX DequantizeLinear Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Dialect/Krnl/DialectBuilder.hpp"
+#include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXDequantizeLinearOpLowering : public ConversionPattern {
+  ONNXDequantizeLinearOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            ONNXDequantizeLinearOp::getOperationName(), 1, ctx) {}
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    using LocalDialectBuilder =
+        MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder>;
+    Location loc = ONNXLoc<ONNXDequantizeLinearOp>(op);
+    LocalDialectBuilder create(rewriter, loc);
+    ONNXDequantizeLinearOpAdaptor operandAdaptor(
+        operands, op->getAttrDictionary());
+    Value X = operandAdaptor.x();
+    Value scale = operandAdaptor.x_scale();
+    Value zeroPoint = operandAdaptor.x_zero_point();
+
+    // Convert the output type to MemRefType.
+    Type convertedType = typeConverter->convertType(*op->result_type_begin());
+    assert(convertedType && convertedType.isa<MemRefType>() &&
+           "Failed to convert type to MemRefType");
+    MemRefType memRefType = convertedType.cast<MemRefType>();
+    int64_t rank = memRefType.getRank();
+    int64_t axis = operandAdaptor.axis();
+    if (axis < 0)
+      axis += rank;
+
+    // Get shape.
+    ONNXUnaryOpShapeHelper shapeHelper(op, operands, &create.krnlIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+
+    // Insert an allocation and deallocation for the result of this operation.
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+
+    // y = (x - x_zero_point) * x_scale, where the subtraction is exact in i32.
+    auto computeResult = [&](LocalDialectBuilder &create, ValueRange indices) {
+      Value x = emitExtendQuantizedToI32(
+          rewriter, loc, create.krnl.load(X, indices));
+      Value s = loadQuantizationParam(create.krnl, scale, indices, axis);
+      Value zp = loadZeroPointAsI32(create.krnl, zeroPoint, indices, axis);
+      Value diff = create.math.cast(s.getType(), create.math.sub(x, zp));
+      create.krnl.store(create.math.mul(diff, s), alloc, indices);
+    };
+
+    if (rank > 0) {
+      ValueRange loopDef = create.krnl.defineLoops(rank);
+      SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
+      create.krnl.iterateIE(loopDef, loopDef, lbs, shapeHelper.getOutputDims(),
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            LocalDialectBuilder create(createKrnl);
+            computeResult(create, indices);
+          });
+    } else {
+      computeResult(create, {});
+    }
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXDequantizeLinearOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXDequantizeLinearOpLowering>(typeConverter, ctx);
+}
+
+} // namespace onnx_mlir
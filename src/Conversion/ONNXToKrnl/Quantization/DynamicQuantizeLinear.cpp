@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-- DynamicQuantizeLinear.cpp - Lowering DynamicQuantizeLinear Op -----===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX DynamicQuantizeLinear Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Dialect/Krnl/DialectBuilder.hpp"
+#include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXDynamicQuantizeLinearOpLowering : public ConversionPattern {
+  ONNXDynamicQuantizeLinearOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            ONNXDynamicQuantizeLinearOp::getOperationName(), 1, ctx) {}
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    using LocalDialectBuilder = MultiDialectBuilder<KrnlBuilder,
+        IndexExprBuilderForKrnl, MathBuilder, MemRefBuilder>;
+    Location loc = ONNXLoc<ONNXDynamicQuantizeLinearOp>(op);
+    LocalDialectBuilder create(rewriter, loc);
+    ONNXDynamicQuantizeLinearOpAdaptor operandAdaptor(operands);
+    Value X = operandAdaptor.x();
+
+    // Convert the output types to MemRefType.
+    MemRefType yMemRefType =
+        typeConverter->convertType(op->getResultTypes()[0]).cast<MemRefType>();
+    MemRefType scaleMemRefType =
+        typeConverter->convertType(op->getResultTypes()[1]).cast<MemRefType>();
+    MemRefType zeroPointMemRefType =
+        typeConverter->convertType(op->getResultTypes()[2]).cast<MemRefType>();
+    Type quantizedType = yMemRefType.getElementType();
+    Type f32Type = rewriter.getF32Type();
+    int64_t rank = yMemRefType.getRank();
+
+    // Get shape.
+    ONNXUnaryOpShapeHelper shapeHelper(op, operands, &create.krnlIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+
+    // Insert allocations and deallocations for the results of this operation.
+    Value Y = insertAllocAndDeallocSimple(
+        rewriter, op, yMemRefType, loc, shapeHelper.getOutputDims());
+    Value yScale = insertAllocAndDealloc(
+        scaleMemRefType, loc, rewriter, checkInsertDealloc(op, 1));
+    Value yZeroPoint = insertAllocAndDealloc(
+        zeroPointMemRefType, loc, rewriter, checkInsertDealloc(op, 2));
+
+    // Iterate over all the elements of x, or compute once for a scalar.
+    using BodyFn = function_ref<void(LocalDialectBuilder &, ValueRange)>;
+    auto iterateOverX = [&](BodyFn bodyFn) {
+      if (rank == 0) {
+        bodyFn(create, {});
+        return;
+      }
+      ValueRange loopDef = create.krnl.defineLoops(rank);
+      SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
+      create.krnl.iterateIE(loopDef, loopDef, lbs, shapeHelper.getOutputDims(),
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            LocalDialectBuilder create(createKrnl);
+            bodyFn(create, indices);
+          });
+    };
+
+    // Compute the range of x, adjusted to include 0.
+    Value zero = create.math.constant(f32Type, 0.0);
+    MemRefType scalarType = MemRefType::get({}, f32Type);
+    Value rMin = create.mem.alignedAlloca(scalarType);
+    Value rMax = create.mem.alignedAlloca(scalarType);
+    create.krnl.store(zero, rMin);
+    create.krnl.store(zero, rMax);
+    iterateOverX([&](LocalDialectBuilder &create, ValueRange indices) {
+      Value x = create.krnl.load(X, indices);
+      create.krnl.store(create.math.min(create.krnl.load(rMin), x), rMin);
+      create.krnl.store(create.math.max(create.krnl.load(rMax), x), rMax);
+    });
+
+    // y_scale = (max - min) / (qmax - qmin), or 1 when x is all zeros, and
+    // y_zero_point = saturate(round(qmin - min / y_scale)), with qmin = 0.
+    Value minVal = create.krnl.load(rMin);
+    Value maxVal = create.krnl.load(rMax);
+    Value range = create.math.sub(maxVal, minVal);
+    Value scale = create.math.select(create.math.eq(range, zero),
+        create.math.constant(f32Type, 1.0),
+        create.math.div(range, create.math.constant(f32Type, 255.0)));
+    Value zeroPoint = emitQuantizeScalar(rewriter, loc,
+        create.math.sub(zero, minVal), scale, zero, quantizedType);
+    create.krnl.store(scale, yScale);
+    create.krnl.store(zeroPoint, yZeroPoint);
+
+    // y = saturate(round(x / y_scale) + y_zero_point).
+    Value zeroPointFloat = create.math.cast(f32Type, zeroPoint);
+    iterateOverX([&](LocalDialectBuilder &create, ValueRange indices) {
+      Value x = create.krnl.load(X, indices);
+      Value y = emitQuantizeScalar(
+          rewriter, loc, x, scale, zeroPointFloat, quantizedType);
+      create.krnl.store(y, Y, indices);
+    });
+
+    rewriter.replaceOp(op, {Y, yScale, yZeroPoint});
+    return success();
+  }
+};
+
+void populateLoweringONNXDynamicQuantizeLinearOpPattern(
+    RewritePatternSet &patterns, TypeConverter &typeConverter,
+    MLIRContext *ctx) {
+  patterns.insert<ONNXDynamicQuantizeLinearOpLowering>(typeConverter, ctx);
+}
+
+} // namespace onnx_mlir
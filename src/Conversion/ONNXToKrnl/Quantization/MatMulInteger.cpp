@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- MatMulInteger.cpp - Lowering MatMulInteger Op ------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX MatMulInteger Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXMatMulIntegerOpLowering : public ConversionPattern {
+  ONNXMatMulIntegerOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling)
+      : ConversionPattern(
+            typeConverter, ONNXMatMulIntegerOp::getOperationName(), 1, ctx),
+        enableTiling(enableTiling) {}
+  bool enableTiling;
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = ONNXLoc<ONNXMatMulIntegerOp>(op);
+    ONNXMatMulIntegerOpAdaptor operandAdaptor(operands);
+    Value aZeroPoint = operandAdaptor.a_zero_point();
+    Value bZeroPoint = operandAdaptor.b_zero_point();
+    if (!isSupportedMatMulQuantizationParam(aZeroPoint) ||
+        !isSupportedMatMulQuantizationParam(bZeroPoint))
+      return rewriter.notifyMatchFailure(
+          op, "only scalar and 1-D zero points are supported");
+
+    // Convert the output type to MemRefType.
+    Type convertedType = typeConverter->convertType(*op->result_type_begin());
+    assert(convertedType && convertedType.isa<MemRefType>() &&
+           "Failed to convert type to MemRefType");
+    MemRefType memRefType = convertedType.cast<MemRefType>();
+
+    // Get shape.
+    IndexExprBuilderForKrnl createIE(rewriter, loc);
+    ONNXMatMulIntegerOpShapeHelper shapeHelper(op, operands, &createIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+
+    // Insert an allocation and deallocation for the result of this operation.
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+
+    // Y = (A - a_zero_point) * (B - b_zero_point), accumulated in i32.
+    emitIntegerMatMul(rewriter, loc, operandAdaptor.A(), operandAdaptor.B(),
+        aZeroPoint, bZeroPoint, shapeHelper.getOutputDims(),
+        shapeHelper.aDims.back(), shapeHelper.aPadDims, shapeHelper.bPadDims,
+        enableTiling,
+        [&](KrnlBuilder &createKrnl, Value res, ValueRange outputIndices) {
+          createKrnl.store(res, alloc, outputIndices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXMatMulIntegerOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling) {
+  patterns.insert<ONNXMatMulIntegerOpLowering>(
+      typeConverter, ctx, enableTiling);
+}
+
+} // namespace onnx_mlir
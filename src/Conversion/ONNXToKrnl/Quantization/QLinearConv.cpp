@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------- QLinearConv.cpp - Lowering QLinearConv Op --------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX QLinearConv Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXQLinearConvOpLowering : public ConversionPattern {
+  ONNXQLinearConvOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
+      : ConversionPattern(
+            typeConverter, ONNXQLinearConvOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = ONNXLoc<ONNXQLinearConvOp>(op);
+    ONNXQLinearConvOpAdaptor operandAdaptor(operands);
+    ONNXQLinearConvOp convOp = llvm::cast<ONNXQLinearConvOp>(op);
+    Value xScale = operandAdaptor.x_scale();
+    Value xZeroPoint = operandAdaptor.x_zero_point();
+    Value wScale = operandAdaptor.w_scale();
+    Value wZeroPoint = operandAdaptor.w_zero_point();
+    Value yScale = operandAdaptor.y_scale();
+    Value yZeroPoint = operandAdaptor.y_zero_point();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+    for (Value param : {xScale, xZeroPoint, yScale, yZeroPoint})
+      if (!isScalarQuantizationParam(param))
+        return rewriter.notifyMatchFailure(
+            op, "only scalar x and y scales and zero points are supported");
+    for (Value param : {wScale, wZeroPoint})
+      if (!isSupportedMatMulQuantizationParam(param))
+        return rewriter.notifyMatchFailure(
+            op, "only scalar and 1-D w scales and zero points are supported");
+
+    // Convert the output type to MemRefType.
+    Type convertedType = typeConverter->convertType(*op->result_type_begin());
+    assert(convertedType && convertedType.isa<MemRefType>() &&
+           "Failed to convert type to MemRefType");
+    MemRefType memRefType = convertedType.cast<MemRefType>();
+    Type quantizedType = memRefType.getElementType();
+
+    // Get shape.
+    IndexExprBuilderForKrnl createIE(rewriter, loc);
+    ONNXQLinearConvOpShapeHelper shapeHelper(op, operands, &createIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+
+    // Insert an allocation and deallocation for the result of this operation.
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+
+    // Accumulate (x - x_zero_point) * (w - w_zero_point) and the i32 bias in
+    // i32, then requantize with y = saturate(round(acc * x_scale * w_scale /
+    // y_scale) + y_zero_point). Scales and zero points are per output channel,
+    // which is axis 1 of the output.
+    int64_t channelAxis = 1;
+    emitIntegerConv(rewriter, loc, operandAdaptor.x(), operandAdaptor.w(),
+        xZeroPoint, wZeroPoint, convOp.group(), shapeHelper.getOutputDims(),
+        shapeHelper.pads, shapeHelper.strides, shapeHelper.dilations,
+        enableParallel,
+        [&](KrnlBuilder &createKrnl, Value acc, ValueRange indices) {
+          MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+          Type f32Type = rewriter.getF32Type();
+          if (hasBias)
+            acc = create.math.add(
+                acc, create.krnl.load(bias, {indices[channelAxis]}));
+          Value xS = loadQuantizationParam(createKrnl, xScale, {}, -1);
+          Value wS =
+              loadQuantizationParam(createKrnl, wScale, indices, channelAxis);
+          Value yS = loadQuantizationParam(createKrnl, yScale, {}, -1);
+          Value yZp = loadZeroPointAsI32(createKrnl, yZeroPoint, {}, -1);
+          // acc * x_scale * w_scale / y_scale = acc / (y_scale / (x_scale *
+          // w_scale)), so that the rounding is the one of QuantizeLinear.
+          Value x = create.math.cast(f32Type, acc);
+          Value scale = create.math.div(yS, create.math.mul(xS, wS));
+          Value res = emitQuantizeScalar(rewriter, loc, x, scale,
+              create.math.cast(f32Type, yZp), quantizedType);
+          create.krnl.store(res, alloc, indices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXQLinearConvOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXQLinearConvOpLowering>(
+      typeConverter, ctx, enableParallel);
+}
+
+} // namespace onnx_mlir
@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- QLinearMatMul.cpp - Lowering QLinearMatMul Op ------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX QLinearMatMul Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXQLinearMatMulOpLowering : public ConversionPattern {
+  ONNXQLinearMatMulOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling)
+      : ConversionPattern(
+            typeConverter, ONNXQLinearMatMulOp::getOperationName(), 1, ctx),
+        enableTiling(enableTiling) {}
+  bool enableTiling;
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = ONNXLoc<ONNXQLinearMatMulOp>(op);
+    ONNXQLinearMatMulOpAdaptor operandAdaptor(operands);
+    Value aScale = operandAdaptor.a_scale();
+    Value aZeroPoint = operandAdaptor.a_zero_point();
+    Value bScale = operandAdaptor.b_scale();
+    Value bZeroPoint = operandAdaptor.b_zero_point();
+    Value yScale = operandAdaptor.y_scale();
+    Value yZeroPoint = operandAdaptor.y_zero_point();
+    for (Value param :
+        {aScale, aZeroPoint, bScale, bZeroPoint, yScale, yZeroPoint})
+      if (!isSupportedMatMulQuantizationParam(param))
+        return rewriter.notifyMatchFailure(
+            op, "only scalar and 1-D scales and zero points are supported");
+
+    // Convert the output type to MemRefType.
+    Type convertedType = typeConverter->convertType(*op->result_type_begin());
+    assert(convertedType && convertedType.isa<MemRefType>() &&
+           "Failed to convert type to MemRefType");
+    MemRefType memRefType = convertedType.cast<MemRefType>();
+    Type quantizedType = memRefType.getElementType();
+
+    // Get shape.
+    IndexExprBuilderForKrnl createIE(rewriter, loc);
+    ONNXQLinearMatMulOpShapeHelper shapeHelper(op, operands, &createIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+    int64_t outputRank = shapeHelper.getOutputDims().size();
+    int64_t rowAxis = getMatMulRowAxis(
+        shapeHelper.aPadDims, shapeHelper.bPadDims, outputRank);
+    int64_t colAxis = getMatMulColumnAxis(shapeHelper.bPadDims, outputRank);
+
+    // Insert an allocation and deallocation for the result of this operation.
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+
+    // Accumulate (a - a_zero_point) * (b - b_zero_point) in i32, then
+    // requantize with y = saturate(round(acc * a_scale * b_scale / y_scale) +
+    // y_zero_point).
+    emitIntegerMatMul(rewriter, loc, operandAdaptor.a(), operandAdaptor.b(),
+        aZeroPoint, bZeroPoint, shapeHelper.getOutputDims(),
+        shapeHelper.aDims.back(), shapeHelper.aPadDims, shapeHelper.bPadDims,
+        enableTiling,
+        [&](KrnlBuilder &createKrnl, Value acc, ValueRange indices) {
+          MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+          Type f32Type = rewriter.getF32Type();
+          Value aS =
+              loadQuantizationParam(createKrnl, aScale, indices, rowAxis);
+          Value bS =
+              loadQuantizationParam(createKrnl, bScale, indices, colAxis);
+          Value yS =
+              loadQuantizationParam(createKrnl, yScale, indices, colAxis);
+          Value yZp =
+              loadZeroPointAsI32(createKrnl, yZeroPoint, indices, colAxis);
+          // acc * a_scale * b_scale / y_scale = acc / (y_scale / (a_scale *
+          // b_scale)), so that the rounding is the one of QuantizeLinear.
+          Value x = create.math.cast(f32Type, acc);
+          Value scale = create.math.div(yS, create.math.mul(aS, bS));
+          Value res = emitQuantizeScalar(rewriter, loc, x, scale,
+              create.math.cast(f32Type, yZp), quantizedType);
+          create.krnl.store(res, alloc, indices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXQLinearMatMulOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling) {
+  patterns.insert<ONNXQLinearMatMulOpLowering>(
+      typeConverter, ctx, enableTiling);
+}
+
+} // namespace onnx_mlir
@@ -0,0 +1,444 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------ QuantizeHelper.cpp - Lowering Quantized Ops -------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file implements common functions for lowering the ONNX quantized
+// Operators.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+bool isSupportedMatMulQuantizationParam(Value param) {
+  if (param.getType().isa<NoneType>())
+    return true;
+  ShapedType type = param.getType().dyn_cast<ShapedType>();
+  return type && type.hasRank() && type.getRank() <= 1;
+}
+
+bool isScalarQuantizationParam(Value param) {
+  if (param.getType().isa<NoneType>())
+    return true;
+  ShapedType type = param.getType().dyn_cast<ShapedType>();
+  if (!type || !type.hasRank())
+    return false;
+  return type.getRank() == 0 ||
+         (type.getRank() == 1 && type.getShape()[0] == 1);
+}
+
+int64_t getMatMulRowAxis(
+    const BitVector &aPadDims, const BitVector &bPadDims, int64_t outputRank) {
+  int64_t paddedRank = aPadDims.size();
+  // The rows of a 1-D A are not part of the output.
+  if (aPadDims[paddedRank - 2])
+    return -1;
+  // Rows are the last output dimension when B is 1-D.
+  return bPadDims[paddedRank - 1] ? outputRank - 1 : outputRank - 2;
+}
+
+int64_t getMatMulColumnAxis(const BitVector &bPadDims, int64_t outputRank) {
+  // The columns of a 1-D B are not part of the output.
+  return bPadDims[bPadDims.size() - 1] ? -1 : outputRank - 1;
+}
+
+// Allocate an i32 buffer of shape 'dims'.
+static Value allocI32Buffer(
+    ConversionPatternRewriter &rewriter, Location loc, DimsExpr dims) {
+  MemRefBuilder createMemRef(rewriter, loc);
+  SmallVector<int64_t, 4> shape;
+  IndexExpr::getShape(dims, shape);
+  SmallVector<Value, 4> dynDims;
+  for (IndexExpr &dim : dims)
+    if (!dim.isLiteral())
+      dynDims.emplace_back(dim.getValue());
+  return createMemRef.alignedAlloc(
+      MemRefType::get(shape, rewriter.getI32Type()), dynDims);
+}
+
+// Same as emitIntegerMatMul when A is at least 2-D and B is 2-D. The raw
+// products A * B are accumulated in i32 by krnl.matmul, which is tiled and
+// simdized, and the zero points are applied afterward with
+//   Y[i, j] = AB[i, j] - bZp[j] * rowSumA[i] - aZp[i] * colSumB[j]
+//             + K * aZp[i] * bZp[j]
+// where the row sums of A and column sums of B are only O(I * K + K * J).
+static void emitTiledIntegerMatMul(ConversionPatternRewriter &rewriter,
+    Location loc, Value A, Value B, Value aZeroPoint, Value bZeroPoint,
+    const DimsExpr &outputDims, IndexExpr kDim,
+    function_ref<void(KrnlBuilder &, Value, ValueRange)> storeFn) {
+  MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder> create(
+      rewriter, loc);
+  Type i32Type = rewriter.getI32Type();
+  int64_t outputRank = outputDims.size();
+  int64_t broadcastRank = outputRank - 2;
+  int64_t rowAxis = outputRank - 2;
+  int64_t colAxis = outputRank - 1;
+  bool hasAZeroPoint = !aZeroPoint.getType().isa<NoneType>();
+  bool hasBZeroPoint = !bZeroPoint.getType().isa<NoneType>();
+  Value zero = create.math.constantIndex(0);
+  Value i32Zero = create.math.constant(i32Type, 0);
+  Value I = outputDims[rowAxis].getValue();
+  Value J = outputDims[colAxis].getValue();
+  Value K = kDim.getValue();
+
+  // Raw products, accumulated by krnl.matmul.
+  Value C = allocI32Buffer(rewriter, loc, outputDims);
+  create.krnl.memset(C, i32Zero);
+
+  // Same register tiles as the float MatMul, with simdization along j.
+  int64_t iRegTile = 4, jRegTile = 8, kRegTile = 8;
+  bool simdize = true;
+  if (outputDims[rowAxis].isLiteral())
+    iRegTile = std::min(iRegTile, outputDims[rowAxis].getLiteral());
+  if (outputDims[colAxis].isLiteral() &&
+      outputDims[colAxis].getLiteral() < jRegTile) {
+    jRegTile = outputDims[colAxis].getLiteral();
+    simdize = false;
+  }
+  if (kDim.isLiteral())
+    kRegTile = std::min(kRegTile, kDim.getLiteral());
+
+  auto emitTiledLoops = [&](KrnlBuilder &createKrnl,
+                            ValueRange broadcastIndices) {
+    // A and C start at {broadcastIndices, 0, 0}, B at {0, 0}.
+    SmallVector<Value, 4> broadcastGlobalStart(
+        broadcastIndices.begin(), broadcastIndices.end());
+    broadcastGlobalStart.emplace_back(zero);
+    broadcastGlobalStart.emplace_back(zero);
+    ValueRange origLoop = createKrnl.defineLoops(3);
+    Value ii(origLoop[0]), jj(origLoop[1]), kk(origLoop[2]);
+    ValueRange iRegBlock = createKrnl.block(ii, iRegTile);
+    Value ii1(iRegBlock[0]), ii2(iRegBlock[1]);
+    ValueRange jRegBlock = createKrnl.block(jj, jRegTile);
+    Value jj1(jRegBlock[0]), jj2(jRegBlock[1]);
+    ValueRange kRegBlock = createKrnl.block(kk, kRegTile);
+    Value kk1(kRegBlock[0]), kk2(kRegBlock[1]);
+    createKrnl.permute({ii1, ii2, jj1, jj2, kk1, kk2}, {0, 3, 1, 4, 2, 5});
+    createKrnl.iterate({ii, jj, kk}, {ii1, jj1, kk1}, {zero, zero, zero},
+        {I, J, K}, [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          Value i1(indices[0]), j1(indices[1]), k1(indices[2]);
+          createKrnl.matmul(A, broadcastGlobalStart, B, {zero, zero}, C,
+              broadcastGlobalStart, {ii2, jj2, kk2}, {i1, j1, k1}, {I, J, K},
+              {iRegTile, jRegTile, kRegTile}, {}, {}, {}, simdize,
+              /*unroll*/ true, /*overcompute*/ false);
+        });
+  };
+  if (broadcastRank == 0) {
+    emitTiledLoops(create.krnl, {});
+  } else {
+    ValueRange broadcastLoop = create.krnl.defineLoops(broadcastRank);
+    SmallVector<IndexExpr, 4> broadcastLbs(
+        broadcastRank, LiteralIndexExpr(0));
+    SmallVector<IndexExpr, 4> broadcastUbs(
+        outputDims.begin(), outputDims.begin() + broadcastRank);
+    create.krnl.iterateIE(broadcastLoop, broadcastLoop, broadcastLbs,
+        broadcastUbs, emitTiledLoops);
+  }
+
+  // Row sums of A, only needed with a B zero point.
+  Value rowSumA;
+  if (hasBZeroPoint) {
+    DimsExpr rowDims(outputDims.begin(), outputDims.end() - 1);
+    rowSumA = allocI32Buffer(rewriter, loc, rowDims);
+    create.krnl.memset(rowSumA, i32Zero);
+    SmallVector<IndexExpr, 4> ubs(rowDims.begin(), rowDims.end());
+    ubs.emplace_back(kDim);
+    SmallVector<IndexExpr, 4> lbs(ubs.size(), LiteralIndexExpr(0));
+    ValueRange loopDef = create.krnl.defineLoops(ubs.size());
+    create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+          MathBuilder createMath(createKrnl);
+          ValueRange rowInd = loopInd.drop_back();
+          Value a = emitExtendQuantizedToI32(
+              rewriter, loc, createKrnl.load(A, loopInd));
+          Value sum = createMath.add(createKrnl.load(rowSumA, rowInd), a);
+          createKrnl.store(sum, rowSumA, rowInd);
+        });
+  }
+
+  // Column sums of B, only needed with an A zero point.
+  Value colSumB;
+  if (hasAZeroPoint) {
+    colSumB = allocI32Buffer(rewriter, loc, {outputDims[colAxis]});
+    create.krnl.memset(colSumB, i32Zero);
+    SmallVector<IndexExpr, 2> ubs{kDim, outputDims[colAxis]};
+    SmallVector<IndexExpr, 2> lbs(2, LiteralIndexExpr(0));
+    ValueRange loopDef = create.krnl.defineLoops(2);
+    create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+          MathBuilder createMath(createKrnl);
+          Value b = emitExtendQuantizedToI32(
+              rewriter, loc, createKrnl.load(B, loopInd));
+          Value sum = createMath.add(createKrnl.load(colSumB, loopInd[1]), b);
+          createKrnl.store(sum, colSumB, loopInd[1]);
+        });
+  }
+
+  // Apply the zero points and pass the results to 'storeFn'.
+  Value kI32 = create.math.cast(i32Type, K);
+  ValueRange loopDef = create.krnl.defineLoops(outputRank);
+  SmallVector<IndexExpr, 4> lbs(outputRank, LiteralIndexExpr(0));
+  create.krnl.iterateIE(loopDef, loopDef, lbs, outputDims,
+      [&](KrnlBuilder &createKrnl, ValueRange outputIndices) {
+        MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+        Value res = create.krnl.load(C, outputIndices);
+        Value aZp, bZp;
+        if (hasBZeroPoint) {
+          bZp = loadZeroPointAsI32(
+              create.krnl, bZeroPoint, outputIndices, colAxis);
+          Value rowSum =
+              create.krnl.load(rowSumA, outputIndices.drop_back());
+          res = create.math.sub(res, create.math.mul(bZp, rowSum));
+        }
+        if (hasAZeroPoint) {
+          aZp = loadZeroPointAsI32(
+              create.krnl, aZeroPoint, outputIndices, rowAxis);
+          Value colSum = create.krnl.load(colSumB, outputIndices[colAxis]);
+          res = create.math.sub(res, create.math.mul(aZp, colSum));
+        }
+        if (hasAZeroPoint && hasBZeroPoint)
+          res = create.math.add(
+              res, create.math.mul(kI32, create.math.mul(aZp, bZp)));
+        storeFn(createKrnl, res, outputIndices);
+      });
+}
+
+void emitIntegerMatMul(ConversionPatternRewriter &rewriter, Location loc,
+    Value A, Value B, Value aZeroPoint, Value bZeroPoint,
+    const DimsExpr &outputDims, IndexExpr kDim, const BitVector &aPadDims,
+    const BitVector &bPadDims, bool enableTiling,
+    function_ref<void(KrnlBuilder &, Value, ValueRange)> storeFn) {
+  int paddedRank = aPadDims.size();
+  // krnl.matmul handles a 2-D B and an A that is not 1-D, whose leading
+  // dimensions are then those of the output.
+  bool isBTwoDims = !bPadDims[paddedRank - 1];
+  for (int i = 0; i < paddedRank - 2; ++i)
+    isBTwoDims = isBTwoDims && bPadDims[i];
+  if (enableTiling && isBTwoDims && !aPadDims[paddedRank - 2]) {
+    emitTiledIntegerMatMul(rewriter, loc, A, B, aZeroPoint, bZeroPoint,
+        outputDims, kDim, storeFn);
+    return;
+  }
+
+  MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder> create(
+      rewriter, loc);
+  Type i32Type = rewriter.getI32Type();
+  int outerLoopNum = outputDims.size();
+  int totLoopNum = outerLoopNum + 1; // Add reduction inner loop.
+  int64_t rowAxis = getMatMulRowAxis(aPadDims, bPadDims, outerLoopNum);
+  int64_t colAxis = getMatMulColumnAxis(bPadDims, outerLoopNum);
+
+  // Define loops and bounds.
+  ValueRange loopDef = create.krnl.defineLoops(totLoopNum);
+  SmallVector<IndexExpr, 4> loopLbs(totLoopNum, LiteralIndexExpr(0));
+  SmallVector<IndexExpr, 4> loopUbs(outputDims.begin(), outputDims.end());
+  loopUbs.emplace_back(kDim);
+  SmallVector<Value, 4> outerLoops(
+      loopDef.begin(), loopDef.begin() + outerLoopNum);
+  SmallVector<Value, 1> innerLoop{loopDef[totLoopNum - 1]};
+  // Single scalar, no need for default alignment.
+  Value reductionVal = create.mem.alignedAlloca(MemRefType::get({}, i32Type));
+
+  create.krnl.iterateIE(loopDef, outerLoops, loopLbs, loopUbs,
+      [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+        MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+        // Zero points are invariant in the reduction loop.
+        Value aZp = loadZeroPointAsI32(
+            create.krnl, aZeroPoint, outerIndices, rowAxis);
+        Value bZp = loadZeroPointAsI32(
+            create.krnl, bZeroPoint, outerIndices, colAxis);
+        create.krnl.store(create.math.constant(i32Type, 0), reductionVal);
+        // Inner loop for reduction.
+        create.krnl.iterate({}, innerLoop, {}, {},
+            [&](KrnlBuilder &createKrnl, ValueRange innerIndex) {
+              MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+              Value k = innerIndex[0];
+              SmallVector<Value, 4> aAccessFct, bAccessFct;
+              for (int i = 0; i < paddedRank; ++i) {
+                // Same access functions as in the MatMul lowering: add index
+                // if dim is not a padded dimension.
+                if (!aPadDims[i])
+                  aAccessFct.emplace_back(
+                      i == paddedRank - 1 ? k : outerIndices[i]);
+                if (!bPadDims[i]) {
+                  if (i == paddedRank - 2)
+                    bAccessFct.emplace_back(k);
+                  else if (i == outerLoopNum)
+                    // A is 1-D and the output lost its row dimension.
+                    bAccessFct.emplace_back(outerIndices[i - 1]);
+                  else
+                    bAccessFct.emplace_back(outerIndices[i]);
+                }
+              }
+              Value a = emitExtendQuantizedToI32(
+                  rewriter, loc, create.krnl.load(A, aAccessFct));
+              Value b = emitExtendQuantizedToI32(
+                  rewriter, loc, create.krnl.load(B, bAccessFct));
+              Value ab = create.math.mul(
+                  create.math.sub(a, aZp), create.math.sub(b, bZp));
+              Value accumulated =
+                  create.math.add(create.krnl.load(reductionVal), ab);
+              create.krnl.store(accumulated, reductionVal);
+            });
+        storeFn(createKrnl, create.krnl.load(reductionVal), outerIndices);
+      });
+}
+
+void emitIntegerConv(ConversionPatternRewriter &rewriter, Location loc,
+    Value X, Value W, Value xZeroPoint, Value wZeroPoint, int64_t groupNum,
+    const DimsExpr &outputDims, ArrayRef<IndexExpr> pads,
+    ArrayRef<int64_t> strides, ArrayRef<int64_t> dilations,
+    bool enableParallel,
+    function_ref<void(KrnlBuilder &, Value, ValueRange)> storeFn) {
+  MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, SCFBuilder,
+      MathBuilder, MemRefBuilder>
+      create(rewriter, loc);
+  // Spatial data starts from the second dimension.
+  int spatialStartIndex = 2;
+  int outputRank = outputDims.size();
+  int spacialRank = outputRank - spatialStartIndex;
+  Type i32Type = rewriter.getI32Type();
+  Value i32Zero = create.math.constant(i32Type, 0);
+  IndexExpr G = LiteralIndexExpr(groupNum);
+  IndexExpr N = outputDims[0];
+  IndexExpr CO = outputDims[1];
+  IndexExpr COPerGroup = CO.ceilDiv(G);
+  IndexExpr CIPerGroup = create.krnlIE.getShapeAsSymbol(W, 1);
+  IndexExpr iZero = LiteralIndexExpr(0);
+  IndexExpr iOne = LiteralIndexExpr(1);
+
+  // The zero point of X is a scalar, invariant in all loops.
+  Value xZp = loadZeroPointAsI32(create.krnl, xZeroPoint, {}, -1);
+
+  SmallVector<Value, 3> lbsStorage, ubsStorage, stepsStorage;
+  SmallVector<IndexExpr, 3> outerLbs = {iZero, iZero, iZero};
+  SmallVector<IndexExpr, 3> outerUbs = {N, G, COPerGroup};
+  SmallVector<IndexExpr, 3> outerSteps = {iOne, iOne, iOne};
+  IndexExpr::getValues(outerLbs, lbsStorage);
+  IndexExpr::getValues(outerUbs, ubsStorage);
+  IndexExpr::getValues(outerSteps, stepsStorage);
+
+  // Single scalar, no need for default alignment.
+  Value reductionVal = create.mem.alloca(MemRefType::get({}, i32Type));
+  // Same loop structure as the float Conv lowering:
+  // for n = 0 .. N, g = 0 .. G, coPerGroup = 0 .. COPerGroup:
+  //   co = g * COPerGroup + coPerGroup;
+  //   for output spatial indices o:
+  //     for ciPerGroup = 0 .. CIPerGroup, kernel indices k in the window:
+  auto bodyFunction = [&](ValueRange outerIndices) {
+    IndexExprScope outerScope(create.krnl);
+    DimIndexExpr g(outerIndices[1]);
+    DimIndexExpr coPerGroup(outerIndices[2]);
+    IndexExpr co = g * SymbolIndexExpr(COPerGroup) + coPerGroup;
+    IndexExpr gTimesCIPerGroup = g * SymbolIndexExpr(CIPerGroup);
+    // The zero point of W is per output channel, invariant in inner loops.
+    SmallVector<Value, 1> coInd{co.getValue()};
+    Value wZp = loadZeroPointAsI32(create.krnl, wZeroPoint, coInd, 0);
+    ValueRange outputSpacialLoops = create.krnl.defineLoops(spacialRank);
+    SmallVector<IndexExpr, 3> outputSpacialLbs, outputSpacialUbs;
+    for (int i = spatialStartIndex; i < outputRank; ++i) {
+      outputSpacialLbs.emplace_back(iZero);
+      outputSpacialUbs.emplace_back(SymbolIndexExpr(outputDims[i]));
+    }
+    create.krnl.iterateIE(outputSpacialLoops, outputSpacialLoops,
+        outputSpacialLbs, outputSpacialUbs,
+        [&](KrnlBuilder &createKrnl, ValueRange outputSpatialIndices) {
+          IndexExprScope outputSpacialScope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl,
+              MathBuilder>
+              create(createKrnl);
+          create.krnl.store(i32Zero, reductionVal);
+
+          // Bounds for reduction loops. Padded elements of X are equal to
+          // its zero point and contribute nothing, so the reduction is
+          // restricted to the window within X.
+          ValueRange redLoops = create.krnl.defineLoops(spacialRank + 1);
+          SmallVector<IndexExpr, 4> redLbs, redUbs, pMinOS;
+          redLbs.emplace_back(iZero);
+          redUbs.emplace_back(SymbolIndexExpr(CIPerGroup));
+          for (int i = 0; i < spacialRank; ++i) {
+            DimIndexExpr o(outputSpatialIndices[i]);
+            SymbolIndexExpr I(
+                create.krnlIE.getShapeAsSymbol(X, spatialStartIndex + i));
+            SymbolIndexExpr K(
+                create.krnlIE.getShapeAsSymbol(W, spatialStartIndex + i));
+            SymbolIndexExpr p(pads[i]); // Beginning/left/top pad.
+            LiteralIndexExpr s(strides[i]);
+            LiteralIndexExpr d(dilations[i]);
+            // lb = ceil((p - o * s) / d)
+            IndexExpr pos = p - (o * s);
+            IndexExpr lb = pos.ceilDiv(d);
+            lb = IndexExpr::max(lb, 0);
+            redLbs.emplace_back(lb);
+            // ub = ceil((I + p - o * s) / d)
+            IndexExpr ipos = I + pos;
+            IndexExpr ub = ipos.ceilDiv(d);
+            ub = IndexExpr::min(ub, K);
+            redUbs.emplace_back(ub);
+            pMinOS.emplace_back(pos);
+          }
+          create.krnl.iterateIE(redLoops, redLoops, redLbs, redUbs,
+              [&](KrnlBuilder &createKrnl, ValueRange redIndices) {
+                IndexExprScope redScope(createKrnl);
+                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                    createKrnl);
+                // X access: [n, g * CIPerG + ciPerG, o * s + k * d - p].
+                SmallVector<IndexExpr, 4> inputAccessFct;
+                inputAccessFct.emplace_back(DimIndexExpr(outerIndices[0]));
+                DimIndexExpr ciPerG(redIndices[0]);
+                inputAccessFct.emplace_back(
+                    SymbolIndexExpr(gTimesCIPerGroup) + ciPerG);
+                for (int i = 0; i < spacialRank; ++i) {
+                  DimIndexExpr k(redIndices[1 + i]);
+                  LiteralIndexExpr d(dilations[i]);
+                  inputAccessFct.emplace_back(
+                      (k * d) - SymbolIndexExpr(pMinOS[i]));
+                }
+                // W access: [co, ciPerG, k].
+                SmallVector<IndexExpr, 4> filterAccessFct;
+                filterAccessFct.emplace_back(SymbolIndexExpr(co));
+                filterAccessFct.emplace_back(ciPerG);
+                for (int i = 0; i < spacialRank; ++i)
+                  filterAccessFct.emplace_back(DimIndexExpr(redIndices[1 + i]));
+                Value x = emitExtendQuantizedToI32(
+                    rewriter, loc, create.krnl.loadIE(X, inputAccessFct));
+                Value w = emitExtendQuantizedToI32(
+                    rewriter, loc, create.krnl.loadIE(W, filterAccessFct));
+                Value xw = create.math.mul(
+                    create.math.sub(x, xZp), create.math.sub(w, wZp));
+                create.krnl.store(
+                    create.math.add(create.krnl.load(reductionVal), xw),
+                    reductionVal);
+              });
+          SmallVector<Value, 4> outputIndices{
+              outerIndices[0], SymbolIndexExpr(co).getValue()};
+          outputIndices.append(
+              outputSpatialIndices.begin(), outputSpatialIndices.end());
+          storeFn(createKrnl, create.krnl.load(reductionVal), outputIndices);
+        });
+  };
+
+  if (enableParallel) {
+    create.scf.parallelLoop(lbsStorage, ubsStorage, stepsStorage,
+        [&](SCFBuilder &create, ValueRange outerIndices) {
+          bodyFunction(outerIndices);
+        });
+  } else {
+    ValueRange outerLoops = create.krnl.defineLoops(3);
+    create.krnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
+        [&](KrnlBuilder &create, ValueRange outerIndices) {
+          bodyFunction(outerIndices);
+        });
+  }
+}
+
+} // namespace onnx_mlir
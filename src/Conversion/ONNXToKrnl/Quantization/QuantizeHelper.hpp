@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------ QuantizeHelper.hpp - Lowering Quantized Ops -------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file defines common functions for lowering the ONNX quantized
+// Operators.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "llvm/ADT/BitVector.h"
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
+
+namespace onnx_mlir {
+
+/// Return true if a zero point or scale of an integer matrix multiplication
+/// is supported, namely when it is absent, a scalar, or a 1-D tensor (per-row
+/// for A, per-column for B and the output).
+bool isSupportedMatMulQuantizationParam(mlir::Value param);
+
+/// Return true if a zero point or scale is absent, a scalar, or a 1-D tensor
+/// with a single element.
+bool isScalarQuantizationParam(mlir::Value param);
+
+/// Emit the integer matrix multiplication
+///   Y[..., i, j] = sum_k (A[..., i, k] - aZeroPoint[i]) *
+///                        (B[..., k, j] - bZeroPoint[j])
+/// with numpy broadcasting rules, where A and B are i8 or ui8 and the products
+/// are accumulated in i32. 'outputDims', 'aPadDims' and 'bPadDims' come from
+/// the ONNXGenericMatMulOpShapeHelper of the op and 'kDim' is the reduction
+/// dimension. Each accumulated result is passed to 'storeFn' along with its
+/// output indices. With 'enableTiling', a 2-D B multiplying an A that is not
+/// 1-D goes through the tiled and simdized krnl.matmul with an i32 C.
+void emitIntegerMatMul(mlir::ConversionPatternRewriter &rewriter,
+    mlir::Location loc, mlir::Value A, mlir::Value B, mlir::Value aZeroPoint,
+    mlir::Value bZeroPoint, const DimsExpr &outputDims, IndexExpr kDim,
+    const llvm::BitVector &aPadDims, const llvm::BitVector &bPadDims,
+    bool enableTiling,
+    llvm::function_ref<void(KrnlBuilder &, mlir::Value, mlir::ValueRange)>
+        storeFn);
+
+/// Return the output axis indexing the rows (resp. columns) of an integer
+/// matrix multiplication, or -1 when A (resp. B) is 1-D.
+int64_t getMatMulRowAxis(const llvm::BitVector &aPadDims,
+    const llvm::BitVector &bPadDims, int64_t outputRank);
+int64_t getMatMulColumnAxis(
+    const llvm::BitVector &bPadDims, int64_t outputRank);
+
+/// Emit the integer convolution
+///   Y[n, co, o] = sum_{ci, k} (X[n, g * C/group + ci, o * s + k * d - p] -
+///                              xZeroPoint) * (W[co, ci, k] - wZeroPoint[co])
+/// where X and W are i8 or ui8 and the products are accumulated in i32. The
+/// zero point of X is a scalar and the one of W is a scalar or per output
+/// channel. 'outputDims', 'pads', 'strides' and 'dilations' come from the
+/// ONNXGenericPoolOpShapeHelper of the op. Each accumulated result is passed
+/// to 'storeFn' along with its output indices. The batch and output channel
+/// loops are parallel with 'enableParallel'.
+void emitIntegerConv(mlir::ConversionPatternRewriter &rewriter,
+    mlir::Location loc, mlir::Value X, mlir::Value W, mlir::Value xZeroPoint,
+    mlir::Value wZeroPoint, int64_t groupNum, const DimsExpr &outputDims,
+    llvm::ArrayRef<IndexExpr> pads, llvm::ArrayRef<int64_t> strides,
+    llvm::ArrayRef<int64_t> dilations, bool enableParallel,
+    llvm::function_ref<void(KrnlBuilder &, mlir::Value, mlir::ValueRange)>
+        storeFn);
+
+} // namespace onnx_mlir
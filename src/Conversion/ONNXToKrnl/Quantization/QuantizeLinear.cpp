@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------- QuantizeLinear.cpp - Lowering QuantizeLinear Op --------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX QuantizeLinear Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Dialect/Krnl/DialectBuilder.hpp"
+#include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+struct ONNXQuantizeLinearOpLowering : public ConversionPattern {
+  ONNXQuantizeLinearOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(
+            typeConverter, ONNXQuantizeLinearOp::getOperationName(), 1, ctx) {}
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    using LocalDialectBuilder =
+        MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder>;
+    Location loc = ONNXLoc<ONNXQuantizeLinearOp>(op);
+    LocalDialectBuilder create(rewriter, loc);
+    ONNXQuantizeLinearOpAdaptor operandAdaptor(
+        operands, op->getAttrDictionary());
+    Value X = operandAdaptor.x();
+    Value scale = operandAdaptor.y_scale();
+    Value zeroPoint = operandAdaptor.y_zero_point();
+
+    // Convert the output type to MemRefType.
+    Type convertedType = typeConverter->convertType(*op->result_type_begin());
+    assert(convertedType && convertedType.isa<MemRefType>() &&
+           "Failed to convert type to MemRefType");
+    MemRefType memRefType = convertedType.cast<MemRefType>();
+    Type quantizedType = memRefType.getElementType();
+    int64_t rank = memRefType.getRank();
+    int64_t axis = operandAdaptor.axis();
+    if (axis < 0)
+      axis += rank;
+
+    // Get shape.
+    ONNXUnaryOpShapeHelper shapeHelper(op, operands, &create.krnlIE);
+    shapeHelper.computeShapeAndAssertOnFailure();
+
+    // Insert an allocation and deallocation for the result of this operation.
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+
+    // y = saturate(round(x / y_scale) + y_zero_point).
+    auto computeResult = [&](LocalDialectBuilder &create, ValueRange indices) {
+      Type f32Type = rewriter.getF32Type();
+      Value x = create.math.cast(f32Type, create.krnl.load(X, indices));
+      Value s = loadQuantizationParam(create.krnl, scale, indices, axis);
+      Value zp = loadZeroPointAsI32(create.krnl, zeroPoint, indices, axis);
+      Value res = emitQuantizeScalar(rewriter, loc, x, s,
+          create.math.cast(f32Type, zp), quantizedType);
+      create.krnl.store(res, alloc, indices);
+    };
+
+    if (rank > 0) {
+      ValueRange loopDef = create.krnl.defineLoops(rank);
+      SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
+      create.krnl.iterateIE(loopDef, loopDef, lbs, shapeHelper.getOutputDims(),
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            LocalDialectBuilder create(createKrnl);
+            computeResult(create, indices);
+          });
+    } else {
+      computeResult(create, {});
+    }
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXQuantizeLinearOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXQuantizeLinearOpLowering>(typeConverter, ctx);
+}
+
+} // namespace onnx_mlir
@@ -20,9 +20,40 @@ using namespace mlir;
 namespace onnx_mlir {
 
 struct ONNXResizeOpLowering : public ConversionPattern {
-  ONNXResizeOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  ONNXResizeOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(
-            typeConverter, mlir::ONNXResizeOp::getOperationName(), 1, ctx) {}
+            typeConverter, mlir::ONNXResizeOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+
+  bool enableParallel;
+
+  // Return the number of leading axes that are known not to be resized, such
+  // as the N and C axes of an image, so that the runtime can resize the planes
+  // of these axes in parallel.
+  int64_t getNumOuterAxes(ONNXResizeOp resizeOp, MemRefType inputType,
+      MemRefType outputType, DenseElementsAttr scalesAttrs) const {
+    // With scale 1, this mode still shifts the coordinates by half a pixel.
+    if (resizeOp.coordinate_transformation_mode() == "tf_half_pixel_for_nn")
+      return 0;
+    int64_t rank = outputType.getRank();
+    SmallVector<double, 4> scales;
+    if (scalesAttrs)
+      for (auto scaleAttr : scalesAttrs.getValues<FloatAttr>())
+        scales.emplace_back(scaleAttr.getValueAsDouble());
+    int64_t numOuterAxes = 0;
+    for (; numOuterAxes < rank - 1; ++numOuterAxes) {
+      if (!isFromNone(resizeOp.scales())) {
+        if (!scalesAttrs || scales[numOuterAxes] != 1.0)
+          break;
+      } else {
+        int64_t inDim = inputType.getShape()[numOuterAxes];
+        if (inDim < 0 || inDim != outputType.getShape()[numOuterAxes])
+          break;
+      }
+    }
+    return numOuterAxes;
+  }
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -48,10 +79,14 @@ struct ONNXResizeOpLowering : public ConversionPattern {
         (resizeOp.coordinate_transformation_mode() != "asymmetric" &&
             resizeOp.coordinate_transformation_mode() != "half_pixel"))
       return emitError(loc, "not implemented yet");
+    // The runtime functions do not take roi.
+    if (resizeOp.coordinate_transformation_mode() == "tf_crop_and_resize")
+      return emitError(loc, "not implemented yet");
 
-    MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder> create(
-        rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder, SCFBuilder>
+        create(rewriter, loc);
     SmallVector<Value, 4> scaleValues;
+    DenseElementsAttr scalesAttrs;
     bool fromScale = !isFromNone(resizeOp.scales());
     IndexExprScope outerloopContex(&rewriter, loc);
     DimsExpr outputDims(rank);
@@ -63,8 +98,7 @@ struct ONNXResizeOpLowering : public ConversionPattern {
       // Attribute::cast() const [with U = mlir::IntegerAttr]
       // The reason seems to be that IntegerAttr is assumed
       //
-      DenseElementsAttr scalesAttrs =
-          getDenseElementAttributeFromONNXValue(resizeOp.scales());
+      scalesAttrs = getDenseElementAttributeFromONNXValue(resizeOp.scales());
       SmallVector<float, 4> scalesConstant;
       if (scalesAttrs) {
         for (auto scaleAttr : scalesAttrs.getValues<FloatAttr>()) {
@@ -129,20 +163,48 @@ struct ONNXResizeOpLowering : public ConversionPattern {
 
     // Call external function when the mode is not "nearest"
     // Create KrnlCallOp and replace the du chain
-    // One of inputs, scales() and size(), has to be None.
-    // For now, None input is picked out by KrnlCall builder,
-    // and different function will be called accordingly.
-    // Another issue is the attributes with default value.
-    // Currently, it is assumed that all the optional attributes have
-    // the default value and does appear in the Attribute dictionry.
-    // ToFix: Handle attributes for general case
+    // Only the data and one of scales() and size() are passed, and
+    // different function will be called accordingly. roi is not used by the
+    // supported coordinate transformation modes.
+    // The attributes are passed in alphabetical order after the operands, and
+    // the runtime functions take all of them with their default values.
     if (resizeOp.mode() != "nearest") {
+      int64_t numOuterAxes = 0;
+      if (enableParallel)
+        numOuterAxes = getNumOuterAxes(resizeOp,
+            data.getType().cast<MemRefType>(), memRefType, scalesAttrs);
+      if (numOuterAxes > 0) {
+        // Resize each plane of the outer axes in a parallel loop, the runtime
+        // resizing the planes [begin, end).
+        Value numPlanes = dataBounds.getDim(0).getValue();
+        for (int64_t i = 1; i < numOuterAxes; ++i)
+          numPlanes =
+              create.math.mul(numPlanes, dataBounds.getDim(i).getValue());
+        Value outerRank =
+            create.math.constant(rewriter.getIntegerType(64), numOuterAxes);
+        Value zeroIndex = create.math.constantIndex(0);
+        Value oneIndex = create.math.constantIndex(1);
+        bool hasScales = !isFromNone(resizeOp.scales());
+        create.scf.parallelLoop({zeroIndex}, {numPlanes}, {oneIndex},
+            [&](SCFBuilder &createSCF, ValueRange planeIndex) {
+              Value begin = planeIndex[0];
+              Value end = create.math.add(begin, oneIndex);
+              if (hasScales)
+                rewriter.create<KrnlCallOp>(loc, "Resize_Scales_Planes", alloc,
+                    op, ValueRange{data, scales, outerRank, begin, end}, true);
+              else
+                rewriter.create<KrnlCallOp>(loc, "Resize_Size_Planes", alloc,
+                    op, ValueRange{data, sizes, outerRank, begin, end}, true);
+            });
+        rewriter.replaceOp(op, alloc);
+        return success();
+      }
       if (!isFromNone(resizeOp.scales())) {
         rewriter.create<KrnlCallOp>(
-            loc, "Resize_Scales", alloc, op, operands, true);
+            loc, "Resize_Scales", alloc, op, ValueRange{data, scales}, true);
       } else {
         rewriter.create<KrnlCallOp>(
-            loc, "Resize_Size", alloc, op, operands, true);
+            loc, "Resize_Size", alloc, op, ValueRange{data, sizes}, true);
       }
       rewriter.replaceOp(op, alloc);
       return success();
@@ -237,8 +299,8 @@ struct ONNXResizeOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXResizeOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
-  patterns.insert<ONNXResizeOpLowering>(typeConverter, ctx);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXResizeOpLowering>(typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
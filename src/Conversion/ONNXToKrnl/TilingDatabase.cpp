@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//====------------ TilingDatabase.cpp - Tuned MatMul tile sizes -----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains the implementation of a database of tile sizes for the
+// MatMul and Gemm lowerings, tuned offline per problem size, element type and
+// target cpu.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "src/Conversion/ONNXToKrnl/TilingDatabase.hpp"
+
+#define DEBUG_TYPE "tiling-db"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+std::string TilingDatabase::getKey(
+    StringRef op, StringRef dtype, int64_t I, int64_t J, int64_t K) {
+  return llvm::formatv("{0}:{1}:{2}x{3}x{4}", op, dtype, I, J, K).str();
+}
+
+LogicalResult TilingDatabase::load(
+    StringRef path, StringRef mcpu, std::string &errorMessage) {
+  entries.clear();
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+      llvm::MemoryBuffer::getFile(path);
+  if (std::error_code ec = buffer.getError()) {
+    errorMessage = "cannot open tiling database " + path.str() + ": " +
+                   ec.message();
+    return failure();
+  }
+  llvm::Expected<llvm::json::Value> json =
+      llvm::json::parse(buffer.get()->getBuffer());
+  if (!json) {
+    errorMessage = "cannot parse tiling database " + path.str() + ": " +
+                   llvm::toString(json.takeError());
+    return failure();
+  }
+  const llvm::json::Object *root = json->getAsObject();
+  const llvm::json::Array *array = root ? root->getArray("entries") : nullptr;
+  if (!array) {
+    errorMessage = "tiling database " + path.str() + " has no entries array";
+    return failure();
+  }
+
+  // Entries for any cpu are added first so that the entries for the given cpu
+  // override them.
+  for (bool cpuSpecific : {false, true}) {
+    for (const llvm::json::Value &value : *array) {
+      const llvm::json::Object *entry = value.getAsObject();
+      if (!entry) {
+        errorMessage = "tiling database entries must be objects";
+        return failure();
+      }
+      llvm::Optional<StringRef> entryCpu = entry->getString("mcpu");
+      if (cpuSpecific != entryCpu.has_value())
+        continue;
+      if (entryCpu.has_value() && entryCpu.value() != mcpu)
+        continue;
+      llvm::Optional<StringRef> op = entry->getString("op");
+      llvm::Optional<StringRef> dtype = entry->getString("dtype");
+      llvm::Optional<int64_t> I = entry->getInteger("I");
+      llvm::Optional<int64_t> J = entry->getInteger("J");
+      llvm::Optional<int64_t> K = entry->getInteger("K");
+      if (!op || !dtype || !I || !J || !K) {
+        errorMessage = "tiling database entries need op, dtype, I, J and K";
+        return failure();
+      }
+      MatMulTileSizes sizes;
+      sizes.iCacheTile = entry->getInteger("iCacheTile").value_or(-1);
+      sizes.jCacheTile = entry->getInteger("jCacheTile").value_or(-1);
+      sizes.kCacheTile = entry->getInteger("kCacheTile").value_or(-1);
+      sizes.iRegTile = entry->getInteger("iRegTile").value_or(-1);
+      sizes.jRegTile = entry->getInteger("jRegTile").value_or(-1);
+      sizes.kRegTile = entry->getInteger("kRegTile").value_or(-1);
+      entries[getKey(*op, *dtype, *I, *J, *K)] = sizes;
+    }
+  }
+  LLVM_DEBUG(llvm::dbgs() << "Loaded " << entries.size()
+                          << " tiling entries for mcpu '" << mcpu << "' from "
+                          << path << "\n");
+  return success();
+}
+
+llvm::Optional<MatMulTileSizes> TilingDatabase::lookup(
+    StringRef op, Type elementType, int64_t I, int64_t J, int64_t K) const {
+  if (entries.empty())
+    return llvm::None;
+  std::string dtype;
+  llvm::raw_string_ostream dtypeOS(dtype);
+  dtypeOS << elementType;
+  auto it = entries.find(getKey(op, dtypeOS.str(), I, J, K));
+  if (it == entries.end())
+    return llvm::None;
+  return it->second;
+}
+
+} // namespace onnx_mlir
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//====------------ TilingDatabase.hpp - Tuned MatMul tile sizes -----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains the declaration of a database of tile sizes for the
+// MatMul and Gemm lowerings, tuned offline per problem size, element type and
+// target cpu.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "mlir/IR/Types.h"
+#include "mlir/Support/LogicalResult.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+
+namespace onnx_mlir {
+
+/// Tile sizes of a matrix multiplication C[I, J] += A[I, K] * B[K, J]. A
+/// negative value means that the lowering uses its own heuristic for that
+/// tile size.
+struct MatMulTileSizes {
+  int64_t iCacheTile = -1;
+  int64_t jCacheTile = -1;
+  int64_t kCacheTile = -1;
+  int64_t iRegTile = -1;
+  int64_t jRegTile = -1;
+  int64_t kRegTile = -1;
+};
+
+/// Database of tile sizes read from a JSON file of the form:
+///
+/// {
+///   "entries": [
+///     { "op": "gemm", "mcpu": "skylake-avx512", "dtype": "f32",
+///       "I": 128, "J": 1024, "K": 1024,
+///       "iCacheTile": 64, "jCacheTile": 128, "kCacheTile": 256,
+///       "iRegTile": 4, "jRegTile": 16 }
+///   ]
+/// }
+///
+/// "op" is "gemm" or "matmul", and an entry without "mcpu" applies to any
+/// target cpu. Entries are usually generated by utils/TuneMatMulTiles.py.
+/// The ONNX to Krnl lowering pass owns its database and hands it to the Gemm
+/// and MatMul patterns by reference, so that concurrent compilations do not
+/// share any state.
+class TilingDatabase {
+public:
+  /// Load the entries of the database at 'path' that apply to 'mcpu'. Entries
+  /// for that specific cpu take precedence over the ones for any cpu.
+  mlir::LogicalResult load(
+      llvm::StringRef path, llvm::StringRef mcpu, std::string &errorMessage);
+
+  /// Remove all the entries.
+  void clear() { entries.clear(); }
+
+  bool empty() const { return entries.empty(); }
+
+  /// Return the tile sizes tuned for the given op and problem size, if any.
+  llvm::Optional<MatMulTileSizes> lookup(llvm::StringRef op,
+      mlir::Type elementType, int64_t I, int64_t J, int64_t K) const;
+
+private:
+  static std::string getKey(llvm::StringRef op, llvm::StringRef dtype,
+      int64_t I, int64_t J, int64_t K);
+
+  llvm::StringMap<MatMulTileSizes> entries;
+};
+
+} // namespace onnx_mlir
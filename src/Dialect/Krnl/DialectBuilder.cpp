@@ -248,9 +248,9 @@ Value KrnlBuilder::strlen(Value str) const {
 }
 
 void KrnlBuilder::randomNormal(Value alloc, Value numberOfRandomValues,
-    Value mean, Value scale, Value seed) const {
+    Value mean, Value scale, Value seed, Value firstValue) const {
   b().create<KrnlRandomNormalOp>(
-      loc(), alloc, numberOfRandomValues, mean, scale, seed);
+      loc(), alloc, numberOfRandomValues, mean, scale, seed, firstValue);
 }
 
 Value KrnlBuilder::findIndex(Value input, Value G, Value V, Value len) const {
@@ -258,6 +258,12 @@ Value KrnlBuilder::findIndex(Value input, Value G, Value V, Value len) const {
       loc(), b().getIndexType(), input, G, V, len);
 }
 
+void KrnlBuilder::findIndexBatch(Value input, Value G, Value V, Value len,
+    Value keys, Value numberOfValues, Value indices, Value keyLens) const {
+  b().create<KrnlFindIndexBatchOp>(
+      loc(), input, G, V, len, keys, numberOfValues, indices, keyLens);
+}
+
 void KrnlBuilder::printTensor(StringRef msg, Value input) const {
   b().create<KrnlPrintTensorOp>(loc(), msg, input);
 }
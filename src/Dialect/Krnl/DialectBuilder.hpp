@@ -151,10 +151,16 @@ struct KrnlBuilder : public DialectBuilder {
   void printf(mlir::Value input, mlir::Type inputType) const;
 
   // Onnx-mlir runtime functions.
+  // Generate the numberOfRandomValues values of alloc starting at firstValue,
+  // or all its values when firstValue is null.
   void randomNormal(mlir::Value alloc, mlir::Value numberOfRandomValues,
-      mlir::Value mean, mlir::Value scale, mlir::Value seed) const;
+      mlir::Value mean, mlir::Value scale, mlir::Value seed,
+      mlir::Value firstValue = nullptr) const;
   mlir::Value findIndex(
       mlir::Value input, mlir::Value G, mlir::Value V, mlir::Value len) const;
+  void findIndexBatch(mlir::Value input, mlir::Value G, mlir::Value V,
+      mlir::Value len, mlir::Value keys, mlir::Value numberOfValues,
+      mlir::Value indices, mlir::Value keyLens = nullptr) const;
   void printTensor(mlir::StringRef msg, mlir::Value input) const;
 };
 
@@ -508,7 +508,7 @@ void KrnlEntryPointOp::build(mlir::OpBuilder &builder, OperationState &state,
 }
 
 void KrnlInstrumentOp::build(mlir::OpBuilder &builder, OperationState &state,
-    Operation *op, int tag = 0) {
+    Operation *op, int64_t tag = 0) {
   const char *opName = op->getName().getStringRef().data();
   StringAttr opNameAttr = builder.getStringAttr(StringRef(opName));
   IntegerAttr tagAttr = builder.getI64IntegerAttr(tag);
@@ -865,6 +865,26 @@ LogicalResult KrnlCopyFromBufferOp::verify() {
   return success();
 }
 
+//===----------------------------------------------------------------------===//
+// KrnlFindIndexBatchOp
+//===----------------------------------------------------------------------===//
+
+LogicalResult KrnlFindIndexBatchOp::verify() {
+  KrnlFindIndexBatchOpAdaptor opAdaptor = KrnlFindIndexBatchOpAdaptor(*this);
+  Type inputElementType =
+      opAdaptor.input().getType().cast<MemRefType>().getElementType();
+  Type keysElementType =
+      opAdaptor.keys().getType().cast<MemRefType>().getElementType();
+  if (inputElementType != keysElementType)
+    return emitOpError("input and keys must have the same element type");
+  bool isString = inputElementType.isa<krnl::StringType>();
+  if (isString && !opAdaptor.keyLens())
+    return emitOpError("keyLens is required for string keys");
+  if (!isString && opAdaptor.keyLens())
+    return emitOpError("keyLens is only expected for string keys");
+  return success();
+}
+
 void KrnlSeqExtractOp::getEffects(
     SmallVectorImpl<SideEffects::EffectInstance<MemoryEffects::Effect>>
         &effects) {
@@ -20,6 +20,7 @@
 #include "mlir/Dialect/Shape/IR/Shape.h"
 #include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/BlockAndValueMapping.h"
+#include "mlir/IR/TypeUtilities.h"
 #include "llvm/ADT/TypeSwitch.h"
 #include "llvm/Support/Debug.h"
 
@@ -63,23 +64,29 @@ Value MathBuilder::ori(Value lhs, Value rhs) const {
   return b().create<arith::OrIOp>(loc(), lhs, rhs);
 }
 
+// Whether a scalar or vector type holds integers or indices.
+static bool isIntegerOrIndex(Type type) {
+  Type elementType = getElementTypeOrSelf(type);
+  return elementType.isa<IntegerType>() || elementType.isa<IndexType>();
+}
+
 Value MathBuilder::add(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerOrIndex(lhs.getType()))
     return b().create<arith::AddIOp>(loc(), lhs, rhs);
   return b().create<arith::AddFOp>(loc(), lhs, rhs);
 }
 
 Value MathBuilder::sub(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerOrIndex(lhs.getType()))
     return b().create<arith::SubIOp>(loc(), lhs, rhs);
   return b().create<arith::SubFOp>(loc(), lhs, rhs);
 }
 
 Value MathBuilder::mul(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerOrIndex(lhs.getType()))
     return b().create<arith::MulIOp>(loc(), lhs, rhs);
   return b().create<arith::MulFOp>(loc(), lhs, rhs);
 }
@@ -191,6 +198,10 @@ Value MathBuilder::constant(Type type, double val) const {
         constant =
             b().create<arith::ConstantOp>(loc(), b().getF16FloatAttr(val));
       })
+      .Case<BFloat16Type>([&](Type) {
+        constant = b().create<arith::ConstantOp>(
+            loc(), b().getFloatAttr(b().getBF16Type(), val));
+      })
       .Case<Float32Type>([&](Type) {
         constant =
             b().create<arith::ConstantOp>(loc(), b().getF32FloatAttr(val));
@@ -231,6 +242,10 @@ Value MathBuilder::constantIndex(int64_t val) const {
 Value MathBuilder::negativeInf(Type type) const {
   Value constant = nullptr;
   TypeSwitch<Type>(type)
+      .Case<Float16Type, BFloat16Type>([&](Type) {
+        constant = b().create<arith::ConstantOp>(loc(),
+            b().getFloatAttr(type, -std::numeric_limits<float>::infinity()));
+      })
       .Case<Float32Type>([&](Type) {
         constant = b().create<arith::ConstantOp>(loc(),
             b().getF32FloatAttr(-std::numeric_limits<float>::infinity()));
@@ -280,6 +295,10 @@ Value MathBuilder::negativeInf(Type type) const {
 Value MathBuilder::positiveInf(Type type) const {
   Value constant = nullptr;
   TypeSwitch<Type>(type)
+      .Case<Float16Type, BFloat16Type>([&](Type) {
+        constant = b().create<arith::ConstantOp>(loc(),
+            b().getFloatAttr(type, std::numeric_limits<float>::infinity()));
+      })
       .Case<Float32Type>([&](Type) {
         constant = b().create<arith::ConstantOp>(
             loc(), b().getF32FloatAttr(std::numeric_limits<float>::infinity()));
@@ -429,7 +448,9 @@ Value MathBuilder::cast(Type destType, Value src) const {
 
   // Float to float conversions.
   if (srcType.isa<FloatType>() && destType.isa<FloatType>()) {
-    assert((bitExtend || bitTrunc) && "expected extend or trunc");
+    // f16 <-> bf16 conversions go through f32.
+    if (!bitExtend && !bitTrunc)
+      return cast(destType, cast(b().getF32Type(), src));
     if (bitExtend)
       return b().create<arith::ExtFOp>(loc(), destType, src);
     else
@@ -499,6 +520,36 @@ Value MathBuilder::cast(Type destType, Value src) const {
   return nullptr;
 }
 
+Type MathBuilder::getComputeType(Type type) {
+  Type elementType = getElementTypeOrSelf(type);
+  if (!elementType.isF16() && !elementType.isBF16())
+    return type;
+  Type f32Type = FloatType::getF32(type.getContext());
+  if (VectorType vecType = type.dyn_cast<VectorType>())
+    return VectorType::get(vecType.getShape(), f32Type);
+  return f32Type;
+}
+
+Value MathBuilder::extendToComputeType(Value val) const {
+  Type computeType = getComputeType(val.getType());
+  if (computeType == val.getType())
+    return val;
+  return b().create<arith::ExtFOp>(loc(), computeType, val);
+}
+
+Value MathBuilder::truncateToStorageType(
+    Type storageElementType, Value val) const {
+  if (!storageElementType.isF16() && !storageElementType.isBF16())
+    return val;
+  Type type = val.getType();
+  if (getElementTypeOrSelf(type) == storageElementType)
+    return val;
+  Type storageType = storageElementType;
+  if (VectorType vecType = type.dyn_cast<VectorType>())
+    storageType = VectorType::get(vecType.getShape(), storageElementType);
+  return b().create<arith::TruncFOp>(loc(), storageType, val);
+}
+
 Value MathBuilder::castToIndex(Value src) const {
   return cast(b().getIndexType(), src);
 }
@@ -754,6 +805,11 @@ void VectorBuilder::storeIE(mlir::Value val, mlir::Value memref,
 }
 
 Value VectorBuilder::fma(Value lhs, Value rhs, Value acc) const {
+  // There is no integer fma, integers are multiplied and added.
+  if (getElementTypeOrSelf(lhs.getType()).isa<IntegerType>()) {
+    MathBuilder createMath(*this);
+    return createMath.add(createMath.mul(lhs, rhs), acc);
+  }
   return b().create<vector::FMAOp>(loc(), lhs, rhs, acc);
 }
 
@@ -86,6 +86,7 @@ struct MathBuilder final : DialectBuilder {
   mlir::Value andi(mlir::Value lhs, mlir::Value rhs) const;
   mlir::Value ori(mlir::Value lhs, mlir::Value rhs) const;
 
+  // Add, sub and mul apply to scalars or vectors of integers or floats.
   mlir::Value add(mlir::Value lhs, mlir::Value rhs) const;
   mlir::Value sub(mlir::Value lhs, mlir::Value rhs) const;
   mlir::Value mul(mlir::Value lhs, mlir::Value rhs) const;
@@ -125,6 +126,18 @@ struct MathBuilder final : DialectBuilder {
   mlir::Value cast(mlir::Type destType, mlir::Value val) const;
   mlir::Value castToIndex(mlir::Value val) const;
 
+  // 16-bit floats (f16 and bf16) are kept as such in memory, but computations
+  // on them are performed in f32. Return the type in which computations on
+  // scalars or vectors of 'type' are performed.
+  static mlir::Type getComputeType(mlir::Type type);
+  // Extend a scalar or vector of 16-bit floats to f32, other values are
+  // returned unchanged.
+  mlir::Value extendToComputeType(mlir::Value val) const;
+  // Truncate a scalar or vector computed in f32 back to the 16-bit float
+  // 'storageElementType', other values are returned unchanged.
+  mlir::Value truncateToStorageType(
+      mlir::Type storageElementType, mlir::Value val) const;
+
   // Add indexOffsets to the least significant indices. So if indices are (i, j,
   // k, l) and offsets are (K, L), the results will be (i, j, k+K, l+L).
   void addOffsetToLeastSignificant(mlir::ValueRange indices,
@@ -258,6 +271,7 @@ struct VectorBuilder final : DialectBuilder {
   mlir::Value broadcast(mlir::VectorType vecType, mlir::Value val) const;
   mlir::Value shuffle(mlir::Value lhs, mlir::Value rhs,
       llvm::SmallVectorImpl<int64_t> &mask) const;
+  // Multiply-add of float or integer vectors.
   mlir::Value fma(mlir::Value lhs, mlir::Value rhs, mlir::Value acc) const;
 
   // Composite functions.
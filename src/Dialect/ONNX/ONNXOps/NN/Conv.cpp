@@ -322,6 +322,25 @@ LogicalResult ONNXConvOpShapeHelper::computeShape() {
       poolOp.dilations(), /*hasFilter*/ true, /*ceil mode*/ false);
 }
 
+template <>
+LogicalResult ONNXConvIntegerOpShapeHelper::computeShape() {
+  ONNXConvIntegerOp poolOp = llvm::cast<ONNXConvIntegerOp>(op);
+  ONNXConvIntegerOpAdaptor operandAdaptor =
+      ONNXConvIntegerOpAdaptor(operands);
+  return customComputeShape(operandAdaptor.x(), operandAdaptor.w(),
+      poolOp.kernel_shape(), poolOp.auto_pad(), poolOp.pads(), poolOp.strides(),
+      poolOp.dilations(), /*hasFilter*/ true, /*ceil mode*/ false);
+}
+
+template <>
+LogicalResult ONNXQLinearConvOpShapeHelper::computeShape() {
+  ONNXQLinearConvOp poolOp = llvm::cast<ONNXQLinearConvOp>(op);
+  ONNXQLinearConvOpAdaptor operandAdaptor = ONNXQLinearConvOpAdaptor(operands);
+  return customComputeShape(operandAdaptor.x(), operandAdaptor.w(),
+      poolOp.kernel_shape(), poolOp.auto_pad(), poolOp.pads(), poolOp.strides(),
+      poolOp.dilations(), /*hasFilter*/ true, /*ceil mode*/ false);
+}
+
 } // namespace onnx_mlir
 
 //===----------------------------------------------------------------------===//
@@ -853,5 +872,7 @@ LogicalResult ONNXConvIntegerOp::inferShapes(
 namespace onnx_mlir {
 
 template struct ONNXGenericPoolOpShapeHelper<ONNXConvOp>;
+template struct ONNXGenericPoolOpShapeHelper<ONNXConvIntegerOp>;
+template struct ONNXGenericPoolOpShapeHelper<ONNXQLinearConvOp>;
 
 } // namespace onnx_mlir
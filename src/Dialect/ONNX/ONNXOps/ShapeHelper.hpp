@@ -269,7 +269,7 @@ struct ONNXShapeOpShapeHelper : public ONNXOpShapeHelper {
 };
 
 //===----------------------------------------------------------------------===//
-// Pooling Ops (ONNXMaxPoolSingleOutOp, ONNXAveragePoolOp, ONNXConvOp)
+// Pooling Ops (ONNXMaxPoolSingleOutOp, ONNXAveragePoolOp, ONNXConvOp, ...)
 //===----------------------------------------------------------------------===//
 
 // Generic pool shape helper.
@@ -302,8 +302,12 @@ struct ONNXGenericPoolOpShapeHelper : public ONNXOpShapeHelper {
 using ONNXAveragePoolOpShapeHelper =
     ONNXGenericPoolOpShapeHelper<mlir::ONNXAveragePoolOp>;
 using ONNXConvOpShapeHelper = ONNXGenericPoolOpShapeHelper<mlir::ONNXConvOp>;
+using ONNXConvIntegerOpShapeHelper =
+    ONNXGenericPoolOpShapeHelper<mlir::ONNXConvIntegerOp>;
 using ONNXMaxPoolSingleOutOpShapeHelper =
     ONNXGenericPoolOpShapeHelper<mlir::ONNXMaxPoolSingleOutOp>;
+using ONNXQLinearConvOpShapeHelper =
+    ONNXGenericPoolOpShapeHelper<mlir::ONNXQLinearConvOp>;
 
 //===----------------------------------------------------------------------===//
 // Slice Op
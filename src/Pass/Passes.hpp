@@ -24,8 +24,9 @@ namespace onnx_mlir {
 
 /// Pass for ONNX graph level optimization
 std::unique_ptr<mlir::Pass> createONNXOpTransformPass();
-std::unique_ptr<mlir::Pass> createONNXOpTransformPass(
-    int threshold, bool report, bool targetCPU, bool enableSimdDataLayoutOpt);
+std::unique_ptr<mlir::Pass> createONNXOpTransformPass(int threshold,
+    bool report, bool targetCPU, bool enableSimdDataLayoutOpt,
+    int constPropExpansionBound = -1);
 
 /// Pass for rewriting inside frontend dialect.
 std::unique_ptr<mlir::Pass> createDecomposeONNXToONNXPass(
@@ -34,10 +35,21 @@ std::unique_ptr<mlir::Pass> createDecomposeONNXToONNXPass(
 std::unique_ptr<mlir::Pass> createConvOptONNXToONNXPass(
     bool enableSimdDataLayoutOpt = false);
 
+/// Pass for fusing the QDQ islands of quantized models into integer ops, and
+/// reporting the islands left unfused in the given format (TXT or JSON).
+std::unique_ptr<mlir::Pass> createQDQFusionONNXToONNXPass(
+    const std::string &reportFormat = "");
+
+/// Pass for computing the f32 ops selected by 'ops' in bf16, with the syntax
+/// of --precision-ops.
+std::unique_ptr<mlir::Pass> createMixedPrecisionONNXToONNXPass(
+    const std::string &ops = "");
+
 std::unique_ptr<mlir::Pass> createShapeInferencePass(
     bool analyzeAllFunctions = false);
 
-std::unique_ptr<mlir::Pass> createConstPropONNXToONNXPass();
+std::unique_ptr<mlir::Pass> createConstPropONNXToONNXPass(
+    int expansionBound = -1);
 
 /// Pass for instrument the ops in specific stage.
 std::unique_ptr<mlir::Pass> createInstrumentPass();
@@ -57,10 +69,15 @@ std::unique_ptr<mlir::Pass> createONNXDimAnalysisPass();
 /// Pass for verifying Onnx ops before lowering to Krnl
 std::unique_ptr<mlir::Pass> createONNXPreKrnlVerifyPass();
 
+/// Pass for reporting the FLOPs, bytes moved and arithmetic intensity of ONNX
+/// ops as JSON.
+std::unique_ptr<mlir::Pass> createONNXCostModelPass();
+
 /// Add pass for lowering to Krnl IR.
 std::unique_ptr<mlir::Pass> createLowerToKrnlPass();
-std::unique_ptr<mlir::Pass> createLowerToKrnlPass(
-    int optLevel, bool enableParallel);
+std::unique_ptr<mlir::Pass> createLowerToKrnlPass(int optLevel,
+    bool enableParallel, const std::string &tilingDatabase = "",
+    const std::string &mcpu = "");
 std::unique_ptr<mlir::Pass> createLowerToKrnlPass(
     bool emitDealloc, bool enableTiling, bool enableParallel);
 
@@ -100,7 +117,7 @@ std::unique_ptr<mlir::Pass> createLowerKrnlRegionPass();
 /// Pass for lowering Krnl dialect to LLVM dialect.
 std::unique_ptr<mlir::Pass> createConvertKrnlToLLVMPass();
 std::unique_ptr<mlir::Pass> createConvertKrnlToLLVMPass(
-    bool verifyInputTensors);
+    bool verifyInputTensors, bool instrumentAllocations = false);
 
 } // namespace krnl
 
@@ -14,13 +14,28 @@
 //===----------------------------------------------------------------------===//
 
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Path.h"
 
@@ -32,14 +47,23 @@ const std::string ExecutionSession::_queryEntryPointsName =
     "omQueryEntryPoints";
 const std::string ExecutionSession::_inputSignatureName = "omInputSignature";
 const std::string ExecutionSession::_outputSignatureName = "omOutputSignature";
+const std::string ExecutionSession::_instrumentReportName =
+    "omInstrumentReport";
+const std::string ExecutionSession::_instrumentResetName = "omInstrumentReset";
 
-ExecutionSession::ExecutionSession(
-    std::string sharedLibPath, bool defaultEntryPoint) {
+ExecutionSession::ExecutionSession(std::string sharedLibPath,
+    bool defaultEntryPoint, bool prefault, bool shareWeights) {
 
   _sharedLibraryHandle =
       llvm::sys::DynamicLibrary::getLibrary(sharedLibPath.c_str());
   if (!_sharedLibraryHandle.isValid())
     throw std::runtime_error(reportLibraryOpeningError(sharedLibPath));
+  _modelName = llvm::sys::path::stem(sharedLibPath).str();
+
+  // The library may be replaced, so this is done before looking up any
+  // symbol.
+  if (shareWeights)
+    shareWeightsWithOtherSessions(sharedLibPath);
 
   if (defaultEntryPoint)
     setEntryPoint("run_main_graph");
@@ -58,6 +82,15 @@ ExecutionSession::ExecutionSession(
       _sharedLibraryHandle.getAddressOfSymbol(_outputSignatureName.c_str()));
   if (!_outputSignatureFunc)
     throw std::runtime_error(reportSymbolLoadingError(_outputSignatureName));
+
+  // The instrumentation runtime is only linked into instrumented models.
+  _instrumentReportFunc = reinterpret_cast<instrumentReportFuncType>(
+      _sharedLibraryHandle.getAddressOfSymbol(_instrumentReportName.c_str()));
+  _instrumentResetFunc = reinterpret_cast<instrumentResetFuncType>(
+      _sharedLibraryHandle.getAddressOfSymbol(_instrumentResetName.c_str()));
+
+  if (prefault)
+    prefaultConstants();
   errno = 0; // No errors.
 }
 
@@ -85,7 +118,7 @@ std::vector<OMTensorUniquePtr> ExecutionSession::run(
     omts.emplace_back(inOmt.get());
   auto *wrappedInput = omTensorListCreate(&omts[0], (int64_t)omts.size());
 
-  auto *wrappedOutput = _entryPointFunc(wrappedInput);
+  auto *wrappedOutput = runEntryPoint(wrappedInput);
 
   // We created a wrapper for the input list, but the input list does not really
   // own the tensor in the list, as they are coming as OMTensorUniquePtr. So we
@@ -121,7 +154,7 @@ OMTensorList *ExecutionSession::run(OMTensorList *input) {
     errno = EINVAL;
     throw std::runtime_error(errStr.str());
   }
-  OMTensorList *output = _entryPointFunc(input);
+  OMTensorList *output = runEntryPoint(input);
   if (!output) {
     std::stringstream errStr;
     std::string errMessageStr = std::string(strerror(errno));
@@ -147,7 +180,390 @@ const std::string ExecutionSession::outputSignature() const {
   return _outputSignatureFunc(_entryPointName.c_str());
 }
 
+OMTensorList *ExecutionSession::createSyntheticInputs() const {
+  std::string signature = inputSignature();
+  auto unsupported = [&]() {
+    errno = EINVAL; // Invalid argument.
+    return std::runtime_error(
+        "Cannot create warmup inputs for signature: " + signature);
+  };
+  llvm::Expected<llvm::json::Value> json = llvm::json::parse(signature);
+  if (!json) {
+    llvm::consumeError(json.takeError());
+    throw unsupported();
+  }
+  llvm::json::Array *inputs = json->getAsArray();
+  if (!inputs)
+    throw unsupported();
+
+  std::vector<OMTensor *> omts;
+  auto cleanup = [&]() {
+    for (OMTensor *omt : omts)
+      omTensorDestroy(omt);
+  };
+  auto outOfMemory = [&]() {
+    cleanup();
+    errno = ENOMEM;
+    return std::runtime_error("Cannot allocate the warmup inputs.");
+  };
+  for (llvm::json::Value &input : *inputs) {
+    llvm::json::Object *object = input.getAsObject();
+    llvm::Optional<llvm::StringRef> type =
+        object ? object->getString("type") : llvm::None;
+    llvm::json::Array *dims = object ? object->getArray("dims") : nullptr;
+    OM_DATA_TYPE dataType = type ? llvm::StringSwitch<OM_DATA_TYPE>(*type)
+                                       .Case("f32", ONNX_TYPE_FLOAT)
+                                       .Case("f64", ONNX_TYPE_DOUBLE)
+                                       .Case("i1", ONNX_TYPE_BOOL)
+                                       .Case("i8", ONNX_TYPE_INT8)
+                                       .Case("i16", ONNX_TYPE_INT16)
+                                       .Case("i32", ONNX_TYPE_INT32)
+                                       .Case("i64", ONNX_TYPE_INT64)
+                                       .Case("ui8", ONNX_TYPE_UINT8)
+                                       .Case("ui16", ONNX_TYPE_UINT16)
+                                       .Case("ui32", ONNX_TYPE_UINT32)
+                                       .Case("ui64", ONNX_TYPE_UINT64)
+                                       .Default(ONNX_TYPE_UNDEFINED)
+                                 : ONNX_TYPE_UNDEFINED;
+    if (dataType == ONNX_TYPE_UNDEFINED || !dims) {
+      cleanup();
+      throw unsupported();
+    }
+    std::vector<int64_t> shape;
+    for (llvm::json::Value &dim : *dims) {
+      llvm::Optional<int64_t> size = dim.getAsInteger();
+      // Dimensions only known at runtime are -1.
+      shape.emplace_back(size && *size >= 0 ? *size : 1);
+    }
+    int64_t numElems = 1;
+    for (int64_t size : shape)
+      numElems *= size;
+    void *data = calloc(numElems ? numElems : 1, getDataTypeSize(dataType));
+    if (!data)
+      throw outOfMemory();
+    OMTensor *omt = omTensorCreateWithOwnership(
+        data, shape.data(), (int64_t)shape.size(), dataType, /*owning=*/1);
+    if (!omt) {
+      free(data);
+      throw outOfMemory();
+    }
+    omts.emplace_back(omt);
+  }
+  OMTensor **omtArray = (OMTensor **)malloc(
+      (omts.empty() ? 1 : omts.size()) * sizeof(OMTensor *));
+  if (!omtArray)
+    throw outOfMemory();
+  std::copy(omts.begin(), omts.end(), omtArray);
+  OMTensorList *list = omTensorListCreateWithOwnership(
+      omtArray, (int64_t)omts.size(), /*owning=*/1);
+  if (!list) {
+    free(omtArray);
+    throw outOfMemory();
+  }
+  return list;
+}
+
+void ExecutionSession::warmup(int64_t iterations) {
+  if (!_entryPointFunc)
+    throw std::runtime_error(reportUndefinedEntryPointIn("warmup"));
+  OMTensorList *input = createSyntheticInputs();
+  for (int64_t i = 0; i < iterations; ++i) {
+    // Call the entry point directly, to keep warmups out of the statistics.
+    OMTensorList *output = _entryPointFunc(input);
+    if (!output) {
+      std::string error = reportErrnoError();
+      int savedErrno = errno;
+      omTensorListDestroy(input);
+      errno = savedErrno;
+      throw std::runtime_error(error);
+    }
+    omTensorListDestroy(output);
+  }
+  omTensorListDestroy(input);
+  errno = 0; // No errors.
+}
+
+#if defined(__linux__)
+namespace {
+struct PrefaultState {
+  const char *fileName;
+  int64_t bytes;
+};
+
+// Advise and touch the pages of the read-only loadable segments, i.e. code
+// and constants, of the library named state->fileName.
+int prefaultLibrarySegments(struct dl_phdr_info *info, size_t, void *data) {
+  auto *state = static_cast<PrefaultState *>(data);
+  if (!info->dlpi_name || strcmp(info->dlpi_name, state->fileName) != 0)
+    return 0;
+  uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+  for (int i = 0; i < info->dlpi_phnum; ++i) {
+    const ElfW(Phdr) &phdr = info->dlpi_phdr[i];
+    if (phdr.p_type != PT_LOAD || (phdr.p_flags & PF_W))
+      continue;
+    uintptr_t begin = (info->dlpi_addr + phdr.p_vaddr) & ~(pageSize - 1);
+    uintptr_t end = info->dlpi_addr + phdr.p_vaddr + phdr.p_memsz;
+    // Start reading ahead the whole segment, then fault in each page.
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_WILLNEED);
+    for (uintptr_t page = begin; page < end; page += pageSize)
+      (void)*reinterpret_cast<volatile const char *>(page);
+    state->bytes += end - begin;
+  }
+  return 1; // Found, stop iterating.
+}
+} // namespace
+#endif
+
+int64_t ExecutionSession::prefaultConstants() {
+  errno = 0; // No errors.
+#if defined(__linux__)
+  // Find the library file through a symbol it defines.
+  Dl_info dlInfo;
+  if (!dladdr(reinterpret_cast<void *>(_inputSignatureFunc), &dlInfo) ||
+      !dlInfo.dli_fname)
+    return 0;
+  PrefaultState state = {dlInfo.dli_fname, 0};
+  dl_iterate_phdr(prefaultLibrarySegments, &state);
+  return state.bytes;
+#else
+  return 0;
+#endif
+}
+
+#if defined(__linux__)
+namespace {
+// Library loaded by the sessions of the process from a file.
+struct SharedWeights {
+  // Address of omQueryEntryPoints, which identifies the loaded library.
+  const void *queryEntryPoints;
+  uint64_t fileSize;
+  // Entry points of the library and their signatures.
+  std::string entryPoints;
+  int64_t sessions;
+};
+
+// Both are never destroyed, so that sessions in static storage can still
+// unregister at exit. The registry is keyed by the absolute path of the file
+// each library was loaded from.
+std::mutex &sharedWeightsMutex() {
+  static std::mutex *mutex = new std::mutex();
+  return *mutex;
+}
+std::map<std::string, SharedWeights> &sharedWeightsRegistry() {
+  static auto *registry = new std::map<std::string, SharedWeights>();
+  return *registry;
+}
+
+// Describe the entry points of a library and their input and output
+// signatures, or return an empty string if the library does not define them.
+std::string describeEntryPoints(llvm::sys::DynamicLibrary &library) {
+  auto queryEntryPoints = reinterpret_cast<queryEntryPointsFuncType>(
+      library.getAddressOfSymbol("omQueryEntryPoints"));
+  auto inputSignature = reinterpret_cast<signatureFuncType>(
+      library.getAddressOfSymbol("omInputSignature"));
+  auto outputSignature = reinterpret_cast<signatureFuncType>(
+      library.getAddressOfSymbol("omOutputSignature"));
+  if (!queryEntryPoints || !inputSignature || !outputSignature)
+    return "";
+  int64_t numEntryPoints = 0;
+  const char **entryPoints = queryEntryPoints(&numEntryPoints);
+  std::string description;
+  for (int64_t i = 0; i < numEntryPoints; ++i) {
+    const char *input = inputSignature(entryPoints[i]);
+    const char *output = outputSignature(entryPoints[i]);
+    description.append(entryPoints[i]).append(1, '\0');
+    description.append(input ? input : "").append(1, '\0');
+    description.append(output ? output : "").append(1, '\0');
+  }
+  return description;
+}
+
+// Compare the content of a library file with the one of a copy of it. The copy
+// is read once and its pages are then dropped from the page cache, as the
+// library loaded from the other file is used instead.
+bool haveSameContent(const char *fileName, const char *copyFileName) {
+  int fd = open(fileName, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  int copyFd = open(copyFileName, O_RDONLY | O_CLOEXEC);
+  if (copyFd < 0) {
+    close(fd);
+    return false;
+  }
+  constexpr size_t blockSize = 1 << 20;
+  std::vector<char> block(blockSize), copyBlock(blockSize);
+  bool same = true;
+  for (off_t offset = 0; same; offset += blockSize) {
+    ssize_t size = pread(fd, block.data(), blockSize, offset);
+    ssize_t copySize = pread(copyFd, copyBlock.data(), blockSize, offset);
+    same = size >= 0 && size == copySize &&
+           memcmp(block.data(), copyBlock.data(), size) == 0;
+    if (size == 0)
+      break;
+  }
+  posix_fadvise(copyFd, 0, 0, POSIX_FADV_DONTNEED);
+  close(copyFd);
+  close(fd);
+  return same;
+}
+} // namespace
+#endif
+
+void ExecutionSession::shareWeightsWithOtherSessions(
+    const std::string &sharedLibPath) {
+#if defined(__linux__)
+  const void *queryEntryPoints =
+      _sharedLibraryHandle.getAddressOfSymbol(_queryEntryPointsName.c_str());
+  uint64_t fileSize;
+  llvm::SmallString<256> absolutePath(sharedLibPath);
+  if (!queryEntryPoints ||
+      llvm::sys::fs::file_size(sharedLibPath, fileSize) ||
+      llvm::sys::fs::make_absolute(absolutePath))
+    return;
+  std::string entryPoints = describeEntryPoints(_sharedLibraryHandle);
+
+  std::lock_guard<std::mutex> lock(sharedWeightsMutex());
+  auto &registry = sharedWeightsRegistry();
+  // The dynamic loader already shares a library loaded twice from the same
+  // file, possibly through another path.
+  for (auto &entry : registry) {
+    if (entry.second.queryEntryPoints != queryEntryPoints)
+      continue;
+    entry.second.sessions++;
+    _sharedWeightsKey = entry.first;
+    return;
+  }
+  // A library loaded from another file, e.g. a copy, is replaced by the
+  // registered one if both files have the same content. Libraries that differ
+  // in any byte, e.g. compiled for another batch size, are not shared, as
+  // their constants are part of their own read-only segment.
+  for (auto &entry : registry) {
+    const std::string &path = entry.first;
+    SharedWeights &shared = entry.second;
+    if (shared.fileSize != fileSize || shared.entryPoints != entryPoints ||
+        !haveSameContent(path.c_str(), absolutePath.c_str()))
+      continue;
+    llvm::sys::DynamicLibrary sharedLibraryHandle =
+        llvm::sys::DynamicLibrary::getLibrary(path.c_str());
+    if (!sharedLibraryHandle.isValid())
+      return;
+    // The file at the registered path may have been replaced since it was
+    // loaded, in which case another library was just loaded.
+    if (sharedLibraryHandle.getAddressOfSymbol(
+            _queryEntryPointsName.c_str()) != shared.queryEntryPoints) {
+      llvm::sys::DynamicLibrary::closeLibrary(sharedLibraryHandle);
+      return;
+    }
+    // The pages of the constants of the copy were never touched, so closing
+    // it releases its mapping without having loaded them.
+    llvm::sys::DynamicLibrary::closeLibrary(_sharedLibraryHandle);
+    _sharedLibraryHandle = sharedLibraryHandle;
+    _sharesWeights = true;
+    shared.sessions++;
+    _sharedWeightsKey = path;
+    return;
+  }
+  // A file replaced while the library loaded from it is still in use keeps
+  // the registration of that library.
+  std::string key = absolutePath.str().str();
+  SharedWeights shared = {queryEntryPoints, fileSize, entryPoints,
+      /*sessions=*/1};
+  if (registry.emplace(key, shared).second)
+    _sharedWeightsKey = key;
+#endif
+}
+
+std::string ExecutionSession::instrumentReport() const {
+  errno = 0; // No errors.
+  char *report = _instrumentReportFunc ? _instrumentReportFunc() : nullptr;
+  if (!report)
+    return "";
+  std::string reportStr(report);
+  free(report);
+  return reportStr;
+}
+
+void ExecutionSession::resetInstrumentReport() {
+  if (_instrumentResetFunc)
+    _instrumentResetFunc();
+  errno = 0; // No errors.
+}
+
+OMTensorList *ExecutionSession::runEntryPoint(OMTensorList *input) {
+  if (!_runStats)
+    return _entryPointFunc(input);
+  uint64_t start = omRunStatsGetTimeNs();
+  OMTensorList *output = _entryPointFunc(input);
+  uint64_t latency = omRunStatsGetTimeNs() - start;
+  // Keep the errno of a failed inference for the caller.
+  int savedErrno = errno;
+  omRunStatsRecord(
+      _runStats, _entryPointName.c_str(), latency, /*failed=*/!output);
+  errno = savedErrno;
+  return output;
+}
+
+void ExecutionSession::enableRunStats() {
+  if (!_runStats)
+    _runStats = omRunStatsCreate(_modelName.c_str());
+  if (!_runStats) {
+    errno = ENOMEM;
+    throw std::runtime_error("Cannot allocate the run statistics.");
+  }
+  errno = 0; // No errors.
+}
+
+int64_t ExecutionSession::runCalls(const std::string &entryPointName) const {
+  errno = 0; // No errors.
+  return _runStats ? omRunStatsGetCalls(_runStats, entryPointName.c_str()) : 0;
+}
+
+int64_t ExecutionSession::runErrors(const std::string &entryPointName) const {
+  errno = 0; // No errors.
+  return _runStats ? omRunStatsGetErrors(_runStats, entryPointName.c_str())
+                   : 0;
+}
+
+double ExecutionSession::runLatencyNs(
+    const std::string &entryPointName, double quantile) const {
+  errno = 0; // No errors.
+  if (!_runStats)
+    return -1;
+  return omRunStatsGetLatencyNs(_runStats, entryPointName.c_str(), quantile);
+}
+
+std::string ExecutionSession::runStatsPrometheus() const {
+  errno = 0; // No errors.
+  char *text = _runStats ? omRunStatsToPrometheus(_runStats) : nullptr;
+  if (!text)
+    return "";
+  std::string textStr(text);
+  free(text);
+  return textStr;
+}
+
+bool ExecutionSession::writeRunStats(const std::string &path) const {
+  errno = 0; // No errors.
+  return _runStats && omRunStatsWritePrometheus(_runStats, path.c_str()) == 0;
+}
+
+void ExecutionSession::resetRunStats() {
+  if (_runStats)
+    omRunStatsReset(_runStats);
+  errno = 0; // No errors.
+}
+
 ExecutionSession::~ExecutionSession() {
+  omRunStatsDestroy(_runStats);
+#if defined(__linux__)
+  if (!_sharedWeightsKey.empty()) {
+    std::lock_guard<std::mutex> lock(sharedWeightsMutex());
+    auto &registry = sharedWeightsRegistry();
+    auto found = registry.find(_sharedWeightsKey);
+    if (found != registry.end() && --found->second.sessions == 0)
+      registry.erase(found);
+  }
+#endif
   if (_sharedLibraryHandle.isValid())
     llvm::sys::DynamicLibrary::closeLibrary(_sharedLibraryHandle);
 }
@@ -27,6 +27,8 @@ namespace onnx_mlir {
 using entryPointFuncType = OMTensorList *(*)(OMTensorList *);
 using queryEntryPointsFuncType = const char **(*)(int64_t *);
 using signatureFuncType = const char *(*)(const char *);
+using instrumentReportFuncType = char *(*)();
+using instrumentResetFuncType = void (*)();
 using OMTensorUniquePtr = std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>;
 
 /* ExecutionSession
@@ -46,7 +48,14 @@ class ExecutionSession {
 public:
   // Create an execution session using the model given in sharedLibPath.
   // This path must point to the actual file, local directory is not searched.
-  ExecutionSession(std::string sharedLibPath, bool defaultEntryPoint = true);
+  // If prefaultConstants is true, the pages of the model code and constants
+  // are loaded into memory right away, see prefaultConstants().
+  // If shareWeights is true and another session of the process already loaded
+  // a byte-identical library from a different file, e.g. a copy of the model
+  // for each tenant, this session uses that library instead of mapping the
+  // constants of its own file a second time, see sharesWeights().
+  ExecutionSession(std::string sharedLibPath, bool defaultEntryPoint = true,
+      bool prefaultConstants = false, bool shareWeights = true);
 
   // Get a NULL-terminated array of entry point names.
   // For example {"run_addition, "run_subtraction", NULL}
@@ -75,9 +84,65 @@ public:
   const std::string inputSignature() const;
   const std::string outputSignature() const;
 
+  // Run the entry point iterations times on synthetic inputs derived from
+  // its input signature: zeros, with 1 for the dimensions only known at
+  // runtime. The first inferences of a model are slower, since they fault in
+  // the pages of its constants, initialize its runtime, and run on cold
+  // caches, so warming up before serving avoids latency spikes. Warmup
+  // inferences are not counted in the run statistics.
+  void warmup(int64_t iterations = 1);
+
+  // Ask the OS to load the read-only pages of the model library, which hold
+  // its code and constants, and touch them so that they are resident before
+  // the first inference. Return the number of bytes prefaulted, 0 on systems
+  // other than Linux.
+  int64_t prefaultConstants();
+
+  // Whether this session uses the library of another session, loaded from a
+  // different file with the same content. Libraries that differ in any byte,
+  // e.g. models with the same constants compiled for another batch size, are
+  // not shared (Linux only).
+  bool sharesWeights() const { return _sharesWeights; }
+
+  // Get the profile report of the instrumented ops of the model, which are
+  // aggregated when env variable OMINSTRUMENTPROFILE is set. Empty if the
+  // model is not instrumented or profiling is disabled.
+  std::string instrumentReport() const;
+  // Clear the profile of the instrumented ops of the model.
+  void resetInstrumentReport();
+
+  // Count the inferences of this session and their latency, per entry point.
+  // Statistics are off by default, and recording takes a few atomic additions.
+  void enableRunStats();
+  bool runStatsEnabled() const { return _runStats != nullptr; }
+  // Number of inferences, including failed ones, and of failed inferences of
+  // an entry point.
+  int64_t runCalls(const std::string &entryPointName) const;
+  int64_t runErrors(const std::string &entryPointName) const;
+  // Latency quantile (e.g. 0.99) of the successful inferences of an entry
+  // point, in nanoseconds, or -1 if there is none.
+  double runLatencyNs(const std::string &entryPointName, double quantile) const;
+  // Get the statistics in the Prometheus text format, or write them to a file
+  // for a textfile collector. Empty, or false, if statistics are off.
+  std::string runStatsPrometheus() const;
+  bool writeRunStats(const std::string &path) const;
+  // Clear the statistics.
+  void resetRunStats();
+
   ~ExecutionSession();
 
 protected:
+  // Call the entry point, and record the inference if statistics are on.
+  OMTensorList *runEntryPoint(OMTensorList *input);
+
+  // Create inputs of the current entry point from its input signature, for
+  // warmup. Throw if the signature has types that cannot be synthesized.
+  OMTensorList *createSyntheticInputs() const;
+
+  // Replace the library of this session by the one of an earlier session
+  // loaded from an identical file, and register the session.
+  void shareWeightsWithOtherSessions(const std::string &sharedLibPath);
+
   // Error reporting processing when throwing runtime errors. Set errno as
   // appropriate.
   std::string reportLibraryOpeningError(const std::string &libraryName) const;
@@ -103,5 +168,20 @@ protected:
   static const std::string _outputSignatureName;
   signatureFuncType _inputSignatureFunc = nullptr;
   signatureFuncType _outputSignatureFunc = nullptr;
+
+  // Optional profile report of the instrumented ops.
+  static const std::string _instrumentReportName;
+  static const std::string _instrumentResetName;
+  instrumentReportFuncType _instrumentReportFunc = nullptr;
+  instrumentResetFuncType _instrumentResetFunc = nullptr;
+
+  // File of the library this session is registered as a user of, if any,
+  // and whether that library was loaded by another session.
+  std::string _sharedWeightsKey;
+  bool _sharesWeights = false;
+
+  // Optional statistics of the inferences, labelled by the model name.
+  std::string _modelName;
+  OMRunStats *_runStats = nullptr;
 };
 } // namespace onnx_mlir
@@ -23,9 +23,145 @@ SUPPRESS_WARNINGS_POP
 
 namespace onnx_mlir {
 
-PyExecutionSession::PyExecutionSession(
-    std::string sharedLibPath, bool defaultEntryPoint)
-    : onnx_mlir::ExecutionSession(sharedLibPath, defaultEntryPoint) {}
+PyExecutionSession::PyExecutionSession(std::string sharedLibPath,
+    bool defaultEntryPoint, bool prefaultConstants, bool shareWeights)
+    : onnx_mlir::ExecutionSession(
+          sharedLibPath, defaultEntryPoint, prefaultConstants, shareWeights) {}
+
+PyExecutionSession::~PyExecutionSession() {
+  stopAsyncWorkers();
+  pyResetPrepared();
+}
+
+// Numpy types are matched on their kind and size, rather than by trying each
+// C++ type with py::isinstance, which is equivalent and takes one lookup.
+// Since the data is given to the model without conversion, arrays whose bytes
+// are not in the native order are rejected.
+OM_DATA_TYPE PyExecutionSession::pyArrayDataType(const py::array &pyArray) {
+  static const uint16_t one = 1;
+  static const char nativeOrder =
+      *reinterpret_cast<const uint8_t *>(&one) == 1 ? '<' : '>';
+  std::string byteOrder = pyArray.dtype().attr("byteorder").cast<std::string>();
+  if (byteOrder != "=" && byteOrder != "|" &&
+      byteOrder != std::string(1, nativeOrder))
+    throw std::invalid_argument(
+        "Numpy array with non-native byte order not supported: " +
+        py::str(pyArray.dtype()).cast<std::string>() +
+        ", convert it with astype(dtype.newbyteorder('='))");
+  ssize_t size = pyArray.itemsize();
+  switch (pyArray.dtype().kind()) {
+  case 'f':
+    // Numpy float16 has no C++ counterpart.
+    return size == 2   ? ONNX_TYPE_FLOAT16
+           : size == 4 ? ONNX_TYPE_FLOAT
+           : size == 8 ? ONNX_TYPE_DOUBLE
+                       : ONNX_TYPE_UNDEFINED;
+  case 'i':
+    return size == 1   ? ONNX_TYPE_INT8
+           : size == 2 ? ONNX_TYPE_INT16
+           : size == 4 ? ONNX_TYPE_INT32
+           : size == 8 ? ONNX_TYPE_INT64
+                       : ONNX_TYPE_UNDEFINED;
+  case 'u':
+    return size == 1   ? ONNX_TYPE_UINT8
+           : size == 2 ? ONNX_TYPE_UINT16
+           : size == 4 ? ONNX_TYPE_UINT32
+           : size == 8 ? ONNX_TYPE_UINT64
+                       : ONNX_TYPE_UNDEFINED;
+  case 'b':
+    return size == 1 ? ONNX_TYPE_BOOL : ONNX_TYPE_UNDEFINED;
+  case 'c':
+    return size == 8    ? ONNX_TYPE_COMPLEX64
+           : size == 16 ? ONNX_TYPE_COMPLEX128
+                        : ONNX_TYPE_UNDEFINED;
+  // string type missing
+  // Missing bfloat16 support
+  default:
+    return ONNX_TYPE_UNDEFINED;
+  }
+}
+
+// https://numpy.org/devdocs/user/basics.types.html
+py::dtype PyExecutionSession::omTensorPyDtype(const OMTensor *omt) {
+  switch (omTensorGetDataType(omt)) {
+  case (OM_DATA_TYPE)onnx::TensorProto::FLOAT:
+    return py::dtype("float32");
+  case (OM_DATA_TYPE)onnx::TensorProto::UINT8:
+    return py::dtype("uint8");
+  case (OM_DATA_TYPE)onnx::TensorProto::INT8:
+    return py::dtype("int8");
+  case (OM_DATA_TYPE)onnx::TensorProto::UINT16:
+    return py::dtype("uint16");
+  case (OM_DATA_TYPE)onnx::TensorProto::INT16:
+    return py::dtype("int16");
+  case (OM_DATA_TYPE)onnx::TensorProto::INT32:
+    return py::dtype("int32");
+  case (OM_DATA_TYPE)onnx::TensorProto::INT64:
+    return py::dtype("int64");
+  case (OM_DATA_TYPE)onnx::TensorProto::STRING:
+    return py::dtype("str");
+  case (OM_DATA_TYPE)onnx::TensorProto::BOOL:
+    return py::dtype("bool_");
+  case (OM_DATA_TYPE)onnx::TensorProto::FLOAT16:
+    return py::dtype("float16");
+  case (OM_DATA_TYPE)onnx::TensorProto::DOUBLE:
+    return py::dtype("float64");
+  case (OM_DATA_TYPE)onnx::TensorProto::UINT32:
+    return py::dtype("uint32");
+  case (OM_DATA_TYPE)onnx::TensorProto::UINT64:
+    return py::dtype("uint64");
+  case (OM_DATA_TYPE)onnx::TensorProto::COMPLEX64:
+    return py::dtype("csingle");
+  case (OM_DATA_TYPE)onnx::TensorProto::COMPLEX128:
+    return py::dtype("cdouble");
+  default:
+    std::cerr << "Unsupported ONNX type in OMTensor: "
+              << omTensorGetDataType(omt) << ".\n";
+    exit(1);
+  }
+}
+
+// Return the data of an input array, and whether it is a copy that the
+// OMTensor must own.
+static void *pyArrayDataPtr(const py::array &pyArray, int64_t &ownData) {
+  if (pyArray.writeable()) {
+    ownData = 0;
+    return const_cast<void *>(pyArray.data());
+  }
+  // If data is not writable, copy them to a writable buffer.
+  void *copiedData = malloc(pyArray.nbytes());
+  memcpy(copiedData, pyArray.data(), pyArray.nbytes());
+  // We want OMTensor to free up the memory space upon destruction.
+  ownData = 1;
+  return copiedData;
+}
+
+OMTensor *PyExecutionSession::pyArrayToOMTensor(
+    const py::array &pyArray, OM_DATA_TYPE dtype) {
+  assert(pyArray.flags() && py::array::c_style &&
+         "Expect contiguous python array.");
+  int64_t ownData;
+  void *dataPtr = pyArrayDataPtr(pyArray, ownData);
+  auto *omt = omTensorCreateWithOwnership(dataPtr,
+      (int64_t *)(const_cast<ssize_t *>(pyArray.shape())),
+      (int64_t)pyArray.ndim(), dtype, ownData);
+  omTensorSetStridesWithPyArrayStrides(
+      omt, (int64_t *)const_cast<ssize_t *>(pyArray.strides()));
+  return omt;
+}
+
+std::vector<py::array> PyExecutionSession::omTensorListToPyArrays(
+    OMTensorList *omtl) {
+  std::vector<py::array> outputPyArrays;
+  for (int64_t i = 0; i < omTensorListGetSize(omtl); i++) {
+    auto *omt = omTensorListGetOmtByIndex(omtl, i);
+    auto shape = std::vector<int64_t>(
+        omTensorGetShape(omt), omTensorGetShape(omt) + omTensorGetRank(omt));
+    outputPyArrays.emplace_back(
+        py::array(omTensorPyDtype(omt), shape, omTensorGetDataPtr(omt)));
+  }
+  return outputPyArrays;
+}
 
 std::vector<py::array> PyExecutionSession::pyRun(
     const std::vector<py::array> &inputsPyArray) {
@@ -33,143 +169,272 @@ std::vector<py::array> PyExecutionSession::pyRun(
 
   std::vector<OMTensor *> omts;
   for (auto inputPyArray : inputsPyArray) {
-    assert(inputPyArray.flags() && py::array::c_style &&
-           "Expect contiguous python array.");
-
-    void *dataPtr;
-    int64_t ownData = 0;
-    if (inputPyArray.writeable()) {
-      dataPtr = inputPyArray.mutable_data();
-    } else {
-      // If data is not writable, copy them to a writable buffer.
-      auto *copiedData = (float *)malloc(inputPyArray.nbytes());
-      memcpy(copiedData, inputPyArray.data(), inputPyArray.nbytes());
-      dataPtr = copiedData;
-      // We want OMTensor to free up the memory space upon destruction.
-      ownData = 1;
-    }
-
-    // Borrowed from:
-    // https://github.com/pybind/pybind11/issues/563#issuecomment-267835542
-    OM_DATA_TYPE dtype;
-    if (py::isinstance<py::array_t<float>>(inputPyArray))
-      dtype = ONNX_TYPE_FLOAT;
-    else if (py::isinstance<py::array_t<std::uint8_t>>(inputPyArray))
-      dtype = ONNX_TYPE_UINT8;
-    else if (py::isinstance<py::array_t<std::int8_t>>(inputPyArray))
-      dtype = ONNX_TYPE_INT8;
-    else if (py::isinstance<py::array_t<std::uint16_t>>(inputPyArray))
-      dtype = ONNX_TYPE_UINT16;
-    else if (py::isinstance<py::array_t<std::int16_t>>(inputPyArray))
-      dtype = ONNX_TYPE_INT16;
-    else if (py::isinstance<py::array_t<std::int32_t>>(inputPyArray))
-      dtype = ONNX_TYPE_INT32;
-    else if (py::isinstance<py::array_t<std::int64_t>>(inputPyArray))
-      dtype = ONNX_TYPE_INT64;
-    // string type missing
-    else if (py::isinstance<py::array_t<bool>>(inputPyArray))
-      dtype = ONNX_TYPE_BOOL;
-    // Missing fp16 support.
-    else if (py::isinstance<py::array_t<double>>(inputPyArray))
-      dtype = ONNX_TYPE_DOUBLE;
-    else if (py::isinstance<py::array_t<std::uint32_t>>(inputPyArray))
-      dtype = ONNX_TYPE_UINT32;
-    else if (py::isinstance<py::array_t<std::uint64_t>>(inputPyArray))
-      dtype = ONNX_TYPE_UINT64;
-    else if (py::isinstance<py::array_t<std::complex<float>>>(inputPyArray))
-      dtype = ONNX_TYPE_COMPLEX64;
-    else if (py::isinstance<py::array_t<std::complex<double>>>(inputPyArray))
-      dtype = ONNX_TYPE_COMPLEX128;
-    // Missing bfloat16 support
-    else {
+    OM_DATA_TYPE dtype = pyArrayDataType(inputPyArray);
+    if (dtype == ONNX_TYPE_UNDEFINED) {
       std::cerr << "Numpy type not supported: " << inputPyArray.dtype()
                 << ".\n";
       exit(1);
     }
-
-    auto *inputOMTensor = omTensorCreateWithOwnership(dataPtr,
-        (int64_t *)(const_cast<ssize_t *>(inputPyArray.shape())),
-        (int64_t)inputPyArray.ndim(), dtype, ownData);
-    omTensorSetStridesWithPyArrayStrides(inputOMTensor,
-        (int64_t *)const_cast<ssize_t *>(inputPyArray.strides()));
-
-    omts.emplace_back(inputOMTensor);
+    omts.emplace_back(pyArrayToOMTensor(inputPyArray, dtype));
   }
 
   auto *wrappedInput = omTensorListCreate(&omts[0], omts.size());
-  auto *wrappedOutput = _entryPointFunc(wrappedInput);
+  OMTensorList *wrappedOutput;
+  {
+    // Let other Python threads run during the inference, which only reads
+    // the input arrays, kept alive by inputsPyArray.
+    py::gil_scoped_release release;
+    wrappedOutput = runEntryPoint(wrappedInput);
+  }
   if (!wrappedOutput)
     throw std::runtime_error(reportErrnoError());
-  std::vector<py::array> outputPyArrays;
-  for (int64_t i = 0; i < omTensorListGetSize(wrappedOutput); i++) {
-    auto *omt = omTensorListGetOmtByIndex(wrappedOutput, i);
-    auto shape = std::vector<int64_t>(
-        omTensorGetShape(omt), omTensorGetShape(omt) + omTensorGetRank(omt));
+  std::vector<py::array> outputPyArrays = omTensorListToPyArrays(wrappedOutput);
+  omTensorListDestroy(wrappedOutput);
+  omTensorListDestroy(wrappedInput);
 
-    // https://numpy.org/devdocs/user/basics.types.html
-    py::dtype dtype;
-    switch (omTensorGetDataType(omt)) {
-    case (OM_DATA_TYPE)onnx::TensorProto::FLOAT:
-      dtype = py::dtype("float32");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::UINT8:
-      dtype = py::dtype("uint8");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::INT8:
-      dtype = py::dtype("int8");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::UINT16:
-      dtype = py::dtype("uint16");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::INT16:
-      dtype = py::dtype("int16");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::INT32:
-      dtype = py::dtype("int32");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::INT64:
-      dtype = py::dtype("int64");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::STRING:
-      dtype = py::dtype("str");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::BOOL:
-      dtype = py::dtype("bool_");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::FLOAT16:
-      dtype = py::dtype("float32");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::DOUBLE:
-      dtype = py::dtype("float64");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::UINT32:
-      dtype = py::dtype("uint32");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::UINT64:
-      dtype = py::dtype("uint64");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::COMPLEX64:
-      dtype = py::dtype("csingle");
-      break;
-    case (OM_DATA_TYPE)onnx::TensorProto::COMPLEX128:
-      dtype = py::dtype("cdouble");
-      break;
-    default:
-      std::cerr << "Unsupported ONNX type in OMTensor: "
-                << omTensorGetDataType(omt) << ".\n";
-      exit(1);
+  return outputPyArrays;
+}
+
+// State of an asynchronous inference. Its Python objects are only touched
+// with the GIL held.
+struct PyAsyncRun {
+  std::vector<py::array> inputs;
+  std::vector<OMTensor *> omts;
+  OMTensorList *input = nullptr;
+  py::object future;
+};
+
+py::object PyExecutionSession::pyRunAsync(
+    const std::vector<py::array> &inputsPyArray) {
+  assert(_entryPointFunc && "Entry point not loaded.");
+
+  // The inputs are converted in the calling thread, which holds the GIL.
+  auto run = std::make_shared<PyAsyncRun>();
+  for (auto inputPyArray : inputsPyArray) {
+    OM_DATA_TYPE dtype = pyArrayDataType(inputPyArray);
+    if (dtype == ONNX_TYPE_UNDEFINED) {
+      for (OMTensor *omt : run->omts)
+        omTensorDestroy(omt);
+      throw std::runtime_error("Numpy type not supported: " +
+                               std::string(py::str(inputPyArray.dtype())));
     }
+    run->omts.emplace_back(pyArrayToOMTensor(inputPyArray, dtype));
+  }
+  run->input = omTensorListCreate(run->omts.data(), run->omts.size());
+  run->inputs = inputsPyArray;
+  run->future = py::module::import("concurrent.futures").attr("Future")();
+  py::object future = run->future;
 
-    outputPyArrays.emplace_back(
-        py::array(dtype, shape, omTensorGetDataPtr(omt)));
+  submitAsync([this, run]() {
+    py::gil_scoped_acquire acquire;
+    OMTensorList *output = nullptr;
+    std::string error;
+    // The inference is skipped if the future was cancelled while queued.
+    if (run->future.attr("set_running_or_notify_cancel")().cast<bool>()) {
+      {
+        py::gil_scoped_release release;
+        output = runEntryPoint(run->input);
+        if (!output)
+          error = reportErrnoError();
+      }
+      try {
+        if (output)
+          run->future.attr("set_result")(omTensorListToPyArrays(output));
+        else
+          run->future.attr("set_exception")(
+              py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(error));
+      } catch (py::error_already_set &) {
+        // Errors of the done callbacks of the future are not ours to report.
+      }
+    }
+    omTensorListDestroy(output);
+    omTensorListDestroy(run->input);
+    run->inputs.clear();
+    run->future = py::object();
+  });
+  return future;
+}
+
+void PyExecutionSession::pySetAsyncWorkers(int64_t numWorkers) {
+  if (numWorkers < 1)
+    throw std::invalid_argument("Expect at least one asynchronous worker.");
+  // Running workers finish the queued inferences before being replaced.
+  stopAsyncWorkers();
+  _numAsyncWorkers = numWorkers;
+}
+
+void PyExecutionSession::submitAsync(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(_asyncMutex);
+    // Workers are started by the first asynchronous inference.
+    for (int64_t i = _asyncWorkers.size(); i < _numAsyncWorkers; i++)
+      _asyncWorkers.emplace_back([this]() { asyncWorkerLoop(); });
+    _asyncTasks.emplace_back(std::move(task));
+  }
+  _asyncCondition.notify_one();
+}
+
+// Set on a worker thread that was detached from its session by
+// stopAsyncWorkers, so that it leaves its loop without touching the session,
+// which may be destroyed.
+static thread_local bool asyncWorkerDetached = false;
+
+void PyExecutionSession::asyncWorkerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(_asyncMutex);
+      _asyncCondition.wait(
+          lock, [this]() { return _asyncStop || !_asyncTasks.empty(); });
+      if (_asyncTasks.empty())
+        return;
+      task = std::move(_asyncTasks.front());
+      _asyncTasks.pop_front();
+    }
+    task();
+    if (asyncWorkerDetached)
+      return;
+  }
+}
+
+void PyExecutionSession::stopAsyncWorkers() {
+  if (_asyncWorkers.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(_asyncMutex);
+    _asyncStop = true;
+  }
+  _asyncCondition.notify_all();
+  // A task may drop the last reference to the session, e.g. in a done
+  // callback of its future, so the session may be stopped by one of its
+  // workers. That worker cannot join itself and is detached instead.
+  std::thread::id self = std::this_thread::get_id();
+  bool onWorker = false;
+  {
+    // Workers need the GIL to complete their futures.
+    py::gil_scoped_release release;
+    for (std::thread &worker : _asyncWorkers) {
+      if (worker.get_id() == self) {
+        onWorker = true;
+        asyncWorkerDetached = true;
+        worker.detach();
+      } else {
+        worker.join();
+      }
+    }
+  }
+  // The other workers, if any, have finished the queued inferences. Otherwise
+  // they are run by this thread.
+  while (onWorker) {
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(_asyncMutex);
+      if (_asyncTasks.empty())
+        break;
+      task = std::move(_asyncTasks.front());
+      _asyncTasks.pop_front();
+    }
+    task();
+  }
+  _asyncWorkers.clear();
+  _asyncStop = false;
+}
+
+void PyExecutionSession::pyPrepare(const std::vector<py::array> &inputsPyArray,
+    const std::vector<py::array> &outputsPyArray) {
+  pyResetPrepared();
+  std::vector<OMTensor *> omts;
+  for (auto inputPyArray : inputsPyArray) {
+    OM_DATA_TYPE dtype = pyArrayDataType(inputPyArray);
+    if (dtype == ONNX_TYPE_UNDEFINED) {
+      for (OMTensor *omt : omts)
+        omTensorDestroy(omt);
+      throw std::runtime_error("Numpy type not supported: " +
+                               std::string(py::str(inputPyArray.dtype())));
+    }
+    omts.emplace_back(pyArrayToOMTensor(inputPyArray, dtype));
+  }
+  // The list refers to the OMTensor array, which is kept with the session.
+  _preparedOmts = std::move(omts);
+  _preparedInputList =
+      omTensorListCreate(_preparedOmts.data(), _preparedOmts.size());
+  // Keep the arrays alive, since the OMTensors refer to their data.
+  _preparedInputs = inputsPyArray;
+  _preparedOutputs = outputsPyArray;
+}
+
+void PyExecutionSession::pySetInput(int64_t index, py::array inputPyArray) {
+  if (!_preparedInputList)
+    throw std::runtime_error("No prepared inputs.");
+  if (index < 0 || index >= omTensorListGetSize(_preparedInputList))
+    throw std::out_of_range("Input index out of range.");
+  OMTensor *omt = omTensorListGetOmtByIndex(_preparedInputList, index);
+  if (pyArrayDataType(inputPyArray) != omTensorGetDataType(omt) ||
+      (int64_t)inputPyArray.ndim() != omTensorGetRank(omt))
+    throw std::runtime_error(
+        "Input type or rank differs from the prepared input.");
+  // Only the data pointer, shape and strides of the OMTensor change.
+  int64_t ownData;
+  void *dataPtr = pyArrayDataPtr(inputPyArray, ownData);
+  omTensorSetDataPtr(omt, ownData, dataPtr, NULL);
+  omTensorSetShape(
+      omt, (int64_t *)(const_cast<ssize_t *>(inputPyArray.shape())));
+  omTensorSetStridesWithPyArrayStrides(
+      omt, (int64_t *)const_cast<ssize_t *>(inputPyArray.strides()));
+  _preparedInputs[index] = inputPyArray;
+}
+
+std::vector<py::array> PyExecutionSession::pyRunPrepared() {
+  assert(_entryPointFunc && "Entry point not loaded.");
+  if (!_preparedInputList)
+    throw std::runtime_error("No prepared inputs.");
+
+  OMTensorList *wrappedOutput;
+  {
+    py::gil_scoped_release release;
+    wrappedOutput = runEntryPoint(_preparedInputList);
+  }
+  if (!wrappedOutput)
+    throw std::runtime_error(reportErrnoError());
+  if (_preparedOutputs.empty()) {
+    std::vector<py::array> outputPyArrays =
+        omTensorListToPyArrays(wrappedOutput);
+    omTensorListDestroy(wrappedOutput);
+    return outputPyArrays;
+  }
+
+  // Copy the outputs into the prepared output arrays, which must match them.
+  int64_t numOutputs = omTensorListGetSize(wrappedOutput);
+  bool match = numOutputs == (int64_t)_preparedOutputs.size();
+  for (int64_t i = 0; match && i < numOutputs; i++) {
+    auto *omt = omTensorListGetOmtByIndex(wrappedOutput, i);
+    py::array &outputPyArray = _preparedOutputs[i];
+    match = outputPyArray.writeable() &&
+            pyArrayDataType(outputPyArray) == omTensorGetDataType(omt) &&
+            (int64_t)outputPyArray.nbytes() == omTensorGetBufferSize(omt);
+    if (match)
+      memcpy(outputPyArray.mutable_data(), omTensorGetDataPtr(omt),
+          outputPyArray.nbytes());
   }
   omTensorListDestroy(wrappedOutput);
-  omTensorListDestroy(wrappedInput);
+  if (!match)
+    throw std::runtime_error(
+        "Output type or size differs from the prepared output.");
+  return _preparedOutputs;
+}
 
-  return outputPyArrays;
+void PyExecutionSession::pyResetPrepared() {
+  // The OMTensors only own the copies of the non writable arrays.
+  omTensorListDestroy(_preparedInputList);
+  _preparedInputList = nullptr;
+  _preparedOmts.clear();
+  _preparedInputs.clear();
+  _preparedOutputs.clear();
 }
 
 void PyExecutionSession::pySetEntryPoint(std::string entryPointName) {
+  // The prepared inputs are those of the previous entry point.
+  pyResetPrepared();
   setEntryPoint(entryPointName);
 }
 
@@ -186,6 +451,18 @@ std::vector<std::string> PyExecutionSession::pyQueryEntryPoints() {
   return outputPyArrays;
 }
 
+void PyExecutionSession::pyWarmup(int64_t iterations) {
+  py::gil_scoped_release release;
+  warmup(iterations);
+}
+
+int64_t PyExecutionSession::pyPrefaultConstants() {
+  py::gil_scoped_release release;
+  return prefaultConstants();
+}
+
+bool PyExecutionSession::pySharesWeights() { return sharesWeights(); }
+
 std::string PyExecutionSession::pyInputSignature() {
   assert(_inputSignatureFunc && "Input signature entry point not loaded.");
   return inputSignature();
@@ -196,4 +473,48 @@ std::string PyExecutionSession::pyOutputSignature() {
   return outputSignature();
 }
 
+std::string PyExecutionSession::pyInstrumentReport() {
+  return instrumentReport();
+}
+
+void PyExecutionSession::pyResetInstrumentReport() { resetInstrumentReport(); }
+
+void PyExecutionSession::pyEnableRunStats() { enableRunStats(); }
+
+py::dict PyExecutionSession::pyRunStats() {
+  py::dict stats;
+  if (!runStatsEnabled())
+    return stats;
+  for (const std::string &entryPointName : pyQueryEntryPoints()) {
+    int64_t calls = runCalls(entryPointName);
+    if (calls == 0)
+      continue;
+    py::dict entryPointStats;
+    entryPointStats["calls"] = calls;
+    entryPointStats["errors"] = runErrors(entryPointName);
+    // Latencies in seconds, None if all the inferences failed.
+    std::pair<const char *, double> quantiles[] = {
+        {"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p999", 0.999}};
+    for (auto &quantile : quantiles) {
+      double latencyNs = runLatencyNs(entryPointName, quantile.second);
+      if (latencyNs < 0)
+        entryPointStats[quantile.first] = py::none();
+      else
+        entryPointStats[quantile.first] = latencyNs * 1e-9;
+    }
+    stats[entryPointName.c_str()] = entryPointStats;
+  }
+  return stats;
+}
+
+std::string PyExecutionSession::pyRunStatsPrometheus() {
+  return runStatsPrometheus();
+}
+
+bool PyExecutionSession::pyWriteRunStats(std::string path) {
+  return writeRunStats(path);
+}
+
+void PyExecutionSession::pyResetRunStats() { resetRunStats(); }
+
 } // namespace onnx_mlir
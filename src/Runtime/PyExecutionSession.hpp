@@ -15,6 +15,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -27,12 +33,67 @@ namespace onnx_mlir {
 
 class PyExecutionSession : public onnx_mlir::ExecutionSession {
 public:
-  PyExecutionSession(std::string sharedLibPath, bool defaultEntryPoint = true);
+  PyExecutionSession(std::string sharedLibPath, bool defaultEntryPoint = true,
+      bool prefaultConstants = false, bool shareWeights = true);
+  ~PyExecutionSession();
   std::vector<std::string> pyQueryEntryPoints();
   void pySetEntryPoint(std::string entryPointName);
+  // The GIL is released during the inference, so other Python threads run.
   std::vector<py::array> pyRun(const std::vector<py::array> &inputsPyArray);
+  // Asynchronous inference, run by a pool of native worker threads. Return a
+  // concurrent.futures.Future of the outputs. The entry point must not change
+  // while asynchronous inferences are in flight.
+  py::object pyRunAsync(const std::vector<py::array> &inputsPyArray);
+  // Number of worker threads of the asynchronous inferences, 1 by default.
+  void pySetAsyncWorkers(int64_t numWorkers);
+  // Prepared binding: the OMTensors of the inputs are created once by
+  // pyPrepare, and reused by every pyRunPrepared. pySetInput only changes the
+  // data, shape and strides of an input. If output arrays are given, the
+  // outputs are copied into them rather than into new arrays. A prepared
+  // binding must not be used by concurrent Python threads.
+  void pyPrepare(const std::vector<py::array> &inputsPyArray,
+      const std::vector<py::array> &outputsPyArray);
+  void pySetInput(int64_t index, py::array inputPyArray);
+  std::vector<py::array> pyRunPrepared();
+  void pyResetPrepared();
+  void pyWarmup(int64_t iterations);
+  int64_t pyPrefaultConstants();
+  bool pySharesWeights();
   std::string pyInputSignature();
   std::string pyOutputSignature();
+  std::string pyInstrumentReport();
+  void pyResetInstrumentReport();
+  void pyEnableRunStats();
+  py::dict pyRunStats();
+  std::string pyRunStatsPrometheus();
+  bool pyWriteRunStats(std::string path);
+  void pyResetRunStats();
+
+private:
+  static OM_DATA_TYPE pyArrayDataType(const py::array &pyArray);
+  static py::dtype omTensorPyDtype(const OMTensor *omt);
+  static OMTensor *pyArrayToOMTensor(
+      const py::array &pyArray, OM_DATA_TYPE dtype);
+  static std::vector<py::array> omTensorListToPyArrays(OMTensorList *omtl);
+
+  void submitAsync(std::function<void()> task);
+  void asyncWorkerLoop();
+  void stopAsyncWorkers();
+
+  // Prepared inputs, kept alive since their OMTensors refer to their data,
+  // and prepared outputs.
+  std::vector<py::array> _preparedInputs;
+  std::vector<py::array> _preparedOutputs;
+  std::vector<OMTensor *> _preparedOmts;
+  OMTensorList *_preparedInputList = nullptr;
+
+  // Worker threads of the asynchronous inferences, and their queue.
+  int64_t _numAsyncWorkers = 1;
+  std::vector<std::thread> _asyncWorkers;
+  std::deque<std::function<void()>> _asyncTasks;
+  std::mutex _asyncMutex;
+  std::condition_variable _asyncCondition;
+  bool _asyncStop = false;
 };
 } // namespace onnx_mlir
 
@@ -41,11 +102,44 @@ PYBIND11_MODULE(PyRuntime, m) {
       .def(py::init<const std::string &>(), py::arg("shared_lib_path"))
       .def(py::init<const std::string &, const bool>(),
           py::arg("shared_lib_path"), py::arg("use_default_entry_point"))
+      .def(py::init<const std::string &, const bool, const bool>(),
+          py::arg("shared_lib_path"), py::arg("use_default_entry_point"),
+          py::arg("prefault_constants"))
+      .def(py::init<const std::string &, const bool, const bool, const bool>(),
+          py::arg("shared_lib_path"), py::arg("use_default_entry_point"),
+          py::arg("prefault_constants"), py::arg("share_weights"))
       .def("entry_points", &onnx_mlir::PyExecutionSession::pyQueryEntryPoints)
       .def("set_entry_point", &onnx_mlir::PyExecutionSession::pySetEntryPoint,
           py::arg("name"))
       .def("run", &onnx_mlir::PyExecutionSession::pyRun, py::arg("input"))
+      .def("run_async", &onnx_mlir::PyExecutionSession::pyRunAsync,
+          py::arg("input"))
+      .def("set_async_workers",
+          &onnx_mlir::PyExecutionSession::pySetAsyncWorkers,
+          py::arg("num_workers"))
+      .def("prepare", &onnx_mlir::PyExecutionSession::pyPrepare,
+          py::arg("input"), py::arg("output") = std::vector<py::array>())
+      .def("set_input", &onnx_mlir::PyExecutionSession::pySetInput,
+          py::arg("index"), py::arg("input"))
+      .def("run_prepared", &onnx_mlir::PyExecutionSession::pyRunPrepared)
+      .def("reset_prepared", &onnx_mlir::PyExecutionSession::pyResetPrepared)
+      .def("warmup", &onnx_mlir::PyExecutionSession::pyWarmup,
+          py::arg("iterations") = 1)
+      .def("prefault_constants",
+          &onnx_mlir::PyExecutionSession::pyPrefaultConstants)
+      .def("shares_weights", &onnx_mlir::PyExecutionSession::pySharesWeights)
       .def("input_signature", &onnx_mlir::PyExecutionSession::pyInputSignature)
       .def("output_signature",
-          &onnx_mlir::PyExecutionSession::pyOutputSignature);
+          &onnx_mlir::PyExecutionSession::pyOutputSignature)
+      .def("instrument_report",
+          &onnx_mlir::PyExecutionSession::pyInstrumentReport)
+      .def("reset_instrument_report",
+          &onnx_mlir::PyExecutionSession::pyResetInstrumentReport)
+      .def("enable_run_stats", &onnx_mlir::PyExecutionSession::pyEnableRunStats)
+      .def("run_stats", &onnx_mlir::PyExecutionSession::pyRunStats)
+      .def("run_stats_prometheus",
+          &onnx_mlir::PyExecutionSession::pyRunStatsPrometheus)
+      .def("write_run_stats", &onnx_mlir::PyExecutionSession::pyWriteRunStats,
+          py::arg("path"))
+      .def("reset_run_stats", &onnx_mlir::PyExecutionSession::pyResetRunStats);
 }
\ No newline at end of file
@@ -22,4 +22,12 @@ void __dummy_do_not_call__(JNIEnv *env, jclass cls, jobject obj) {
   Java_com_ibm_onnxmlir_OMModel_query_1entry_1points(NULL, NULL);
   Java_com_ibm_onnxmlir_OMModel_input_1signature_1jni(NULL, NULL, NULL);
   Java_com_ibm_onnxmlir_OMModel_output_1signature_1jni(NULL, NULL, NULL);
+  Java_com_ibm_onnxmlir_OMModel_enable_1run_1stats(NULL, NULL);
+  Java_com_ibm_onnxmlir_OMModel_run_1stats_1jni(NULL, NULL);
+  Java_com_ibm_onnxmlir_OMModel_write_1run_1stats_1jni(NULL, NULL, NULL);
+  Java_com_ibm_onnxmlir_OMModel_reset_1run_1stats(NULL, NULL);
+  Java_com_ibm_onnxmlir_OMModel_destroy_1tensor_1jni(NULL, NULL, 0);
+  Java_com_ibm_onnxmlir_OMModel_prepare_1jni(NULL, NULL, NULL);
+  Java_com_ibm_onnxmlir_OMModel_main_1graph_1prepared_1jni(NULL, NULL, NULL, 0);
+  Java_com_ibm_onnxmlir_OMModel_destroy_1tensor_1list_1jni(NULL, NULL, 0);
 }
@@ -32,6 +32,10 @@
 
 extern OMTensorList *run_main_graph(OMTensorList *);
 
+/* Statistics of the inferences, NULL until enabled by OMModel.enableRunStats.
+ */
+static OMRunStats *jni_run_stats = NULL;
+
 /* Declare type var, make call and assign to var, check condition.
  * It's assumed that a Java exception has already been thrown so
  * this call simply returns NULL.
@@ -146,6 +150,8 @@ typedef struct {
   jclass jomtl_cls;   /* com/ibm/onnxmlir/OMTensorList class      */
 
   jmethodID jomt_constructor;   /* OMTensor constructor           */
+  jmethodID jomt_constructor_native; /* OMTensor constructor with a
+                                        native tensor handle         */
   jmethodID jomt_getData;       /* OMTensor getData method        */
   jmethodID jomt_setData;       /* OMTensor setData method        */
   jmethodID jomt_getShape;      /* OMTensor getShape method       */
@@ -200,6 +206,7 @@ const char *jnistr[] = {
     "getOmtArray",                     /* 27 FUNC_GET_OMT_ARRAY               */
     "JNI call error",                  /* 28 MSG_JNI_CALL_ERROR               */
     "native code error",               /* 29 MSG_NATIVE_CODE_ERROR            */
+    "(Ljava/nio/ByteBuffer;[J[JIJ)V",  /* 30 CTOR_OMTENSOR_NATIVE             */
 };
 #ifdef __MVS__
 #pragma convert(pop)
@@ -241,6 +248,7 @@ enum {
   FUNC_GET_OMT_ARRAY                = 27, /* getOmtArray                     */
   MSG_JNI_CALL_ERROR                = 28, /* JNI call error                  */
   MSG_NATIVE_CODE_ERROR             = 29, /* native code error               */
+  CTOR_OMTENSOR_NATIVE              = 30, /* (Ljava/nio/ByteBuffer;[J[JIJ)V  */
 };
 /* clang-format on */
 
@@ -275,6 +283,11 @@ jniapi_t *fill_jniapi(JNIEnv *env, jniapi_t *japi) {
           env, japi->jomt_cls, jnistr[CTOR_INIT], jnistr[CTOR_OMTENSOR]),
       japi->jomt_constructor != NULL, japi->jecpt_cls,
       "Method OMTensor.<init> not found");
+  JNI_VAR_CALL(env, japi->jomt_constructor_native,
+      (*env)->GetMethodID(env, japi->jomt_cls, jnistr[CTOR_INIT],
+          jnistr[CTOR_OMTENSOR_NATIVE]),
+      japi->jomt_constructor_native != NULL, japi->jecpt_cls,
+      "Method OMTensor.<init> with native handle not found");
   JNI_VAR_CALL(env, japi->jomt_getData,
       (*env)->GetMethodID(
           env, japi->jomt_cls, jnistr[FUNC_GET_DATA], jnistr[SIG_GET_DATA]),
@@ -508,6 +521,128 @@ OMTensorList *omtl_java_to_native(
   return jni_omtl;
 }
 
+/* Update a native data structure prepared by omtl_java_to_native
+ *
+ * The native OMTensor structs of a prepared OMTensorList are reused from one
+ * inference to the next. Only the data buffer address, the shape, the
+ * strides, and the data type are refreshed from the Java OMTensor objects,
+ * since setting the data of a Java OMTensor allocates a new direct byte
+ * buffer. The rank and the number of OMTensors cannot change.
+ */
+OMTensorList *omtl_java_refresh_native(JNIEnv *env, jclass cls,
+    jobject java_omtl, OMTensorList *jni_omtl, jniapi_t *japi) {
+
+  /* Get OMTensor array Java object in OMTensorList */
+  JNI_TYPE_VAR_CALL(env, jobjectArray, jomtl_omts,
+      (*env)->CallObjectMethod(env, java_omtl, japi->jomtl_getOmtArray),
+      jomtl_omts != NULL, japi->jecpt_cls, "jomtl_omts=%p", jomtl_omts);
+
+  /* Get the number of OMTensors in the array, which must not change */
+  JNI_TYPE_VAR_CALL(env, jlong, jomtl_omtn,
+      (*env)->GetArrayLength(env, jomtl_omts),
+      jomtl_omtn == omTensorListGetSize(jni_omtl), japi->jecpt_cls,
+      "jomtl_omtn=%ld", jomtl_omtn);
+
+  OMTensor **jni_omts = omTensorListGetOmtArray(jni_omtl);
+  for (int i = 0; i < jomtl_omtn; i++) {
+    JNI_TYPE_VAR_CALL(env, jobject, jobj_omt,
+        (*env)->GetObjectArrayElement(env, jomtl_omts, i), jobj_omt != NULL,
+        japi->jecpt_cls, "jobj_omts[%d]=%p", i, jobj_omt);
+
+    /* Get data, shape, strides, and dataType */
+    JNI_TYPE_VAR_CALL(env, jobject, jomt_data,
+        (*env)->CallObjectMethod(env, jobj_omt, japi->jomt_getData),
+        jomt_data != NULL, japi->jecpt_cls, "omt[%d]:data=%p", i, jomt_data);
+    JNI_TYPE_VAR_CALL(env, jobject, jomt_shape,
+        (*env)->CallObjectMethod(env, jobj_omt, japi->jomt_getShape),
+        jomt_shape != NULL, japi->jecpt_cls, "omt[%d]:shape=%p", i, jomt_shape);
+    JNI_TYPE_VAR_CALL(env, jobject, jomt_strides,
+        (*env)->CallObjectMethod(env, jobj_omt, japi->jomt_getStrides),
+        jomt_strides != NULL, japi->jecpt_cls, "omt[%d]:strides=%p", i,
+        jomt_strides);
+    JNI_TYPE_VAR_CALL(env, jint, jomt_dataType,
+        (*env)->CallIntMethod(env, jobj_omt, japi->jomt_getDataType),
+        jomt_dataType != ONNX_TYPE_UNDEFINED, japi->jecpt_cls,
+        "omt[%d]:dataType=%d", i, jomt_dataType);
+
+    /* The rank must not change since shape and strides are copied in place */
+    int64_t jni_rank = omTensorGetRank(jni_omts[i]);
+    JNI_TYPE_VAR_CALL(env, jlong, jomt_rank,
+        (*env)->GetArrayLength(env, jomt_shape), jomt_rank == jni_rank,
+        japi->jecpt_cls, "omt[%d]:rank=%ld", i, jomt_rank);
+
+    /* Get direct buffer associated with data */
+    JNI_TYPE_VAR_CALL(env, void *, jni_data,
+        (*env)->GetDirectBufferAddress(env, jomt_data), jni_data != NULL,
+        japi->jecpt_cls, "omt[%d]:jni_data=%p", i, jni_data);
+
+    /* Refresh the native OMTensor struct, data is still owned by Java */
+    omTensorSetDataPtr(jni_omts[i], 0, jni_data, NULL);
+    omTensorSetDataType(jni_omts[i], (OM_DATA_TYPE)jomt_dataType);
+    JNI_CALL(env,
+        (*env)->GetLongArrayRegion(env, jomt_shape, 0, jni_rank,
+            (jlong *)omTensorGetShape(jni_omts[i])),
+        1, NULL, "");
+    JNI_CALL(env,
+        (*env)->GetLongArrayRegion(env, jomt_strides, 0, jni_rank,
+            (jlong *)omTensorGetStrides(jni_omts[i])),
+        1, NULL, "");
+
+    /* Release local references, the loop may be long */
+    (*env)->DeleteLocalRef(env, jomt_strides);
+    (*env)->DeleteLocalRef(env, jomt_shape);
+    (*env)->DeleteLocalRef(env, jomt_data);
+    (*env)->DeleteLocalRef(env, jobj_omt);
+  }
+
+  return jni_omtl;
+}
+
+/* Create the Java OMTensor of a native OMTensor handle, whose data buffer is
+ * given to Java as a direct byte buffer. The Java OMTensor releases the
+ * handle with omTensorDestroy when the buffer is garbage collected. Return
+ * NULL, with a Java exception thrown, if the Java objects cannot be created.
+ */
+static jobject omt_handle_to_java(JNIEnv *env, jniapi_t *japi, int i,
+    OMTensor *jni_handle, jlong jomt_bufferSize, int64_t *jni_shape,
+    int64_t *jni_strides, jint jomt_rank, jint jomt_dataType) {
+  JNI_TYPE_VAR_CALL(env, jobject, jomt_data,
+      (*env)->NewDirectByteBuffer(
+          env, omTensorGetDataPtr(jni_handle), jomt_bufferSize),
+      jomt_data != NULL, japi->jecpt_cls, "omt[%d]:jomt_data=%p", i,
+      jomt_data);
+
+  /* Create data shape array Java object, fill in from native array */
+  JNI_TYPE_VAR_CALL(env, jlongArray, jomt_shape,
+      (*env)->NewLongArray(env, jomt_rank), jomt_shape != NULL,
+      japi->jecpt_cls, "omt[%d]:jomt_shape=%p", i, jomt_shape);
+  JNI_CALL(env,
+      (*env)->SetLongArrayRegion(
+          env, jomt_shape, 0, jomt_rank, (jlong *)jni_shape),
+      1, NULL, "");
+
+  /* Create data strides array Java object, fill in from native array */
+  JNI_TYPE_VAR_CALL(env, jlongArray, jomt_strides,
+      (*env)->NewLongArray(env, jomt_rank), jomt_strides != NULL,
+      japi->jecpt_cls, "omt[%d]:jomt_strides=%p", i, jomt_strides);
+  JNI_CALL(env,
+      (*env)->SetLongArrayRegion(
+          env, jomt_strides, 0, jomt_rank, (jlong *)jni_strides),
+      1, NULL, "");
+
+  JNI_TYPE_VAR_CALL(env, jobject, jobj_omt,
+      (*env)->NewObject(env, japi->jomt_cls, japi->jomt_constructor_native,
+          jomt_data, jomt_shape, jomt_strides, jomt_dataType,
+          (jlong)(intptr_t)jni_handle),
+      jobj_omt != NULL, japi->jecpt_cls, "omt[%d]:jobj_omt=%p", i, jobj_omt);
+
+  /* Release local references, the loop of the caller may be long */
+  (*env)->DeleteLocalRef(env, jomt_strides);
+  (*env)->DeleteLocalRef(env, jomt_shape);
+  (*env)->DeleteLocalRef(env, jomt_data);
+  return jobj_omt;
+}
+
 /* Convert native data structure to Java object
  *
  *          +---------------------------+
@@ -521,25 +656,25 @@ OMTensorList *omtl_java_to_native(
  *                        | Tensor |
  *                        |        | (constructed by jniwrapper)
  *                        | _data  |
- * Java world             +---|----+
- * ---------------------------|------------------------------------------
- * Native world               v
- *                            +--------------------+ (constructed by
- *                            | native buffer      |  model runtime)
- *                            +--------------------+
- *                            ^ ownership true -> false, xferred to Java
- *                      +-----|---------+
- *                      | _allocatedPtr | (constructed by model runtime)
- *                      |               |<---+
- *                      | omTensor      |    |
- *                      +---------------+  freed by
- *                      ^                  omTensorListDestroy(jni_oomtl)
- *        +-------------|---------------+  at the end of
- *        |       +-----|-----------+   |  ..._main_1graph_1jni
- *        | _omts |   | o | ... |   |   |    |
- *        |       +-----------------+   |<---+
- *        | omTensorList                | (constructed by model runtime)
- *        +-----------------------------+
+ * Java world             +---|----+ Cleaner of the direct byte buffer
+ * ---------------------------|--------------------------------------|---
+ * Native world               v                                      |
+ *                            +--------------------+ (constructed by |
+ *                            | native buffer      |  model runtime) |
+ *                            +--------------------+                 |
+ *                            ^ ownership kept by the omTensor       |
+ *                      +-----|---------+                            |
+ *                      | _allocatedPtr | (constructed by model      |
+ *                      |               |  runtime)                  |
+ *                      | omTensor      |<---------------------------+
+ *                      +---------------+  freed by omTensorDestroy when
+ *                      ^                  Java garbage collects the buffer
+ *        +-------------|---------------+
+ *        |       +-----|-----------+   |  _omts[i] set to NULL, freed by
+ *        | _omts |   | o | ... |   |   |  omTensorListDestroy(jni_oomtl)
+ *        |       +-----------------+   |  at the end of
+ *        | omTensorList                |  ..._main_1graph_1jni
+ *        +-----------------------------+ (constructed by model runtime)
  */
 jobject omtl_native_to_java(
     JNIEnv *env, jclass cls, OMTensorList *jni_omtl, jniapi_t *japi) {
@@ -594,14 +729,14 @@ jobject omtl_native_to_java(
     jint jomt_rank = jni_rank;
     /*jlong jomt_numElems = jni_numElems;*/
 
-    /* Create direct byte buffer Java object from native data buffer.
+    /* Give the native data buffer to Java as a direct byte buffer.
      *
-     * If jni_owning is true, we take ownership by setting owner flag
-     * to false. This means that when we call omTensorListDestroy
-     * the data buffer will not be freed since it has been given to
-     * the Java direct byte buffer and the Java GC will be responsible
-     * for freeing the data buffer. This way we avoid copying the data
-     * buffer.
+     * If jni_owning is true, the data buffer is given to Java without
+     * copying it. The native OMTensor is removed from the OMTensorList so
+     * that omTensorListDestroy does not free it, and its handle is given
+     * to the Java OMTensor. When Java garbage collects the direct byte
+     * buffer, its Cleaner calls omTensorDestroy on the handle, which frees
+     * the data buffer.
      *
      * If jni_owning is false, it means the data buffer is not freeable
      * due to one of the two following cases:
@@ -611,54 +746,42 @@ jobject omtl_native_to_java(
      *   - the data buffer is static
      *
      * Either way, since the data buffer will be given to Java and is
-     * subject to GC, we must make a copy of the data buffer.
+     * subject to GC, we must make a copy of the data buffer. The copy is
+     * owned by a new native OMTensor, released the same way.
      */
-    void *jbytebuffer_data = jni_data;
-    if (jni_owning) {
-      LIB_CALL(omTensorSetOwning(jni_omts[i], (int64_t)0), 1, env,
-          japi->jecpt_cls, "");
-      LOG_PRINTF(LOG_DEBUG, "omt[%d]:%p data %p ownership taken", i,
-          jni_omts[i], jni_data);
-    } else {
-      LIB_VAR_CALL(jbytebuffer_data, malloc(jni_bufferSize),
-          jbytebuffer_data != NULL, env, japi->jecpt_cls, "jbytebuffer_data=%p",
-          jbytebuffer_data);
-      memcpy(jbytebuffer_data, jni_data, jni_bufferSize);
+    OMTensor *jni_handle = jni_omts[i];
+    if (!jni_owning) {
+      /* omTensorCreateEmpty frees its buffer if it fails */
+      LIB_VAR_CALL(jni_handle,
+          omTensorCreateEmpty(jni_shape, jni_rank, jni_dataType),
+          jni_handle != NULL, env, japi->jecpt_cls, "omt[%d]:jni_handle=%p", i,
+          jni_handle);
+      memcpy(omTensorGetDataPtr(jni_handle), jni_data, jni_bufferSize);
       LOG_PRINTF(LOG_DEBUG, "omt[%d]:%p data %p copied into %p", i, jni_omts[i],
-          jni_data, jbytebuffer_data);
+          jni_data, omTensorGetDataPtr(jni_handle));
     }
-    JNI_TYPE_VAR_CALL(env, jobject, jomt_data,
-        (*env)->NewDirectByteBuffer(env, jbytebuffer_data, jomt_bufferSize),
-        jomt_data != NULL, japi->jecpt_cls, "omt[%d]:jomt_data=%p", i,
-        jomt_data);
-
-    /* Create data shape array Java object, fill in from native array */
-    JNI_TYPE_VAR_CALL(env, jlongArray, jomt_shape,
-        (*env)->NewLongArray(env, jomt_rank), jomt_shape != NULL,
-        japi->jecpt_cls, "omt[%d]:jomt_shape=%p", i, jomt_shape);
-    JNI_CALL(env,
-        (*env)->SetLongArrayRegion(
-            env, jomt_shape, 0, jomt_rank, (jlong *)jni_shape),
-        1, NULL, "");
 
-    /* Create data strides array Java object, fill in from native array */
-    JNI_TYPE_VAR_CALL(env, jlongArray, jomt_strides,
-        (*env)->NewLongArray(env, jomt_rank), jomt_strides != NULL,
-        japi->jecpt_cls, "omt[%d]:jomt_strides=%p", i, jomt_strides);
-    JNI_CALL(env,
-        (*env)->SetLongArrayRegion(
-            env, jomt_strides, 0, jomt_rank, (jlong *)jni_strides),
-        1, NULL, "");
-
-    /* Create the OMTensor Java object */
-    JNI_TYPE_VAR_CALL(env, jobject, jobj_omt,
-        (*env)->NewObject(env, japi->jomt_cls, japi->jomt_constructor,
-            jomt_data, jomt_shape, jomt_strides, jomt_dataType),
-        jobj_omt != NULL, japi->jecpt_cls, "omt[%d]:jobj_omt=%p", i, jobj_omt);
+    /* Create the OMTensor Java object, which releases jni_handle. If it
+     * cannot be created, the handle is still owned by native code: the
+     * copy is destroyed here, and the original stays in the OMTensorList.
+     */
+    jobject jobj_omt = omt_handle_to_java(env, japi, i, jni_handle,
+        jomt_bufferSize, jni_shape, jni_strides, jomt_rank, jomt_dataType);
+    if (jobj_omt == NULL) {
+      if (!jni_owning)
+        omTensorDestroy(jni_handle);
+      return NULL;
+    }
+    if (jni_owning) {
+      jni_omts[i] = NULL;
+      LOG_PRINTF(LOG_DEBUG, "omt[%d]:%p data %p ownership taken", i,
+          jni_handle, jni_data);
+    }
 
     /* Set the OMTensor object in the object array */
     JNI_CALL(env, (*env)->SetObjectArrayElement(env, jobj_omts, i, jobj_omt), 1,
         NULL, "");
+    (*env)->DeleteLocalRef(env, jobj_omt);
   }
 
   /* Create the OMTensorList java object */
@@ -670,6 +793,21 @@ jobject omtl_native_to_java(
   return java_omtl;
 }
 
+/* Call the model inference entry point, and record the inference if the
+ * statistics are enabled.
+ */
+static OMTensorList *run_main_graph_with_stats(OMTensorList *iomtl) {
+  OMRunStats *stats = jni_run_stats;
+  if (stats == NULL)
+    return run_main_graph(iomtl);
+
+  uint64_t start = omRunStatsGetTimeNs();
+  OMTensorList *oomtl = run_main_graph(iomtl);
+  omRunStatsRecord(stats, "run_main_graph", omRunStatsGetTimeNs() - start,
+      oomtl == NULL);
+  return oomtl;
+}
+
 JNIEXPORT jobject JNICALL Java_com_ibm_onnxmlir_OMModel_main_1graph_1jni(
     JNIEnv *env, jclass cls, jobject java_iomtl) {
 
@@ -691,7 +829,7 @@ JNIEXPORT jobject JNICALL Java_com_ibm_onnxmlir_OMModel_main_1graph_1jni(
       "jni_iomtl=%p", jni_iomtl);
 
   /* Call model inference entry point */
-  CHECK_CALL(OMTensorList *, jni_oomtl, run_main_graph(jni_iomtl),
+  CHECK_CALL(OMTensorList *, jni_oomtl, run_main_graph_with_stats(jni_iomtl),
       jni_oomtl != NULL, "jni_oomtl=%p", jni_oomtl);
 
   /* Convert native data structure to Java object */
@@ -705,6 +843,69 @@ JNIEXPORT jobject JNICALL Java_com_ibm_onnxmlir_OMModel_main_1graph_1jni(
   return java_oomtl;
 }
 
+/* Build the native data structure of a Java OMTensorList once, so that it
+ * can be reused by ..._main_1graph_1prepared_1jni. The Java OMTensorList
+ * releases it with ..._destroy_1tensor_1list_1jni.
+ */
+static OMTensorList *prepare_tensor_list(
+    JNIEnv *env, jclass cls, jobject java_iomtl) {
+  jniapi_t jniapi;
+
+  log_init();
+
+  /* Find and initialize Java method IDs in struct jniapi */
+  CHECK_CALL(jniapi_t *, japi, fill_jniapi(env, &jniapi), japi != NULL,
+      "japi=%p", japi);
+
+  /* Convert Java object to native data structure */
+  CHECK_CALL(OMTensorList *, jni_iomtl,
+      omtl_java_to_native(env, cls, java_iomtl, japi), jni_iomtl != NULL,
+      "jni_iomtl=%p", jni_iomtl);
+  return jni_iomtl;
+}
+
+JNIEXPORT jlong JNICALL Java_com_ibm_onnxmlir_OMModel_prepare_1jni(
+    JNIEnv *env, jclass cls, jobject java_iomtl) {
+  return (jlong)(intptr_t)prepare_tensor_list(env, cls, java_iomtl);
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_ibm_onnxmlir_OMModel_main_1graph_1prepared_1jni(
+    JNIEnv *env, jclass cls, jobject java_iomtl, jlong handle) {
+  jniapi_t jniapi;
+
+  log_init();
+
+  /* Find and initialize Java method IDs in struct jniapi */
+  CHECK_CALL(jniapi_t *, japi, fill_jniapi(env, &jniapi), japi != NULL,
+      "japi=%p", japi);
+
+  /* Refresh the prepared native data structure from the Java object */
+  CHECK_CALL(OMTensorList *, jni_iomtl,
+      omtl_java_refresh_native(
+          env, cls, java_iomtl, (OMTensorList *)(intptr_t)handle, japi),
+      jni_iomtl != NULL, "jni_iomtl=%p", jni_iomtl);
+
+  /* Call model inference entry point */
+  CHECK_CALL(OMTensorList *, jni_oomtl, run_main_graph_with_stats(jni_iomtl),
+      jni_oomtl != NULL, "jni_oomtl=%p", jni_oomtl);
+
+  /* Convert native data structure to Java object */
+  CHECK_CALL(jobject, java_oomtl,
+      omtl_native_to_java(env, cls, jni_oomtl, japi), java_oomtl != NULL,
+      "java_oomtl=%p", java_oomtl);
+
+  /* Free output data structure only, the input one is kept for reuse */
+  omTensorListDestroy(jni_oomtl);
+  return java_oomtl;
+}
+
+JNIEXPORT void JNICALL
+Java_com_ibm_onnxmlir_OMModel_destroy_1tensor_1list_1jni(
+    JNIEnv *env, jclass cls, jlong handle) {
+  omTensorListDestroy((OMTensorList *)(intptr_t)handle);
+}
+
 #ifdef __MVS__
 /* On z/OS, we convert entry point name in ASCII into EBCDIC for
  * the omInputSignature/omOutputSignaturee function using __a2e_s.
@@ -911,3 +1112,92 @@ JNIEXPORT jstring JNICALL Java_com_ibm_onnxmlir_OMModel_output_1signature_1jni(
 
   return java_osig;
 }
+
+JNIEXPORT jboolean JNICALL Java_com_ibm_onnxmlir_OMModel_enable_1run_1stats(
+    JNIEnv *env, jclass cls) {
+
+  log_init();
+
+  if (jni_run_stats == NULL)
+    jni_run_stats = omRunStatsCreate(NULL);
+  LOG_PRINTF(LOG_DEBUG, "jni_run_stats=%p", jni_run_stats);
+  return jni_run_stats != NULL ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jstring JNICALL Java_com_ibm_onnxmlir_OMModel_run_1stats_1jni(
+    JNIEnv *env, jclass cls) {
+
+  log_init();
+
+  /* Find and initialize Java Exception class */
+  JNI_TYPE_VAR_CALL(env, jclass, jecpt_cls,
+      (*env)->FindClass(env, jnistr[CLS_JAVA_LANG_EXCEPTION]),
+      jecpt_cls != NULL, NULL, "Class java/lang/Exception not found");
+
+  /* Statistics in Prometheus text format, empty if not enabled */
+  char *jni_stats =
+      jni_run_stats != NULL ? omRunStatsToPrometheus(jni_run_stats) : NULL;
+
+  /* On z/OS, convert statistics in EBCDIC to ASCII */
+#ifdef __MVS__
+  char *statsptr = jni_stats != NULL ? __e2a(jni_stats) : NULL;
+#else
+  char *statsptr = jni_stats;
+#endif
+
+  /* Convert to Java String object */
+  JNI_TYPE_VAR_CALL(env, jstring, java_stats,
+      (*env)->NewStringUTF(env, statsptr != NULL ? statsptr : ""),
+      java_stats != NULL, jecpt_cls, "java_stats=%p", java_stats);
+
+#ifdef __MVS__
+  free(statsptr);
+#endif
+  free(jni_stats);
+  return java_stats;
+}
+
+JNIEXPORT jboolean JNICALL Java_com_ibm_onnxmlir_OMModel_write_1run_1stats_1jni(
+    JNIEnv *env, jclass cls, jstring path) {
+
+  log_init();
+
+  if (jni_run_stats == NULL)
+    return JNI_FALSE;
+
+  /* Get reference to the path Java String object */
+  const char *jni_path = (*env)->GetStringUTFChars(env, path, NULL);
+  if (jni_path == NULL)
+    return JNI_FALSE;
+
+  /* On z/OS, convert path in UTF-8 to EBCDIC */
+#ifdef __MVS__
+  char *pathptr = __a2e(jni_path);
+#else
+  const char *pathptr = jni_path;
+#endif
+
+  int rc =
+      pathptr != NULL ? omRunStatsWritePrometheus(jni_run_stats, pathptr) : -1;
+  LOG_PRINTF(LOG_DEBUG, "path:%s rc=%d", jni_path, rc);
+
+#ifdef __MVS__
+  free(pathptr);
+#endif
+  (*env)->ReleaseStringUTFChars(env, path, jni_path);
+  return rc == 0 ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL Java_com_ibm_onnxmlir_OMModel_reset_1run_1stats(
+    JNIEnv *env, jclass cls) {
+  if (jni_run_stats != NULL)
+    omRunStatsReset(jni_run_stats);
+}
+
+/* Release a native OMTensor given to Java by omtl_native_to_java. Called by
+ * the Cleaner of the direct byte buffer of the output OMTensor.
+ */
+JNIEXPORT void JNICALL Java_com_ibm_onnxmlir_OMModel_destroy_1tensor_1jni(
+    JNIEnv *env, jclass cls, jlong handle) {
+  omTensorDestroy((OMTensor *)(intptr_t)handle);
+}
@@ -171,14 +171,60 @@ public class OMModel {
     private static native String[] query_entry_points();
     private static native String input_signature_jni(String entry_point);
     private static native String output_signature_jni(String entry_point);
+    private static native boolean enable_run_stats();
+    private static native String run_stats_jni();
+    private static native boolean write_run_stats_jni(String path);
+    private static native void reset_run_stats();
+    private static native void destroy_tensor_jni(long handle);
+    private static native long prepare_jni(OMTensorList list);
+    private static native OMTensorList main_graph_prepared_jni(OMTensorList list,
+                                                               long handle);
+    private static native void destroy_tensor_list_jni(long handle);
+
+    /**
+     * Destroy a native output tensor (For OMTensor only. Not intended
+     * for end user)
+     *
+     * @param handle native tensor
+     */
+    static void destroyTensor(long handle) {
+        destroy_tensor_jni(handle);
+    }
+
+    /**
+     * Build the native tensor list of an OMTensorList (For OMTensorList
+     * only. Not intended for end user)
+     *
+     * @param list input tensor list
+     * @return native tensor list
+     */
+    static long prepareTensorList(OMTensorList list) {
+        return prepare_jni(list);
+    }
+
+    /**
+     * Destroy the native tensor list of an OMTensorList (For OMTensorList
+     * only. Not intended for end user)
+     *
+     * @param handle native tensor list
+     */
+    static void destroyTensorList(long handle) {
+        destroy_tensor_list_jni(handle);
+    }
 
     /**
      * Default model runtime entry point
      *
+     * The native tensors of the inputs are reused if the input tensor
+     * list is prepared, see OMTensorList.prepare.
+     *
      * @param list input tensor list
      * @return output tensor list
      */
     public static OMTensorList mainGraph(OMTensorList list) {
+        long handle = list.getHandle();
+        if (handle != 0)
+            return main_graph_prepared_jni(list, handle);
         return main_graph_jni(list);
     }
 
@@ -216,4 +262,42 @@ public class OMModel {
     public static String outputSignature(String entry_point) {
         return output_signature_jni(entry_point);
     }
+
+    /**
+     * Start counting the inferences of the model and their latency.
+     * Call it once before running the model from several threads.
+     *
+     * @return true if the statistics are enabled
+     */
+    public static boolean enableRunStats() {
+        return enable_run_stats();
+    }
+
+    /**
+     * Statistics of the inferences in the Prometheus text format:
+     * calls and errors counters and latency quantiles.
+     *
+     * @return Prometheus text, empty if the statistics are not enabled
+     */
+    public static String runStats() {
+        return run_stats_jni();
+    }
+
+    /**
+     * Write the statistics of the inferences in the Prometheus text
+     * format to a file, e.g. for the node_exporter textfile collector.
+     *
+     * @param path of the file
+     * @return true if the file was written
+     */
+    public static boolean writeRunStats(String path) {
+        return write_run_stats_jni(path);
+    }
+
+    /**
+     * Clear the statistics of the inferences.
+     */
+    public static void resetRunStats() {
+        reset_run_stats();
+    }
 }
@@ -2,6 +2,7 @@
 
 package com.ibm.onnxmlir;
 
+import java.lang.ref.Cleaner;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.DoubleBuffer;
@@ -612,6 +613,44 @@ public class OMTensor {
         _strides = strides;
     }
 
+    /* Releases the native tensors of the output data buffers, and the
+     * native tensor lists of the prepared OMTensorList objects
+     */
+    final static Cleaner cleaner = Cleaner.create();
+
+    /* Cleaning action, must not refer to the OMTensor or its buffer */
+    private static class NativeTensorReleaser implements Runnable {
+        private final long _handle;
+
+        NativeTensorReleaser(long handle) {
+            _handle = handle;
+        }
+
+        public void run() {
+            OMModel.destroyTensor(_handle);
+        }
+    }
+
+    /**
+     * Constructor (For JNI wrapper only. Not intended for end user)
+     *
+     * The data buffer is a direct byte buffer over the memory of a
+     * native tensor, which is not copied. The native tensor is destroyed
+     * when the data buffer, and any view of it, becomes unreachable.
+     *
+     * @param data data buffer
+     * @param shape data shape
+     * @param strides data stride
+     * @param dataType data type
+     * @param handle native tensor owning the data buffer
+     */
+    protected OMTensor(ByteBuffer data, long[] shape, long[] strides, int dataType,
+                       long handle) {
+        this(data, shape, strides, dataType);
+        if (handle != 0)
+            cleaner.register(_data, new NativeTensorReleaser(handle));
+    }
+
     /**
      * Raw data getter (For JNI wrapper only. Not intended for end user)
      *
@@ -10,6 +10,22 @@ package com.ibm.onnxmlir;
 public class OMTensorList {
 
     private OMTensor[] _omts;
+
+    /* Native tensor list built by prepare, 0 if not prepared */
+    private long _handle = 0;
+
+    /* Cleaning action, must not refer to the OMTensorList */
+    private static class NativeTensorListReleaser implements Runnable {
+        private final long _handle;
+
+        NativeTensorListReleaser(long handle) {
+            _handle = handle;
+        }
+
+        public void run() {
+            OMModel.destroyTensorList(_handle);
+        }
+    }
     
     /**
      * Constructor
@@ -38,4 +54,30 @@ public class OMTensorList {
     public OMTensor getOmtByIndex(int index) {
         return _omts[index];
     }
+
+    /**
+     * Prepare the OMTensorList to be used as input of many inferences.
+     *
+     * The native tensors given to the model are then built once and
+     * reused by every OMModel.mainGraph call on this OMTensorList, which
+     * only refreshes their data buffer, shape, strides, and data type.
+     * The number of OMTensors and their rank must not change after the
+     * OMTensorList is prepared, and a prepared OMTensorList must not be
+     * used by concurrent inferences.
+     */
+    public void prepare() {
+        if (_handle != 0)
+            return;
+        _handle = OMModel.prepareTensorList(this);
+        OMTensor.cleaner.register(this, new NativeTensorListReleaser(_handle));
+    }
+
+    /**
+     * Native tensor list getter (For OMModel only. Not intended for end user)
+     *
+     * @return native tensor list, 0 if not prepared
+     */
+    protected long getHandle() {
+        return _handle;
+    }
 }
@@ -19,6 +19,7 @@
 
 #include "mlir/IR/Matchers.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
@@ -81,6 +82,10 @@ const StringRef BUFFER_ID_ATTR = "buffer_id";
 /// Buffer pool to store buffer pointers.
 SmallVector<char *, 4> bufferPtrs;
 
+/// Min number of elements processed by one task when evaluating an op in
+/// parallel. Smaller tensors are evaluated on the calling thread.
+constexpr int64_t minElementsPerParallelTask = 1 << 14;
+
 /// A helper function to get a value of a given type from an attribute.
 template <typename T>
 T getAttrValue(Attribute attr) {
@@ -123,10 +128,12 @@ char *getArrayFromAttributeOrBuffer(PatternRewriter &rewriter, Operation *op) {
     unsigned bufferId = bufferIDAttr.cast<IntegerAttr>().getUInt();
     res = bufferPtrs[bufferId];
   } else {
-    DenseElementsAttr dataAttr =
-        op->getAttrOfType<::mlir::Attribute>("value")
-            .dyn_cast_or_null<mlir::DenseElementsAttr>();
-    res = createArrayFromDenseElementsAttr(dataAttr);
+    Attribute dataAttr = op->getAttrOfType<::mlir::Attribute>("value");
+    if (auto resourceAttr = dataAttr.dyn_cast<DenseResourceElementsAttr>())
+      res = createArrayFromDenseResourceElementsAttr(resourceAttr);
+    else
+      res = createArrayFromDenseElementsAttr(
+          dataAttr.cast<mlir::DenseElementsAttr>());
     bufferPtrs.emplace_back(res);
     unsigned bufferId = bufferPtrs.size() - 1;
     // Add an attribute to store the buffer id.
@@ -171,7 +178,16 @@ bool isFromDenseONNXConstantOp(Value result, bool trueONNXConstant = false) {
 
   // If the dense attribute is null, there must be buffer_id
   // attribute.
-  if (!(op->getAttrOfType<::mlir::Attribute>("value"))) {
+  if (Attribute valueAttr = op->getAttrOfType<::mlir::Attribute>("value")) {
+    // Dense resources, e.g. memory mapped weights, can be read into a buffer
+    // but are not true dense constants whose attribute can be read directly.
+    if (valueAttr.isa<DenseResourceElementsAttr>()) {
+      if (trueONNXConstant)
+        return false;
+    } else if (!valueAttr.isa<DenseElementsAttr>()) {
+      return false;
+    }
+  } else {
     if (trueONNXConstant)
       return false;
     if (!(op->getAttrOfType<::mlir::Attribute>(BUFFER_ID_ATTR)))
@@ -203,6 +219,94 @@ bool isVariadicOperandFromDenseONNXConstantOp(ValueRange operands) {
       operands, [](Value v) { return isFromDenseONNXConstantOp(v); });
 }
 
+/// A helper function to check whether folding an op into 'result' stays within
+/// the expansion bound, the max size in bytes of a folded constant that is
+/// larger than the constants it is computed from. Folding is always allowed
+/// when the result is not larger than the operands of the op, e.g. for a
+/// transpose or a slice.
+bool isWithinExpansionBound(Value result, int64_t expansionBoundInBytes) {
+  if (expansionBoundInBytes < 0)
+    return true;
+  auto resultType = result.getType().dyn_cast<ShapedType>();
+  if (!resultType || !resultType.hasStaticShape())
+    return false;
+  int64_t resultSize = getSizeInBytes(result.getType());
+  if (resultSize <= expansionBoundInBytes)
+    return true;
+  int64_t operandsSize = 0;
+  for (Value operand : result.getDefiningOp()->getOperands())
+    if (isRankedShapedType(operand.getType()))
+      operandsSize += getSizeInBytes(operand.getType());
+  return resultSize <= operandsSize;
+}
+
+/// Run 'fn' over [0, numElements) split into ranges of at least
+/// minElementsPerParallelTask elements, counting 'elementCost' elements for
+/// each index when an index stands for more work, e.g. a row of a matrix
+/// product. Ranges are processed in parallel when multithreading is enabled in
+/// the context.
+void parallelForRanges(MLIRContext *context, int64_t numElements,
+    int64_t alignment, function_ref<void(int64_t, int64_t)> fn,
+    int64_t elementCost = 1) {
+  int64_t minIndicesPerTask = llvm::divideCeil(
+      minElementsPerParallelTask, std::max<int64_t>(elementCost, 1));
+  int64_t chunk = std::max(minIndicesPerTask, alignment);
+  chunk = llvm::alignTo(chunk, std::max<int64_t>(alignment, 1));
+  int64_t numChunks = llvm::divideCeil(numElements, chunk);
+  if (numChunks <= 1) {
+    fn(0, numElements);
+    return;
+  }
+  mlir::parallelFor(context, 0, numChunks, [&](size_t c) {
+    int64_t begin = c * chunk;
+    fn(begin, std::min(begin + chunk, numElements));
+  });
+}
+
+/// Compute the strides for reading an input of 'shape' while iterating over
+/// 'outputShape' with multidirectional broadcast. Broadcast dimensions, as well
+/// as leading output dimensions the input does not have, get stride 0.
+SmallVector<int64_t, 4> getBroadcastStrides(
+    ArrayRef<int64_t> shape, ArrayRef<int64_t> outputShape) {
+  int64_t rank = shape.size();
+  int64_t outputRank = outputShape.size();
+  SmallVector<int64_t, 4> strides(outputRank, 0);
+  int64_t stride = 1;
+  for (int64_t i = rank - 1; i >= 0; --i) {
+    if (shape[i] != 1)
+      strides[outputRank - rank + i] = stride;
+    stride *= shape[i];
+  }
+  return strides;
+}
+
+/// Visit the output elements [begin, end), which are a whole number of
+/// innermost rows, as runs along the innermost dimension. For each run,
+/// 'fn(outputOffset, inputOffsets, length)' is called where inputOffsets are
+/// computed from the given input strides.
+template <size_t N, typename Fn>
+void forEachInnermostRun(int64_t begin, int64_t end,
+    ArrayRef<int64_t> outputShape,
+    const std::array<ArrayRef<int64_t>, N> &inputStrides, Fn fn) {
+  int64_t outputRank = outputShape.size();
+  int64_t innerDim = outputRank > 0 ? outputShape.back() : 1;
+  if (innerDim == 0)
+    return;
+  for (int64_t row = begin / innerDim; row < end / innerDim; ++row) {
+    // Decompose the row index into the outer output indices.
+    std::array<int64_t, N> offsets;
+    offsets.fill(0);
+    int64_t remainder = row;
+    for (int64_t k = outputRank - 2; k >= 0; --k) {
+      int64_t index = remainder % outputShape[k];
+      remainder /= outputShape[k];
+      for (size_t n = 0; n < N; ++n)
+        offsets[n] += index * inputStrides[n][k];
+    }
+    fn(row * innerDim, offsets, innerDim);
+  }
+}
+
 /// A helper function to create an ONNXConstantOp for a given data array.
 /// This ONNXConstantOp is only used internally.
 ONNXConstantOp createConstantOpAndStoreBufferPtr(
@@ -274,78 +378,56 @@ T ComputeConstPropElementwiseBinary(T lhs, T rhs) {
 }
 
 template <typename ElementwiseBinaryOp, typename T>
-void IterateConstPropElementwiseBinary(char *lhs, char *rhs,
-    ArrayRef<int64_t> lhsShape, ArrayRef<int64_t> rhsShape, char *res,
-    ArrayRef<int64_t> outputShape) {
-  // Rank info.
-  int lhsRank = lhsShape.size();
-  int rhsRank = rhsShape.size();
-  int outputRank = outputShape.size();
-  // Strides info.
-  std::vector<int64_t> outputStrides = getStrides(outputShape);
-  std::vector<int64_t> lhsStrides = getStrides(lhsShape);
-  std::vector<int64_t> rhsStrides = getStrides(rhsShape);
+void IterateConstPropElementwiseBinary(MLIRContext *context, char *lhs,
+    char *rhs, ArrayRef<int64_t> lhsShape, ArrayRef<int64_t> rhsShape,
+    char *res, ArrayRef<int64_t> outputShape) {
+  // Strides info. Broadcast dimensions have stride 0.
+  SmallVector<int64_t, 4> lhsStrides =
+      getBroadcastStrides(lhsShape, outputShape);
+  SmallVector<int64_t, 4> rhsStrides =
+      getBroadcastStrides(rhsShape, outputShape);
+  int64_t outputRank = outputShape.size();
+  int64_t lhsInnerStride = outputRank > 0 ? lhsStrides.back() : 0;
+  int64_t rhsInnerStride = outputRank > 0 ? rhsStrides.back() : 0;
+  int64_t innerDim = outputRank > 0 ? outputShape.back() : 1;
   // Data pointers.
   T *lhsArray = reinterpret_cast<T *>(lhs);
   T *rhsArray = reinterpret_cast<T *>(rhs);
   T *resArray = reinterpret_cast<T *>(res);
 
-  // Check broadcasting.
-  bool broadcasting = false;
-  if (lhsRank != rhsRank)
-    broadcasting = true;
-  else
-    for (int i = 0; i < outputRank; ++i)
-      if (lhsShape[i] != rhsShape[i]) {
-        broadcasting = true;
-        break;
-      }
-
-  // Do computation.
-  for (int64_t i = 0; i < ShapedType::getNumElements(outputShape); ++i) {
-    // Compute indices to access the output.
-    std::vector<int64_t> outputIndices = getAccessIndex(i, outputStrides);
-
-    // Compute indices to access inputs.
-    SmallVector<int64_t, 4> lhsIndices(lhsRank, 0);
-    SmallVector<int64_t, 4> rhsIndices(rhsRank, 0);
-    if (!broadcasting) {
-      for (int k = 0; k < outputRank; ++k) {
-        lhsIndices[k] = outputIndices[k];
-        rhsIndices[k] = outputIndices[k];
-      }
-    } else {
-      for (int k = 0; k < outputRank; ++k) {
-        // in the lhs index range.
-        if (k >= outputRank - lhsRank) {
-          int lhsIndex = k - outputRank + lhsRank;
-          if (lhsShape[lhsIndex] == 1)
-            // broadcast
-            lhsIndices[lhsIndex] = 0;
-          else
-            lhsIndices[lhsIndex] = outputIndices[k];
-        }
-        // in the rhs index range.
-        if (k >= outputRank - rhsRank) {
-          int rhsIndex = k - outputRank + rhsRank;
-          if (rhsShape[rhsIndex] == 1)
-            // broadcast
-            rhsIndices[rhsIndex] = 0;
-          else
-            rhsIndices[rhsIndex] = outputIndices[k];
-        }
-      }
-    }
-
-    // Calculate element-wise binary result.
-    int64_t lhsOffset = getLinearAccessIndex(lhsIndices, lhsStrides);
-    int64_t rhsOffset = getLinearAccessIndex(rhsIndices, rhsStrides);
-
-    T lhsValue = *(lhsArray + lhsOffset);
-    T rhsValue = *(rhsArray + rhsOffset);
-    *(resArray + i) = ComputeConstPropElementwiseBinary<ElementwiseBinaryOp, T>(
-        lhsValue, rhsValue);
-  }
+  // Do computation, one run along the innermost dimension at a time so that
+  // the inner loops are simple enough to be vectorized.
+  auto computeRange = [&](int64_t begin, int64_t end) {
+    forEachInnermostRun<2>(begin, end, outputShape, {lhsStrides, rhsStrides},
+        [&](int64_t outputOffset, std::array<int64_t, 2> offsets,
+            int64_t length) {
+          T *out = resArray + outputOffset;
+          const T *l = lhsArray + offsets[0];
+          const T *r = rhsArray + offsets[1];
+          if (lhsInnerStride == 1 && rhsInnerStride == 1) {
+            for (int64_t j = 0; j < length; ++j)
+              out[j] = ComputeConstPropElementwiseBinary<ElementwiseBinaryOp,
+                  T>(l[j], r[j]);
+          } else if (lhsInnerStride == 1) {
+            T rhsValue = r[0];
+            for (int64_t j = 0; j < length; ++j)
+              out[j] = ComputeConstPropElementwiseBinary<ElementwiseBinaryOp,
+                  T>(l[j], rhsValue);
+          } else if (rhsInnerStride == 1) {
+            T lhsValue = l[0];
+            for (int64_t j = 0; j < length; ++j)
+              out[j] = ComputeConstPropElementwiseBinary<ElementwiseBinaryOp,
+                  T>(lhsValue, r[j]);
+          } else {
+            T value =
+                ComputeConstPropElementwiseBinary<ElementwiseBinaryOp, T>(
+                    l[0], r[0]);
+            std::fill_n(out, length, value);
+          }
+        });
+  };
+  parallelForRanges(context, ShapedType::getNumElements(outputShape),
+      /*alignment=*/innerDim, computeRange);
 }
 
 /// Do element-wise binary calculation of 'lhs' and 'rhs' values and create an
@@ -371,11 +453,13 @@ Value ConstPropElementwiseBinary(
   if (elementType.isa<FloatType>()) {
     // Use double to avoid the precision loss during computation.
     IterateConstPropElementwiseBinary<ElementwiseBinaryOp, double>(
-        lhsArray, rhsArray, lhsShape, rhsShape, resArray, outputShape);
+        rewriter.getContext(), lhsArray, rhsArray, lhsShape, rhsShape,
+        resArray, outputShape);
   } else if (elementType.isa<IntegerType>()) {
     // Use int64_t to avoid the precision loss during computation.
     IterateConstPropElementwiseBinary<ElementwiseBinaryOp, int64_t>(
-        lhsArray, rhsArray, lhsShape, rhsShape, resArray, outputShape);
+        rewriter.getContext(), lhsArray, rhsArray, lhsShape, rhsShape,
+        resArray, outputShape);
   } else
     llvm_unreachable("Unknown data type");
 
@@ -420,17 +504,20 @@ T ComputeConstPropElementwiseUnary(T val) {
 }
 
 template <typename ElementwiseUnaryOp, typename T>
-void IterateConstPropElementwiseUnary(
-    char *input, char *res, ArrayRef<int64_t> outputShape) {
+void IterateConstPropElementwiseUnary(MLIRContext *context, char *input,
+    char *res, ArrayRef<int64_t> outputShape) {
   // Data pointers.
   T *inputArray = reinterpret_cast<T *>(input);
   T *resArray = reinterpret_cast<T *>(res);
 
   // Calculate element-wise unary result.
-  for (int64_t i = 0; i < ShapedType::getNumElements(outputShape); ++i) {
-    *(resArray + i) = ComputeConstPropElementwiseUnary<ElementwiseUnaryOp, T>(
-        *(inputArray + i));
-  }
+  parallelForRanges(context, ShapedType::getNumElements(outputShape),
+      /*alignment=*/1, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i)
+          resArray[i] =
+              ComputeConstPropElementwiseUnary<ElementwiseUnaryOp, T>(
+                  inputArray[i]);
+      });
 }
 
 /// Do element-wise unary calculation of 'input' value and create an
@@ -453,11 +540,11 @@ Value ConstPropElementwiseUnary(
   if (elementType.isa<FloatType>()) {
     // Use double to avoid the precision loss during computation.
     IterateConstPropElementwiseUnary<ElementwiseUnaryOp, double>(
-        constArray, resArray, replacingShape);
+        rewriter.getContext(), constArray, resArray, replacingShape);
   } else if (elementType.isa<IntegerType>()) {
     // Use int64_t to avoid the precision loss during computation.
     IterateConstPropElementwiseUnary<ElementwiseUnaryOp, int64_t>(
-        constArray, resArray, replacingShape);
+        rewriter.getContext(), constArray, resArray, replacingShape);
   } else
     llvm_unreachable("Unknown data type");
 
@@ -926,38 +1013,30 @@ Value ConstPropExpand(
       allocateBufferFor(replacingValue.getType(), /*useMaxSize=*/true);
 
   ArrayRef<int64_t> inputShape = getShape(constValue.getType());
-  std::vector<int64_t> inputStrides = getStrides(inputShape);
   ArrayRef<int64_t> outputShape = getShape(replacingValue.getType());
-  std::vector<int64_t> outputStrides = getStrides(outputShape);
-  int64_t inputRank = inputShape.size();
+  SmallVector<int64_t, 4> inputStrides =
+      getBroadcastStrides(inputShape, outputShape);
   int64_t outputRank = outputShape.size();
-
-  for (int64_t i = 0; i < ShapedType::getNumElements(outputShape); ++i) {
-    // Compute indices to access the output.
-    std::vector<int64_t> outputIndices = getAccessIndex(i, outputStrides);
-    // Compute indices to access the input.
-    SmallVector<int64_t, 4> inputIndices;
-    if (inputRank == 0) {
-      inputIndices.emplace_back(0);
-    } else {
-      for (int inputAxis = 0; inputAxis < inputRank; ++inputAxis) {
-        if (inputShape[inputAxis] == 1) {
-          // broadcast
-          inputIndices.emplace_back(0);
-        } else {
-          int outputIndex = (outputRank - inputRank) + inputAxis;
-          inputIndices.emplace_back(outputIndices[outputIndex]);
-        }
-      }
-    }
-
-    // Calculate the final result.
-    int64_t inputOffset = getLinearAccessIndex(inputIndices, inputStrides);
-    int64_t outputOffset = getLinearAccessIndex(outputIndices, outputStrides);
-    int64_t typeSize = 8; // both double and int64_t have size of 8 bytes.
-    memcpy(resArray + outputOffset * typeSize,
-        inputArray + inputOffset * typeSize, typeSize);
-  }
+  int64_t inputInnerStride = outputRank > 0 ? inputStrides.back() : 0;
+  int64_t innerDim = outputRank > 0 ? outputShape.back() : 1;
+
+  // Both double and int64_t have size of 8 bytes, copy them as int64_t.
+  int64_t *inputArr = reinterpret_cast<int64_t *>(inputArray);
+  int64_t *resArr = reinterpret_cast<int64_t *>(resArray);
+  parallelForRanges(rewriter.getContext(),
+      ShapedType::getNumElements(outputShape),
+      /*alignment=*/innerDim, [&](int64_t begin, int64_t end) {
+        forEachInnermostRun<1>(begin, end, outputShape, {inputStrides},
+            [&](int64_t outputOffset, std::array<int64_t, 1> offsets,
+                int64_t length) {
+              if (inputInnerStride == 1)
+                std::copy_n(
+                    inputArr + offsets[0], length, resArr + outputOffset);
+              else
+                std::fill_n(resArr + outputOffset, length,
+                    inputArr[offsets[0]]);
+            });
+      });
 
   // Construct a new ONNXConstantOp.
   ONNXConstantOp res =
@@ -1054,12 +1133,171 @@ Value ConstPropReshape(
 
   return res.getResult();
 }
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for MatMulOp.
+//===----------------------------------------------------------------------===//
+
+/// Compute the matrix product with numpy semantics. Inputs of rank 1 are
+/// promoted to matrices, and the leading batch dimensions are broadcast.
+template <typename T>
+void IterateConstPropMatMul(MLIRContext *context, char *lhs, char *rhs,
+    ArrayRef<int64_t> lhsShape, ArrayRef<int64_t> rhsShape, char *res) {
+  // Promote 1-D inputs: [K] to [1, K] for lhs and [K] to [K, 1] for rhs.
+  // Removing these unit dimensions from the output does not change its layout.
+  SmallVector<int64_t, 4> lhsDims(lhsShape.begin(), lhsShape.end());
+  SmallVector<int64_t, 4> rhsDims(rhsShape.begin(), rhsShape.end());
+  if (lhsDims.size() == 1)
+    lhsDims.insert(lhsDims.begin(), 1);
+  if (rhsDims.size() == 1)
+    rhsDims.push_back(1);
+  int64_t M = lhsDims[lhsDims.size() - 2];
+  int64_t K = lhsDims.back();
+  int64_t N = rhsDims.back();
+  assert(K == rhsDims[rhsDims.size() - 2] && "Mismatched reduction dims");
+
+  // Broadcast the batch dimensions, counted in matrices.
+  ArrayRef<int64_t> lhsBatch = ArrayRef<int64_t>(lhsDims).drop_back(2);
+  ArrayRef<int64_t> rhsBatch = ArrayRef<int64_t>(rhsDims).drop_back(2);
+  int64_t batchRank = std::max(lhsBatch.size(), rhsBatch.size());
+  SmallVector<int64_t, 4> batchShape(batchRank, 1);
+  for (int64_t i = 0; i < batchRank; ++i) {
+    int64_t l = i - (batchRank - (int64_t)lhsBatch.size());
+    int64_t r = i - (batchRank - (int64_t)rhsBatch.size());
+    if (l >= 0 && lhsBatch[l] != 1)
+      batchShape[i] = lhsBatch[l];
+    if (r >= 0 && rhsBatch[r] != 1)
+      batchShape[i] = rhsBatch[r];
+  }
+  SmallVector<int64_t, 4> lhsBatchStrides =
+      getBroadcastStrides(lhsBatch, batchShape);
+  SmallVector<int64_t, 4> rhsBatchStrides =
+      getBroadcastStrides(rhsBatch, batchShape);
+  int64_t numBatches = ShapedType::getNumElements(batchShape);
+
+  // Data pointers.
+  T *lhsArray = reinterpret_cast<T *>(lhs);
+  T *rhsArray = reinterpret_cast<T *>(rhs);
+  T *resArray = reinterpret_cast<T *>(res);
+
+  // Each output row is computed in the i-k-j order so that the innermost loop
+  // streams over contiguous rows of rhs and of the output. A row takes N * K
+  // multiply-adds, so the product is evaluated in parallel when M * N * K,
+  // summed over the batches, reaches the parallel threshold.
+  parallelForRanges(context, numBatches * M, /*alignment=*/1,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; ++row) {
+          int64_t batch = row / M;
+          int64_t m = row % M;
+          int64_t lhsBatchOffset = 0, rhsBatchOffset = 0;
+          int64_t remainder = batch;
+          for (int64_t k = batchRank - 1; k >= 0; --k) {
+            int64_t index = remainder % batchShape[k];
+            remainder /= batchShape[k];
+            lhsBatchOffset += index * lhsBatchStrides[k];
+            rhsBatchOffset += index * rhsBatchStrides[k];
+          }
+          const T *a = lhsArray + (lhsBatchOffset * M + m) * K;
+          const T *b = rhsArray + rhsBatchOffset * K * N;
+          T *c = resArray + row * N;
+          std::fill_n(c, N, T(0));
+          for (int64_t k = 0; k < K; ++k) {
+            T aValue = a[k];
+            const T *bRow = b + k * N;
+            for (int64_t n = 0; n < N; ++n)
+              c[n] += aValue * bRow[n];
+          }
+        }
+      },
+      /*elementCost=*/std::max<int64_t>(N * K, 1));
+}
+
+/// Do matrix multiplication of 'lhs' and 'rhs' values and create an
+/// ONNXConstantOp for the result.
+Value ConstPropMatMul(
+    PatternRewriter &rewriter, Value replacingValue, Value lhs, Value rhs) {
+  Type elementType = getElementType(replacingValue.getType());
+  ArrayRef<int64_t> lhsShape = lhs.getType().cast<ShapedType>().getShape();
+  ArrayRef<int64_t> rhsShape = rhs.getType().cast<ShapedType>().getShape();
+
+  // Get lhs and rhs values.
+  char *lhsArray = getArrayFromAttributeOrBuffer(rewriter, lhs.getDefiningOp());
+  char *rhsArray = getArrayFromAttributeOrBuffer(rewriter, rhs.getDefiningOp());
+
+  // Do calculation.
+  // Use maximum size (double or int64_t) to avoid the precision loss.
+  char *resArray =
+      allocateBufferFor(replacingValue.getType(), /*useMaxSize=*/true);
+  if (elementType.isa<FloatType>()) {
+    IterateConstPropMatMul<double>(rewriter.getContext(), lhsArray, rhsArray,
+        lhsShape, rhsShape, resArray);
+  } else if (elementType.isa<IntegerType>()) {
+    IterateConstPropMatMul<int64_t>(rewriter.getContext(), lhsArray, rhsArray,
+        lhsShape, rhsShape, resArray);
+  } else
+    llvm_unreachable("Unknown data type");
+
+  // Construct a new ONNXConstantOp.
+  ONNXConstantOp res =
+      createConstantOpAndStoreBufferPtr(rewriter, replacingValue, resArray);
+
+  return res.getResult();
+}
+
 //===----------------------------------------------------------------------===//
 // Pattern definition.
 //===----------------------------------------------------------------------===//
 
 #include "src/Transform/ONNX/ONNXConstProp.inc"
 
+/// Generated pattern folding an op into a constant that may be larger than the
+/// constants it is computed from. The pattern is only applied when the folded
+/// constant stays within the expansion bound of the pass.
+class ExpansionBoundedPattern : public RewritePattern {
+public:
+  ExpansionBoundedPattern(
+      std::unique_ptr<RewritePattern> pattern, int64_t expansionBoundInBytes)
+      : RewritePattern(pattern->getRootKind()->getStringRef(),
+            pattern->getBenefit(), pattern->getContext()),
+        pattern(std::move(pattern)),
+        expansionBoundInBytes(expansionBoundInBytes) {
+    setDebugName(this->pattern->getDebugName());
+    setHasBoundedRewriteRecursion(this->pattern->hasBoundedRewriteRecursion());
+  }
+
+  LogicalResult matchAndRewrite(
+      Operation *op, PatternRewriter &rewriter) const override {
+    // Only folds, whose operands are all constants, are bounded.
+    bool isFold = llvm::all_of(op->getOperands(), [](Value operand) {
+      return isa_and_nonnull<ONNXConstantOp>(operand.getDefiningOp());
+    });
+    if (isFold && op->getNumResults() == 1 &&
+        !isWithinExpansionBound(op->getResult(0), expansionBoundInBytes))
+      return failure();
+    return pattern->matchAndRewrite(op, rewriter);
+  }
+
+  /// Return true for the ops whose folds can create a constant larger than
+  /// their operands.
+  static bool isExpandingFold(const RewritePattern &pattern) {
+    auto rootKind = pattern.getRootKind();
+    if (!rootKind)
+      return false;
+    StringRef name = rootKind->getStringRef();
+    return name == ONNXAddOp::getOperationName() ||
+           name == ONNXSubOp::getOperationName() ||
+           name == ONNXMulOp::getOperationName() ||
+           name == ONNXDivOp::getOperationName() ||
+           name == ONNXExpandOp::getOperationName() ||
+           name == ONNXGatherOp::getOperationName() ||
+           name == ONNXMatMulOp::getOperationName();
+  }
+
+private:
+  std::unique_ptr<RewritePattern> pattern;
+  int64_t expansionBoundInBytes;
+};
+
 //===----------------------------------------------------------------------===//
 // Code to manage the pass.
 //===----------------------------------------------------------------------===//
@@ -1068,6 +1306,14 @@ struct ConstPropONNXToONNXPass
     : public PassWrapper<ConstPropONNXToONNXPass, OperationPass<func::FuncOp>> {
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(ConstPropONNXToONNXPass)
 
+  ConstPropONNXToONNXPass() = default;
+  ConstPropONNXToONNXPass(const ConstPropONNXToONNXPass &pass)
+      : mlir::PassWrapper<ConstPropONNXToONNXPass,
+            OperationPass<func::FuncOp>>() {}
+  ConstPropONNXToONNXPass(int expansionBound) {
+    this->expansionBound = expansionBound;
+  }
+
   StringRef getArgument() const override { return "constprop-onnx"; }
 
   StringRef getDescription() const override {
@@ -1075,6 +1321,12 @@ struct ConstPropONNXToONNXPass
            "other ONNX operations.";
   }
 
+  // Usage: onnx-mlir-opt --constprop-onnx='expansion-bound=1048576'
+  Option<int> expansionBound{*this, "expansion-bound",
+      llvm::cl::desc("Max size in bytes of a folded constant that is larger "
+                     "than its operands (-1 for no bound)"),
+      ::llvm::cl::init(-1)};
+
   void runOnOperation() final;
 };
 } // end anonymous namespace.
@@ -1086,8 +1338,20 @@ void ConstPropONNXToONNXPass::runOnOperation() {
   ConversionTarget target(getContext());
   target.addLegalDialect<ONNXDialect>();
 
+  // The expansion bound is an option of this pass instance, and is given to
+  // the patterns it applies to, since function passes run in parallel.
+  RewritePatternSet generatedPatterns(context);
+  populateWithGenerated(generatedPatterns);
   RewritePatternSet patterns(context);
-  populateWithGenerated(patterns);
+  for (std::unique_ptr<RewritePattern> &pattern :
+      generatedPatterns.getNativePatterns()) {
+    if (expansionBound >= 0 &&
+        ExpansionBoundedPattern::isExpandingFold(*pattern))
+      patterns.add(std::make_unique<ExpansionBoundedPattern>(
+          std::move(pattern), expansionBound));
+    else
+      patterns.add(std::move(pattern));
+  }
   patterns.insert<ConstPropSplitPattern>(&getContext());
   patterns.insert<ConstPropSplitV11Pattern>(&getContext());
   patterns.insert<ConstPropScatterNDPattern>(&getContext());
@@ -1097,16 +1361,24 @@ void ConstPropONNXToONNXPass::runOnOperation() {
   // Create DenseElementsAttr and clean up helper attributes.
   function.walk([&](ONNXConstantOp constOp) {
     Operation *op = constOp.getOperation();
-    if (op->getAttrOfType<::mlir::Attribute>(BUFFER_ID_ATTR)) {
-      ShapedType type = constOp.getResult().getType().cast<ShapedType>();
-      char *arr = allocateBufferFor(type, /*useMaxSize=*/false);
-      getArrayForFinalOutput(op, arr);
-      DenseElementsAttr denseAttr =
-          createDenseElementsAttrFromRawBuffer(type, arr);
-      op->setAttr("value", denseAttr);
-      op->removeAttr(BUFFER_ID_ATTR);
-      free(arr);
+    if (!op->getAttrOfType<::mlir::Attribute>(BUFFER_ID_ATTR))
+      return;
+    // Dense resources were only read into a buffer, and their value did not
+    // change: keep them as resources rather than copying them into the IR.
+    if (auto valueAttr = op->getAttrOfType<::mlir::Attribute>("value")) {
+      if (valueAttr.isa<DenseResourceElementsAttr>()) {
+        op->removeAttr(BUFFER_ID_ATTR);
+        return;
+      }
     }
+    ShapedType type = constOp.getResult().getType().cast<ShapedType>();
+    char *arr = allocateBufferFor(type, /*useMaxSize=*/false);
+    getArrayForFinalOutput(op, arr);
+    DenseElementsAttr denseAttr =
+        createDenseElementsAttrFromRawBuffer(type, arr);
+    op->setAttr("value", denseAttr);
+    op->removeAttr(BUFFER_ID_ATTR);
+    free(arr);
   });
 
   // Remove temporary buffers.
@@ -1120,6 +1392,7 @@ void ConstPropONNXToONNXPass::runOnOperation() {
 /*!
  * Create a ConstPropONNX pass.
  */
-std::unique_ptr<mlir::Pass> onnx_mlir::createConstPropONNXToONNXPass() {
-  return std::make_unique<ConstPropONNXToONNXPass>();
+std::unique_ptr<mlir::Pass> onnx_mlir::createConstPropONNXToONNXPass(
+    int expansionBound) {
+  return std::make_unique<ConstPropONNXToONNXPass>(expansionBound);
 }
@@ -19,6 +19,7 @@
 
 #include "src/Transform/ONNX/ConstPropHelper.hpp"
 #include "src/Dialect/ONNX/ONNXOps/OpHelper.hpp"
+#include "src/Support/FloatingPoint16.hpp"
 #include "src/Support/TypeUtilities.hpp"
 
 using namespace mlir;
@@ -105,6 +106,76 @@ char *createArrayFromDenseElementsAttr(DenseElementsAttr dataAttr) {
   return res;
 }
 
+/// Widen raw, possibly unaligned, data of type T into an array of WideT.
+template <typename T, typename WideT>
+static void widenRawArray(
+    ArrayRef<char> rawData, char *res, int64_t numElements) {
+  assert((int64_t)rawData.size() >= numElements * (int64_t)sizeof(T) &&
+         "Raw data is too small for the number of elements");
+  WideT *resArr = (WideT *)res;
+  for (int64_t i = 0; i < numElements; ++i) {
+    T val;
+    memcpy(&val, rawData.data() + i * sizeof(T), sizeof(T));
+    *(resArr + i) = static_cast<WideT>(val);
+  }
+}
+
+/// Get a data array from a given dense resource attribute, e.g. weights that
+/// are memory mapped from external data.
+char *createArrayFromDenseResourceElementsAttr(
+    DenseResourceElementsAttr dataAttr) {
+  AsmResourceBlob *blob = dataAttr.getRawHandle().getBlob();
+  assert(blob && "Expecting dense resource with a valid blob");
+  ArrayRef<char> rawData = blob->getData();
+  Type elementType = getElementType(dataAttr.getType());
+  int64_t numElements = getNumberOfElements(dataAttr.getType());
+  char *res = allocateBufferFor(dataAttr.getType(), /*useMaxSize=*/true);
+  if (elementType.isa<FloatType>()) {
+    // Use double to avoid the precision loss during computation.
+    if (elementType.isF16())
+      widenRawArray<float_16, double>(rawData, res, numElements);
+    else if (elementType.isBF16())
+      widenRawArray<bfloat_16, double>(rawData, res, numElements);
+    else if (elementType.isF32())
+      widenRawArray<float, double>(rawData, res, numElements);
+    else if (elementType.isF64())
+      widenRawArray<double, double>(rawData, res, numElements);
+    else
+      llvm_unreachable("Unknown data type");
+  } else if (elementType.isa<IntegerType>()) {
+    // Use int64_t to avoid the precision loss during computation.
+    IntegerType intType = elementType.cast<IntegerType>();
+    bool isUnsigned = intType.isUnsigned();
+    switch (intType.getWidth()) {
+    case 8:
+      if (isUnsigned)
+        widenRawArray<uint8_t, int64_t>(rawData, res, numElements);
+      else
+        widenRawArray<int8_t, int64_t>(rawData, res, numElements);
+      break;
+    case 16:
+      if (isUnsigned)
+        widenRawArray<uint16_t, int64_t>(rawData, res, numElements);
+      else
+        widenRawArray<int16_t, int64_t>(rawData, res, numElements);
+      break;
+    case 32:
+      if (isUnsigned)
+        widenRawArray<uint32_t, int64_t>(rawData, res, numElements);
+      else
+        widenRawArray<int32_t, int64_t>(rawData, res, numElements);
+      break;
+    case 64:
+      widenRawArray<int64_t, int64_t>(rawData, res, numElements);
+      break;
+    default:
+      llvm_unreachable("Unknown data type");
+    }
+  } else
+    llvm_unreachable("Unknown data type");
+  return res;
+}
+
 template <typename SRC_TYPE, typename DEST_TYPE>
 void copyAndCastArr(char *srcRawArr, char *destRawArr, int64_t size) {
   SRC_TYPE *srcArr = (SRC_TYPE *)srcRawArr;
@@ -123,7 +194,11 @@ void convertDoubleInt64ToExactType(
 
   if (destElemTy.isa<FloatType>()) {
     FloatType destFloatTy = destElemTy.cast<FloatType>();
-    if (destFloatTy.getWidth() == 32) // to f32
+    if (destFloatTy.isF16()) // to f16
+      copyAndCastArr<double, float_16>(srcRawArr, destRawArr, numElements);
+    else if (destFloatTy.isBF16()) // to bf16
+      copyAndCastArr<double, bfloat_16>(srcRawArr, destRawArr, numElements);
+    else if (destFloatTy.getWidth() == 32) // to f32
       copyAndCastArr<double, float>(srcRawArr, destRawArr, numElements);
     else if (destFloatTy.getWidth() == 64) // to f64
       copyAndCastArr<double, double>(srcRawArr, destRawArr, numElements);
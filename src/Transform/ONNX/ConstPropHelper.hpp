@@ -52,6 +52,11 @@ char *allocateBufferFor(mlir::Type type, bool useMaxSize = false);
 /// Get a data array from a given ONNXConstantOp.
 char *createArrayFromDenseElementsAttr(mlir::DenseElementsAttr dataAttr);
 
+/// Get a data array from a given dense resource attribute, e.g. weights that
+/// are memory mapped from external data.
+char *createArrayFromDenseResourceElementsAttr(
+    mlir::DenseResourceElementsAttr dataAttr);
+
 /// Copy and cast an array of a type to another array of another type.
 /// It simply uses C++ type casting. Users must take care about precision loss.
 template <typename SRC_TYPE, typename DEST_TYPE>
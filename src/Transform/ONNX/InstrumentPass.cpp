@@ -26,6 +26,7 @@
 
 #include "src/Compiler/CompilerOptions.hpp"
 #include "src/Dialect/Krnl/KrnlOps.hpp"
+#include "src/Dialect/ONNX/ONNXOps.hpp"
 #include "src/Interface/ShapeInferenceOpInterface.hpp"
 #include "src/Pass/Passes.hpp"
 
@@ -33,6 +34,58 @@ using namespace mlir;
 
 namespace onnx_mlir {
 
+namespace {
+
+/// Return the number of elements of 'value' if it has a static shape, and -1
+/// otherwise.
+int64_t getStaticNumElements(Value value) {
+  auto type = value.getType().dyn_cast<ShapedType>();
+  if (!type || !type.hasStaticShape())
+    return -1;
+  return type.getNumElements();
+}
+
+/// Return the number of floating point operations of 'op' estimated from its
+/// static shapes, or 0 if unknown. Only the ops that dominate the run time of
+/// most models, MatMul, Gemm and Conv, are estimated.
+int64_t estimateFlops(Operation *op) {
+  // Terminators such as onnx.Return and onnx.Yield have no result.
+  if (op->getNumResults() == 0)
+    return 0;
+  int64_t outputSize = getStaticNumElements(op->getResult(0));
+  if (outputSize < 0)
+    return 0;
+  if (auto matMulOp = dyn_cast<ONNXMatMulOp>(op)) {
+    auto aType = matMulOp.A().getType().dyn_cast<ShapedType>();
+    if (!aType || !aType.hasRank() || aType.getRank() == 0 ||
+        aType.isDynamicDim(aType.getRank() - 1))
+      return 0;
+    return 2 * outputSize * aType.getShape()[aType.getRank() - 1];
+  }
+  if (auto gemmOp = dyn_cast<ONNXGemmOp>(op)) {
+    auto aType = gemmOp.A().getType().dyn_cast<ShapedType>();
+    if (!aType || !aType.hasRank() || aType.getRank() != 2)
+      return 0;
+    int64_t K = aType.getShape()[gemmOp.transA() ? 0 : 1];
+    if (ShapedType::isDynamic(K))
+      return 0;
+    // Multiply-adds, plus the scaling and the bias.
+    return 2 * outputSize * K + 2 * outputSize;
+  }
+  if (auto convOp = dyn_cast<ONNXConvOp>(op)) {
+    // Each output element is a dot product of size C/group * kernel size, the
+    // product of the dimensions of W but the first.
+    int64_t wSize = getStaticNumElements(convOp.W());
+    auto wType = convOp.W().getType().dyn_cast<ShapedType>();
+    if (wSize <= 0)
+      return 0;
+    return 2 * outputSize * (wSize / wType.getShape()[0]);
+  }
+  return 0;
+}
+
+} // namespace
+
 /*!
  * This pass insert KrnlInstrumentOp before and after each ops
  */
@@ -65,6 +118,11 @@ public:
       llvm::cl::desc("instrument runtime reports memory usage"),
       llvm::cl::init(false)};
 
+  Option<bool> reportCounters{*this, "report-counters",
+      llvm::cl::desc("instrument runtime reports hardware performance "
+                     "counters"),
+      llvm::cl::init(false)};
+
   InstrumentPass() = default;
   InstrumentPass(const InstrumentPass &pass)
       : mlir::PassWrapper<InstrumentPass, OperationPass<func::FuncOp>>() {}
@@ -74,6 +132,8 @@ public:
     this->instrumentAfter = actions & (1 << onnx_mlir::InstrumentAfterOp);
     this->reportTime = actions & (1 << onnx_mlir::InstrumentReportTime);
     this->reportMemory = actions & (1 << onnx_mlir::InstrumentReportMemory);
+    this->reportCounters =
+        actions & (1 << onnx_mlir::InstrumentReportCounters);
   }
 
 private:
@@ -109,6 +169,8 @@ public:
       tag |= 1 << onnx_mlir::InstrumentReportTime;
     if (reportMemory)
       tag |= 1 << onnx_mlir::InstrumentReportMemory;
+    if (reportCounters)
+      tag |= 1 << onnx_mlir::InstrumentReportCounters;
     return tag;
   }
 
@@ -119,6 +181,12 @@ public:
     return actions() & (~(1 << onnx_mlir::InstrumentBeforeOp));
   }
 
+  // The bits of the tag above the actions hold the FLOP estimate of the op,
+  // which the runtime uses in its profile report.
+  int64_t flopsTag(Operation *op) const {
+    return estimateFlops(op) << InstrumentFlopsShift;
+  }
+
   void runOnOperation() override {
     if (instrumentOps == "" || instrumentOps == "NONE")
       return;
@@ -133,12 +201,14 @@ public:
           Location loc = op->getLoc();
           OpBuilder opBuilder(op);
           if (instrumentBefore)
-            opBuilder.create<mlir::KrnlInstrumentOp>(loc, op, beforeTag());
+            opBuilder.create<mlir::KrnlInstrumentOp>(
+                loc, op, beforeTag() | flopsTag(op));
 
           // Can not insert after Op (e.g. ONNXReturnOP) with IsTerminator Trait
           if (instrumentAfter && !op->hasTrait<OpTrait::IsTerminator>()) {
             opBuilder.setInsertionPointAfter(op);
-            opBuilder.create<mlir::KrnlInstrumentOp>(loc, op, afterTag());
+            opBuilder.create<mlir::KrnlInstrumentOp>(
+                loc, op, afterTag() | flopsTag(op));
           }
         }
       }
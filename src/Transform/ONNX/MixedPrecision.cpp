@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------- MixedPrecision.cpp - Compute f32 ops in bf16 -----------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file implements a pass that rewrites selected f32 ops of a model to
+// compute in bf16, e.g.
+//
+//   %y = MatMul(%x, %w) : (f32, f32) -> f32
+//
+// into
+//
+//   %xb = Cast(%x) {to = bf16}
+//   %wb = Cast(%w) {to = bf16}
+//   %yb = MatMul(%xb, %wb) : (bf16, bf16) -> bf16
+//   %y = Cast(%yb) {to = f32}
+//
+// Casts of constant weights are folded by the constant propagation pass, and
+// back to back casts between two converted ops are removed by canonicalization
+// so that activations flow in bf16 between them.
+//
+// Only ops that are both bandwidth bound on weights or activations and
+// insensitive to the loss of mantissa bits are converted. Reductions, Softmax
+// and normalization ops always stay in f32, whatever the op list says.
+//
+//===----------------------------------------------------------------------===//
+
+#include <regex>
+
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "src/Dialect/ONNX/DialectBuilder.hpp"
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Pass/Passes.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+namespace {
+
+/// Ops converted when the op list has no allowed entry.
+const char *defaultMixedPrecisionOps = "onnx.MatMul,onnx.Gemm,onnx.Conv";
+
+/// Return true if 'op' may compute in bf16. This is the accuracy guard of the
+/// pass: reductions, Softmax and normalizations are not listed so that they
+/// keep accumulating in f32.
+bool canComputeInBF16(Operation *op) {
+  return isa<ONNXMatMulOp, ONNXGemmOp, ONNXConvOp, ONNXAddOp, ONNXSubOp,
+      ONNXMulOp, ONNXDivOp, ONNXReluOp, ONNXLeakyReluOp, ONNXSigmoidOp,
+      ONNXTanhOp>(op);
+}
+
+/// Return true if 'value' is a tensor of f32.
+bool isF32Tensor(Value value) {
+  auto type = value.getType().dyn_cast<TensorType>();
+  return type && type.getElementType().isF32();
+}
+
+/// Return 'type' with a bf16 element type.
+Type getBF16TensorType(Type type) {
+  TensorType tensorType = type.cast<TensorType>();
+  Type bf16 = FloatType::getBF16(type.getContext());
+  if (tensorType.hasRank())
+    return RankedTensorType::get(tensorType.getShape(), bf16);
+  return UnrankedTensorType::get(bf16);
+}
+
+struct MixedPrecisionONNXToONNXPass
+    : public PassWrapper<MixedPrecisionONNXToONNXPass,
+          OperationPass<func::FuncOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(MixedPrecisionONNXToONNXPass)
+
+  MixedPrecisionONNXToONNXPass() = default;
+  MixedPrecisionONNXToONNXPass(const MixedPrecisionONNXToONNXPass &pass)
+      : mlir::PassWrapper<MixedPrecisionONNXToONNXPass,
+            OperationPass<func::FuncOp>>() {}
+  MixedPrecisionONNXToONNXPass(const std::string &ops) { this->ops = ops; }
+
+  StringRef getArgument() const override { return "mixed-precision-onnx"; }
+
+  StringRef getDescription() const override {
+    return "Compute selected f32 ops in bf16 by inserting Cast ops around "
+           "them.";
+  }
+
+  // Usage: onnx-mlir-opt --mixed-precision-onnx='ops=onnx.*,!onnx.Conv'
+  Option<std::string> ops{*this, "ops",
+      llvm::cl::desc("Comma separated list of ops to compute in bf16. An "
+                     "entry matches an op name (e.g. onnx.MatMul) or an "
+                     "onnx_node_name, '*' matches any string, and entries "
+                     "prefixed with '!' are kept in f32. The default list "
+                     "onnx.MatMul,onnx.Gemm,onnx.Conv is used when there is "
+                     "no allowed entry"),
+      ::llvm::cl::init("")};
+
+  void runOnOperation() final;
+
+private:
+  void init();
+  bool isSelected(Operation *op) const;
+  void convertToBF16(Operation *op);
+
+  SmallVector<std::regex, 4> allowedOps;
+  SmallVector<std::regex, 4> deniedOps;
+};
+
+// Parse the op list with the same syntax as --instrument-ops, where '.' is a
+// normal character and '*' a wildcard.
+void MixedPrecisionONNXToONNXPass::init() {
+  auto parse = [&](StringRef list) {
+    SmallVector<StringRef, 4> entries;
+    list.split(entries, ',', -1, false);
+    for (StringRef entry : entries) {
+      entry = entry.trim();
+      bool denied = entry.consume_front("!");
+      std::string re = std::regex_replace(
+          entry.str(), std::regex("\\."), "\\.");
+      re = std::regex_replace(re, std::regex("\\*"), ".*");
+      (denied ? deniedOps : allowedOps).emplace_back(re);
+    }
+  };
+  allowedOps.clear();
+  deniedOps.clear();
+  parse(ops);
+  if (allowedOps.empty())
+    parse(defaultMixedPrecisionOps);
+}
+
+bool MixedPrecisionONNXToONNXPass::isSelected(Operation *op) const {
+  std::string opName = op->getName().getStringRef().str();
+  std::string nodeName;
+  if (auto nodeNameAttr = op->getAttrOfType<StringAttr>("onnx_node_name"))
+    nodeName = nodeNameAttr.getValue().str();
+  auto matches = [&](const std::regex &re) {
+    return std::regex_match(opName, re) ||
+           (!nodeName.empty() && std::regex_match(nodeName, re));
+  };
+  return llvm::any_of(allowedOps, matches) &&
+         llvm::none_of(deniedOps, matches);
+}
+
+void MixedPrecisionONNXToONNXPass::convertToBF16(Operation *op) {
+  OpBuilder builder(op);
+  OnnxBuilder create(builder, op->getLoc());
+  TypeAttr bf16 = TypeAttr::get(builder.getBF16Type());
+  TypeAttr f32 = TypeAttr::get(builder.getF32Type());
+
+  for (OpOperand &operand : op->getOpOperands())
+    if (isF32Tensor(operand.get()))
+      operand.set(create.cast(operand.get(), bf16));
+
+  builder.setInsertionPointAfter(op);
+  for (Value res : op->getResults()) {
+    if (!isF32Tensor(res))
+      continue;
+    res.setType(getBF16TensorType(res.getType()));
+    Value castBack = create.cast(res, f32);
+    res.replaceAllUsesExcept(castBack, castBack.getDefiningOp());
+  }
+}
+
+void MixedPrecisionONNXToONNXPass::runOnOperation() {
+  init();
+
+  // Select the ops first, since converting an op inserts new ones.
+  SmallVector<Operation *, 32> selectedOps;
+  getOperation().walk([&](Operation *op) {
+    if (!canComputeInBF16(op) || !isSelected(op))
+      return;
+    // Ops with f32 results and operands only, so that integer and already
+    // reduced precision ops are left untouched.
+    auto isF32OrNone = [](Value v) {
+      return isF32Tensor(v) || v.getType().isa<NoneType>();
+    };
+    if (llvm::all_of(op->getOperands(), isF32OrNone) &&
+        llvm::all_of(op->getResults(), isF32Tensor))
+      selectedOps.emplace_back(op);
+  });
+
+  for (Operation *op : selectedOps)
+    convertToBF16(op);
+}
+
+} // namespace
+
+/*!
+ * Create a MixedPrecisionONNX pass.
+ */
+std::unique_ptr<mlir::Pass> createMixedPrecisionONNXToONNXPass(
+    const std::string &ops) {
+  return std::make_unique<MixedPrecisionONNXToONNXPass>(ops);
+}
+
+} // namespace onnx_mlir
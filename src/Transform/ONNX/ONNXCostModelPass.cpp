@@ -0,0 +1,369 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------- ONNXCostModelPass.cpp - Report the cost of ONNX ops ----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file implements an analysis pass that reports, per node and per
+// function, the floating point operations, the bytes read and written, and the
+// arithmetic intensity of a model, as JSON.
+//
+// Dynamic dimensions are named after the model input they are equal to, e.g.
+// "input_ids[0]", using the dimension analysis, so that counts are reported as
+// polynomials such as "1536*input_ids[0]*input_ids[1]".
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Dialect/ONNX/ONNXOps/OpHelper.hpp"
+#include "src/Pass/Passes.hpp"
+#include "src/Transform/ONNX/ONNXDimAnalysis.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+namespace {
+
+/// A count that is a polynomial of the dynamic dimensions of a model, e.g.
+/// 2 * batch * 768.
+class SymbolicCount {
+public:
+  SymbolicCount(int64_t value = 0) {
+    if (value != 0)
+      terms[{}] = value;
+  }
+
+  static SymbolicCount symbol(StringRef name) {
+    SymbolicCount count;
+    count.terms[{name.str()}] = 1;
+    return count;
+  }
+
+  SymbolicCount operator+(const SymbolicCount &other) const {
+    SymbolicCount sum = *this;
+    for (const auto &term : other.terms)
+      sum.addTerm(term.first, term.second);
+    return sum;
+  }
+
+  SymbolicCount operator*(const SymbolicCount &other) const {
+    SymbolicCount product;
+    for (const auto &lhs : terms)
+      for (const auto &rhs : other.terms) {
+        Monomial monomial = lhs.first;
+        monomial.insert(monomial.end(), rhs.first.begin(), rhs.first.end());
+        llvm::sort(monomial);
+        product.addTerm(monomial, lhs.second * rhs.second);
+      }
+    return product;
+  }
+
+  bool isConstant() const {
+    return terms.empty() || (terms.size() == 1 && terms.begin()->first.empty());
+  }
+
+  int64_t getConstant() const {
+    assert(isConstant() && "expected a constant count");
+    return terms.empty() ? 0 : terms.begin()->second;
+  }
+
+  /// Print the count with its highest degree terms first, e.g.
+  /// "2*N*S*S + 1536*N*S".
+  std::string str() const {
+    std::string result;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+      if (!result.empty())
+        result += " + ";
+      if (it->second != 1 || it->first.empty())
+        result += std::to_string(it->second) + (it->first.empty() ? "" : "*");
+      result += llvm::join(it->first, "*");
+    }
+    return result.empty() ? "0" : result;
+  }
+
+  llvm::json::Value toJSON() const {
+    if (isConstant())
+      return getConstant();
+    return str();
+  }
+
+private:
+  // Sorted list of the symbols of a term.
+  using Monomial = std::vector<std::string>;
+
+  void addTerm(const Monomial &monomial, int64_t coefficient) {
+    int64_t &sum = terms[monomial];
+    sum += coefficient;
+    if (sum == 0)
+      terms.erase(monomial);
+  }
+
+  // Terms are ordered by their monomials, so that the constant comes first.
+  std::map<Monomial, int64_t> terms;
+};
+
+/// FLOPs, bytes read and bytes written of an op.
+struct OpCost {
+  SymbolicCount flops;
+  SymbolicCount inputBytes;
+  SymbolicCount outputBytes;
+};
+
+struct ONNXCostModelPass
+    : public PassWrapper<ONNXCostModelPass, OperationPass<ModuleOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(ONNXCostModelPass)
+
+  StringRef getArgument() const override { return "onnx-cost-model"; }
+
+  StringRef getDescription() const override {
+    return "Report the FLOPs, bytes moved and arithmetic intensity of ONNX "
+           "ops, per node and per function, as JSON.";
+  }
+
+  void runOnOperation() final;
+
+private:
+  void nameDynamicDims(func::FuncOp function);
+  SymbolicCount getDim(Value value, int64_t axis);
+  SymbolicCount getNumElements(Value value);
+  SymbolicCount getNumElements(Value value, int64_t fromAxis);
+  SymbolicCount getBytes(Value value);
+  SymbolicCount getFlops(Operation *op);
+  OpCost getCost(Operation *op);
+
+  // Name of the dynamic dimensions, identified by their tensor and axis.
+  llvm::DenseMap<std::pair<Value, int64_t>, std::string> dimNames;
+};
+
+// Name the dynamic dimensions that are found equal by the dimension analysis
+// after the same function input dimension, or after their set otherwise.
+void ONNXCostModelPass::nameDynamicDims(func::FuncOp function) {
+  SmallVector<Value, 32> values(
+      function.getArguments().begin(), function.getArguments().end());
+  function.walk([&](Operation *op) {
+    for (Value res : op->getResults())
+      values.emplace_back(res);
+  });
+  DimAnalysis dimAnalysis(values);
+  dimAnalysis.analyze();
+
+  auto inputNames = function->getAttrOfType<ArrayAttr>("input_names");
+  dimNames.clear();
+  for (const auto &dimSet : dimAnalysis.getGroupingResult()) {
+    std::string name = "d" + std::to_string(dimSet.first);
+    unsigned bestArg = function.getNumArguments();
+    for (const DimAnalysis::DimT &dim : dimSet.second) {
+      auto arg = dim.first.dyn_cast<BlockArgument>();
+      if (!arg || arg.getOwner()->getParentOp() != function ||
+          arg.getArgNumber() >= bestArg)
+        continue;
+      bestArg = arg.getArgNumber();
+      std::string argName = "arg" + std::to_string(bestArg);
+      if (inputNames && bestArg < inputNames.size())
+        argName = inputNames[bestArg].cast<StringAttr>().str();
+      name = argName + "[" + std::to_string(dim.second) + "]";
+    }
+    for (const DimAnalysis::DimT &dim : dimSet.second)
+      dimNames[{dim.first, (int64_t)dim.second}] = name;
+  }
+}
+
+SymbolicCount ONNXCostModelPass::getDim(Value value, int64_t axis) {
+  auto type = value.getType().cast<ShapedType>();
+  if (!type.isDynamicDim(axis))
+    return type.getShape()[axis];
+  auto it = dimNames.find({value, axis});
+  if (it != dimNames.end())
+    return SymbolicCount::symbol(it->second);
+  return SymbolicCount::symbol("?");
+}
+
+// Number of elements of the dimensions of 'value' from 'fromAxis'.
+SymbolicCount ONNXCostModelPass::getNumElements(Value value, int64_t fromAxis) {
+  auto type = value.getType().dyn_cast<ShapedType>();
+  if (!type)
+    return 0;
+  if (!type.hasRank())
+    return SymbolicCount::symbol("?");
+  SymbolicCount numElements = 1;
+  for (int64_t i = fromAxis; i < type.getRank(); ++i)
+    numElements = numElements * getDim(value, i);
+  return numElements;
+}
+
+SymbolicCount ONNXCostModelPass::getNumElements(Value value) {
+  return getNumElements(value, 0);
+}
+
+SymbolicCount ONNXCostModelPass::getBytes(Value value) {
+  auto type = value.getType().dyn_cast<ShapedType>();
+  if (!type || isFromNone(value))
+    return 0;
+  Type elementType = type.getElementType();
+  if (!elementType.isIntOrFloat())
+    return 0;
+  return getNumElements(value) *
+         SymbolicCount((elementType.getIntOrFloatBitWidth() + 7) / 8);
+}
+
+// Estimate the floating point operations of the ops that compute, counting a
+// multiply-add as two operations. Data movement ops have no FLOPs.
+SymbolicCount ONNXCostModelPass::getFlops(Operation *op) {
+  Value output = op->getResult(0);
+  SymbolicCount outputSize = getNumElements(output);
+  if (auto matMulOp = dyn_cast<ONNXMatMulOp>(op)) {
+    auto aType = matMulOp.A().getType().dyn_cast<ShapedType>();
+    if (!aType || !aType.hasRank() || aType.getRank() == 0)
+      return SymbolicCount::symbol("?");
+    return SymbolicCount(2) * outputSize *
+           getDim(matMulOp.A(), aType.getRank() - 1);
+  }
+  if (auto gemmOp = dyn_cast<ONNXGemmOp>(op)) {
+    auto aType = gemmOp.A().getType().dyn_cast<ShapedType>();
+    if (!aType || !aType.hasRank() || aType.getRank() != 2)
+      return SymbolicCount::symbol("?");
+    SymbolicCount K = getDim(gemmOp.A(), gemmOp.transA() ? 0 : 1);
+    // Multiply-adds, plus the scaling and the bias.
+    return SymbolicCount(2) * outputSize * K + SymbolicCount(2) * outputSize;
+  }
+  if (auto convOp = dyn_cast<ONNXConvOp>(op)) {
+    // Each output element is a dot product of size C/group * kernel size.
+    SymbolicCount flops =
+        SymbolicCount(2) * outputSize * getNumElements(convOp.W(), 1);
+    if (!isFromNone(convOp.B()))
+      flops = flops + outputSize;
+    return flops;
+  }
+  if (isa<ONNXMaxPoolSingleOutOp, ONNXAveragePoolOp>(op)) {
+    auto kernelShape = op->getAttrOfType<ArrayAttr>("kernel_shape");
+    if (!kernelShape)
+      return SymbolicCount::symbol("?");
+    int64_t kernelSize = 1;
+    for (Attribute dim : kernelShape)
+      kernelSize *= dim.cast<IntegerAttr>().getInt();
+    return outputSize * SymbolicCount(kernelSize);
+  }
+  // One operation per input element.
+  if (isa<ONNXReduceSumOp, ONNXReduceSumV11Op, ONNXReduceMeanOp,
+          ONNXReduceMaxOp, ONNXReduceMinOp, ONNXReduceProdOp,
+          ONNXReduceL1Op, ONNXReduceL2Op, ONNXReduceSumSquareOp,
+          ONNXGlobalAveragePoolOp, ONNXGlobalMaxPoolOp>(op))
+    return getNumElements(op->getOperand(0));
+  // Max, subtract, exp, sum and divide per element.
+  if (isa<ONNXSoftmaxOp, ONNXLogSoftmaxOp>(op))
+    return SymbolicCount(5) * outputSize;
+  // Mean, variance, normalization, scale and bias per element.
+  if (isa<ONNXLayerNormalizationOp, ONNXInstanceNormalizationOp>(op))
+    return SymbolicCount(8) * outputSize;
+  if (isa<ONNXBatchNormalizationInferenceModeOp>(op))
+    return SymbolicCount(2) * outputSize;
+  // Elementwise ops with one operation per output element and input.
+  if (isa<ONNXAddOp, ONNXSubOp, ONNXMulOp, ONNXDivOp, ONNXPowOp, ONNXMaxOp,
+          ONNXMinOp, ONNXSumOp, ONNXMeanOp>(op))
+    return outputSize * SymbolicCount(std::max<int64_t>(
+                            op->getNumOperands() - 1, 1));
+  if (isa<ONNXReluOp, ONNXLeakyReluOp, ONNXSigmoidOp, ONNXTanhOp, ONNXExpOp,
+          ONNXLogOp, ONNXSqrtOp, ONNXErfOp, ONNXNegOp, ONNXAbsOp, ONNXClipOp,
+          ONNXHardSigmoidOp, ONNXSoftplusOp, ONNXEluOp, ONNXSeluOp,
+          ONNXReciprocalOp>(op))
+    return outputSize;
+  return 0;
+}
+
+OpCost ONNXCostModelPass::getCost(Operation *op) {
+  OpCost cost;
+  cost.flops = getFlops(op);
+  for (Value operand : op->getOperands())
+    cost.inputBytes = cost.inputBytes + getBytes(operand);
+  for (Value res : op->getResults())
+    cost.outputBytes = cost.outputBytes + getBytes(res);
+  return cost;
+}
+
+/// Return the FLOPs per byte moved when the counts are constant.
+llvm::json::Value getArithmeticIntensity(const OpCost &cost) {
+  SymbolicCount bytes = cost.inputBytes + cost.outputBytes;
+  if (!cost.flops.isConstant() || !bytes.isConstant() ||
+      bytes.getConstant() == 0)
+    return nullptr;
+  return (double)cost.flops.getConstant() / bytes.getConstant();
+}
+
+llvm::json::Object toJSON(const OpCost &cost) {
+  return llvm::json::Object{{"flops", cost.flops.toJSON()},
+      {"inputBytes", cost.inputBytes.toJSON()},
+      {"outputBytes", cost.outputBytes.toJSON()},
+      {"arithmeticIntensity", getArithmeticIntensity(cost)}};
+}
+
+void ONNXCostModelPass::runOnOperation() {
+  llvm::json::Array functions;
+  getOperation().walk([&](func::FuncOp function) {
+    nameDynamicDims(function);
+    llvm::json::Array nodes;
+    OpCost total;
+    SymbolicCount weightBytes;
+    function.walk([&](Operation *op) {
+      if (!isa<ONNXDialect>(op->getDialect()) || op->getNumResults() == 0)
+        return;
+      // Constants are the weights read by the ops that use them.
+      if (isa<ONNXConstantOp>(op)) {
+        weightBytes = weightBytes + getBytes(op->getResult(0));
+        return;
+      }
+      if (isa<ONNXNoneOp>(op))
+        return;
+      OpCost cost = getCost(op);
+      total.flops = total.flops + cost.flops;
+      total.inputBytes = total.inputBytes + cost.inputBytes;
+      total.outputBytes = total.outputBytes + cost.outputBytes;
+      llvm::json::Object node = toJSON(cost);
+      node["op"] = op->getName().getStringRef();
+      if (auto nodeName = op->getAttrOfType<StringAttr>("onnx_node_name"))
+        node["node"] = nodeName.getValue();
+      std::string location;
+      llvm::raw_string_ostream locOS(location);
+      op->getLoc().print(locOS);
+      node["location"] = locOS.str();
+      nodes.push_back(std::move(node));
+    });
+    llvm::json::Object totalJSON = toJSON(total);
+    totalJSON["weightBytes"] = weightBytes.toJSON();
+    functions.push_back(llvm::json::Object{{"function", function.getName()},
+        {"total", std::move(totalJSON)}, {"nodes", std::move(nodes)}});
+  });
+  llvm::outs() << llvm::formatv("{0:2}",
+                      llvm::json::Value(llvm::json::Object{
+                          {"Cost model", std::move(functions)}}))
+               << "\n";
+  markAllAnalysesPreserved();
+}
+
+} // namespace
+
+/*!
+ * Create an ONNXCostModel pass.
+ */
+std::unique_ptr<mlir::Pass> createONNXCostModelPass() {
+  return std::make_unique<ONNXCostModelPass>();
+}
+
+} // namespace onnx_mlir
@@ -46,17 +46,23 @@ struct ONNXOpTransformPass : public mlir::PassWrapper<ONNXOpTransformPass,
       "onnx-op-transform-simd-data-layout",
       llvm::cl::desc("Enable SIMD data layout opt in op transform passes."),
       llvm::cl::init(false)};
+  Option<int> onnxConstPropExpansionBound{*this,
+      "onnx-op-transform-const-prop-expansion-bound",
+      llvm::cl::desc("Expansion bound for constant propagation in op "
+                     "transform passes."),
+      llvm::cl::init(-1)};
 
   ONNXOpTransformPass() = default;
   ONNXOpTransformPass(const ONNXOpTransformPass &pass)
       : mlir::PassWrapper<ONNXOpTransformPass,
             OperationPass<mlir::ModuleOp>>() {}
   ONNXOpTransformPass(int threshold, bool report, bool targetCPU,
-      bool enableSimdDataLayoutOpt) {
+      bool enableSimdDataLayoutOpt, int constPropExpansionBound) {
     this->onnxOpTransformThreshold = threshold;
     this->onnxOpTransformReport = report;
     this->onnxOpTransformTargetCPU = targetCPU;
     this->onnxOpTransformEnableSimdDataLayout = enableSimdDataLayoutOpt;
+    this->onnxConstPropExpansionBound = constPropExpansionBound;
   }
 
   void runOnOperation() final;
@@ -98,7 +104,7 @@ void ONNXOpTransformPass::runOnOperation() {
       dynamicPM.addPass(onnx_mlir::createShapeInferencePass());
     }
     dynamicPM.addNestedPass<func::FuncOp>(
-        onnx_mlir::createConstPropONNXToONNXPass());
+        onnx_mlir::createConstPropONNXToONNXPass(onnxConstPropExpansionBound));
     if (failed(runPipeline(dynamicPM, module)))
       return signalPassFailure();
     currentTag = createTagForIR(module);
@@ -126,7 +132,8 @@ std::unique_ptr<mlir::Pass> onnx_mlir::createONNXOpTransformPass() {
 }
 
 std::unique_ptr<mlir::Pass> onnx_mlir::createONNXOpTransformPass(
-    int threshold, bool report, bool targetCPU, bool enableSimdDataLayoutOpt) {
-  return std::make_unique<ONNXOpTransformPass>(
-      threshold, report, targetCPU, enableSimdDataLayoutOpt);
+    int threshold, bool report, bool targetCPU, bool enableSimdDataLayoutOpt,
+    int constPropExpansionBound) {
+  return std::make_unique<ONNXOpTransformPass>(threshold, report, targetCPU,
+      enableSimdDataLayoutOpt, constPropExpansionBound);
 }
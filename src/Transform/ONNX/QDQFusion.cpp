@@ -0,0 +1,309 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------- QDQFusion.cpp - Fuse QDQ islands into ONNX ops ---------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file implements a pass that rewrites the QDQ islands exported by
+// quantization tools, e.g.
+//
+//   %a = DequantizeLinear(%qa, %a_scale, %a_zero_point)
+//   %b = DequantizeLinear(%qb, %b_scale, %b_zero_point)
+//   %c = MatMul(%a, %b)
+//   %y = QuantizeLinear(%c, %y_scale, %y_zero_point)
+//
+// into integer compute ops, here
+//
+//   %y = QLinearMatMul(%qa, %a_scale, %a_zero_point, %qb, %b_scale,
+//            %b_zero_point, %y_scale, %y_zero_point)
+//
+// so that no float tensor is materialized. Islands that cannot be fused are
+// optionally reported, so that the exports can be fixed.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Dialect/ONNX/ONNXOps/OpHelper.hpp"
+#include "src/Pass/Passes.hpp"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+
+namespace {
+
+/// Return true if the scale or zero point 'param' applies to the whole tensor.
+bool isPerTensorParam(Value param) {
+  if (isFromNone(param))
+    return true;
+  ShapedType type = param.getType().dyn_cast<ShapedType>();
+  if (!type || !type.hasRank())
+    return false;
+  return type.getRank() == 0 ||
+         (type.getRank() == 1 && type.getShape()[0] == 1);
+}
+
+/// Return true if the scale or zero point 'param' of a DequantizeLinear op is
+/// per tensor, or per column of a 2-D input.
+bool isPerTensorOrColumnParam(ONNXDequantizeLinearOp dqOp, Value param) {
+  if (isPerTensorParam(param))
+    return true;
+  ShapedType xType = dqOp.x().getType().dyn_cast<ShapedType>();
+  ShapedType type = param.getType().dyn_cast<ShapedType>();
+  if (!xType || !xType.hasRank() || xType.getRank() != 2 || !type ||
+      !type.hasRank() || type.getRank() != 1)
+    return false;
+  int64_t axis = dqOp.axis();
+  return axis == 1 || axis == -1;
+}
+
+/// Return the DequantizeLinear op producing 'value' from an i8 or ui8 tensor
+/// and set 'reason' otherwise.
+ONNXDequantizeLinearOp getInt8Dequantize(
+    Value value, StringRef name, std::string &reason) {
+  auto dqOp = value.getDefiningOp<ONNXDequantizeLinearOp>();
+  if (!dqOp) {
+    reason = (name + " is not produced by DequantizeLinear").str();
+    return nullptr;
+  }
+  Type elementType = getElementType(dqOp.x().getType());
+  if (!elementType.isInteger(8)) {
+    reason = (name + " is not dequantized from i8 or ui8").str();
+    return nullptr;
+  }
+  return dqOp;
+}
+
+/// Return the operands of a QLinearMatMul computing the QDQ island made of
+/// the MatMul or Gemm 'op' and its quantized result 'qOp', or set 'reason'
+/// and return false when the island cannot be fused.
+bool matchQLinearMatMulIsland(Operation *op, ONNXQuantizeLinearOp qOp,
+    ONNXDequantizeLinearOp &aOp, ONNXDequantizeLinearOp &bOp,
+    std::string &reason) {
+  Value A, B;
+  if (auto matMulOp = dyn_cast<ONNXMatMulOp>(op)) {
+    A = matMulOp.A();
+    B = matMulOp.B();
+  } else if (auto gemmOp = dyn_cast<ONNXGemmOp>(op)) {
+    if (!isFromNone(gemmOp.C())) {
+      reason = "Gemm has a bias";
+      return false;
+    }
+    if (gemmOp.transA() != 0 || gemmOp.transB() != 0) {
+      reason = "Gemm transposes its operands";
+      return false;
+    }
+    if (gemmOp.alpha().convertToFloat() != 1.0) {
+      reason = "Gemm scales its product";
+      return false;
+    }
+    A = gemmOp.A();
+    B = gemmOp.B();
+  } else {
+    reason = "there is no integer operation for " +
+             op->getName().getStringRef().str();
+    return false;
+  }
+
+  if (!qOp) {
+    reason = "result is not quantized by a QuantizeLinear op";
+    return false;
+  }
+  if (!op->getResult(0).hasOneUse()) {
+    reason = "float result has other uses than QuantizeLinear";
+    return false;
+  }
+  if (!(aOp = getInt8Dequantize(A, "A", reason)) ||
+      !(bOp = getInt8Dequantize(B, "B", reason)))
+    return false;
+  if (!isPerTensorParam(aOp.x_scale()) ||
+      !isPerTensorParam(aOp.x_zero_point())) {
+    reason = "A is not quantized per tensor";
+    return false;
+  }
+  if (!isPerTensorOrColumnParam(bOp, bOp.x_scale()) ||
+      !isPerTensorOrColumnParam(bOp, bOp.x_zero_point())) {
+    reason = "B is not quantized per tensor or per column";
+    return false;
+  }
+  if (!isPerTensorParam(qOp.y_scale()) ||
+      !isPerTensorParam(qOp.y_zero_point())) {
+    reason = "result is not quantized per tensor";
+    return false;
+  }
+  return true;
+}
+
+/// Return the zero point of a quantized tensor of type 'quantizedType', which
+/// is the explicit zero point 'zeroPoint' when present, or a constant 0.
+Value getZeroPoint(PatternRewriter &rewriter, Location loc, Value zeroPoint,
+    Type quantizedType) {
+  if (!isFromNone(zeroPoint))
+    return zeroPoint;
+  Type elementType = getElementType(quantizedType);
+  RankedTensorType type = RankedTensorType::get({}, elementType);
+  APInt zero(8, 0, /*isSigned=*/!elementType.isUnsignedInteger());
+  return createONNXConstantOpWithDenseAttr(
+      rewriter, loc, DenseElementsAttr::get(type, zero));
+}
+
+/// Rewrite QuantizeLinear(MatMul(DequantizeLinear(a), DequantizeLinear(b)))
+/// into QLinearMatMul(a, b). Gemm without bias, transposition or scaling is
+/// handled as a MatMul.
+struct QLinearMatMulFusionPattern
+    : public OpRewritePattern<ONNXQuantizeLinearOp> {
+  using OpRewritePattern<ONNXQuantizeLinearOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(
+      ONNXQuantizeLinearOp qOp, PatternRewriter &rewriter) const override {
+    Operation *op = qOp.x().getDefiningOp();
+    if (!op || !isa<ONNXMatMulOp, ONNXGemmOp>(op))
+      return failure();
+    ONNXDequantizeLinearOp aOp, bOp;
+    std::string reason;
+    if (!matchQLinearMatMulIsland(op, qOp, aOp, bOp, reason))
+      return rewriter.notifyMatchFailure(op, reason);
+
+    Location loc = rewriter.getFusedLoc({aOp.getLoc(), bOp.getLoc(),
+        op->getLoc(), qOp.getLoc()});
+    Value aZeroPoint =
+        getZeroPoint(rewriter, loc, aOp.x_zero_point(), aOp.x().getType());
+    Value bZeroPoint =
+        getZeroPoint(rewriter, loc, bOp.x_zero_point(), bOp.x().getType());
+    Value yZeroPoint =
+        getZeroPoint(rewriter, loc, qOp.y_zero_point(), qOp.y().getType());
+    rewriter.replaceOpWithNewOp<ONNXQLinearMatMulOp>(qOp, qOp.y().getType(),
+        aOp.x(), aOp.x_scale(), aZeroPoint, bOp.x(), bOp.x_scale(), bZeroPoint,
+        qOp.y_scale(), yZeroPoint);
+    return success();
+  }
+};
+
+struct QDQFusionONNXToONNXPass
+    : public PassWrapper<QDQFusionONNXToONNXPass, OperationPass<func::FuncOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(QDQFusionONNXToONNXPass)
+
+  QDQFusionONNXToONNXPass() = default;
+  QDQFusionONNXToONNXPass(const QDQFusionONNXToONNXPass &pass)
+      : mlir::PassWrapper<QDQFusionONNXToONNXPass,
+            OperationPass<func::FuncOp>>() {}
+  QDQFusionONNXToONNXPass(const std::string &reportFormat) {
+    this->reportFormat = reportFormat;
+  }
+
+  StringRef getArgument() const override { return "qdq-fusion-onnx"; }
+
+  StringRef getDescription() const override {
+    return "Fuse DequantizeLinear, compute and QuantizeLinear islands into "
+           "integer compute ops.";
+  }
+
+  // Usage: onnx-mlir-opt --qdq-fusion-onnx='report=TXT'
+  Option<std::string> reportFormat{*this, "report",
+      llvm::cl::desc("Report the QDQ islands that are not fused, as TXT or "
+                     "JSON (no report if empty)"),
+      ::llvm::cl::init("")};
+
+  void runOnOperation() final;
+
+private:
+  void reportUnfusedIslands(func::FuncOp function, int64_t numFused);
+};
+
+void QDQFusionONNXToONNXPass::runOnOperation() {
+  func::FuncOp function = getOperation();
+  MLIRContext *context = &getContext();
+
+  int64_t numQLinearMatMul = 0;
+  function.walk([&](ONNXQLinearMatMulOp) { numQLinearMatMul++; });
+
+  RewritePatternSet patterns(context);
+  patterns.insert<QLinearMatMulFusionPattern>(context);
+  if (failed(applyPatternsAndFoldGreedily(function, std::move(patterns))))
+    signalPassFailure();
+
+  if (!reportFormat.empty()) {
+    int64_t numFused = -numQLinearMatMul;
+    function.walk([&](ONNXQLinearMatMulOp) { numFused++; });
+    reportUnfusedIslands(function, numFused);
+  }
+}
+
+// An unfused island is a MatMul, Gemm or Conv op with an operand produced by
+// a DequantizeLinear op, which is still computed in float.
+void QDQFusionONNXToONNXPass::reportUnfusedIslands(
+    func::FuncOp function, int64_t numFused) {
+  std::string format = StringRef(reportFormat).upper();
+  if (format != "TXT" && format != "JSON") {
+    llvm::errs() << "Skip QDQ fusion report: expected JSON or TXT format, got "
+                 << "\"" << reportFormat << "\"\n";
+    return;
+  }
+
+  llvm::json::Array unfused;
+  function.walk([&](Operation *op) {
+    if (!isa<ONNXMatMulOp, ONNXGemmOp, ONNXConvOp>(op))
+      return;
+    if (llvm::none_of(op->getOperands(), [](Value v) {
+          return v.getDefiningOp<ONNXDequantizeLinearOp>();
+        }))
+      return;
+    ONNXQuantizeLinearOp qOp;
+    Value res = op->getResult(0);
+    if (!res.use_empty())
+      qOp = dyn_cast<ONNXQuantizeLinearOp>(*res.getUsers().begin());
+    ONNXDequantizeLinearOp aOp, bOp;
+    std::string reason;
+    if (matchQLinearMatMulIsland(op, qOp, aOp, bOp, reason))
+      reason = "not fused";
+    std::string location;
+    llvm::raw_string_ostream locOS(location);
+    op->getLoc().print(locOS);
+    unfused.push_back(llvm::json::Object{
+        {"op", op->getName().getStringRef()},
+        {"location", locOS.str()},
+        {"reason", reason},
+    });
+  });
+
+  if (format == "JSON") {
+    llvm::json::Object report{{"function", function.getName()},
+        {"fused", numFused}, {"unfused", std::move(unfused)}};
+    llvm::outs() << llvm::formatv("{0:2}",
+                        llvm::json::Value(llvm::json::Object{
+                            {"QDQ islands", std::move(report)}}))
+                 << "\n";
+    return;
+  }
+  llvm::outs() << "QDQ islands in " << function.getName() << ": " << numFused
+               << " fused, " << unfused.size() << " unfused\n";
+  for (const llvm::json::Value &island : unfused) {
+    const llvm::json::Object *obj = island.getAsObject();
+    llvm::outs() << "  unfused " << *obj->getString("op") << " at "
+                 << *obj->getString("location") << ": "
+                 << *obj->getString("reason") << "\n";
+  }
+}
+
+} // namespace
+
+/*!
+ * Create a QDQFusionONNX pass.
+ */
+std::unique_ptr<mlir::Pass> createQDQFusionONNXToONNXPass(
+    const std::string &reportFormat) {
+  return std::make_unique<QDQFusionONNXToONNXPass>(reportFormat);
+}
+
+} // namespace onnx_mlir
@@ -237,7 +237,10 @@ def get_test_models():
         "test_conv_with_strides_padding_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{1}},
         "test_conv_with_strides_and_asymmetric_padding_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{1}},
 
-        # ConvInteger
+        # ==OP== ConvInteger
+        # ==LIM== Only a scalar x_zero_point and a scalar or 1-D w_zero_point are supported.
+        "test_convinteger_with_padding_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_convinteger_without_padding_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # ConvTranspose
 
@@ -262,7 +265,9 @@ def get_test_models():
         "test_depthtospace_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
         "test_depthtospace_crd_mode_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
-        # DequatizeLinear
+        # ==OP== DequantizeLinear
+        "test_dequantizelinear_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_dequantizelinear_axis_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # Det
 
@@ -291,7 +296,10 @@ def get_test_models():
         #"test_training_dropout_zero_ratio_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}},
         #"test_training_dropout_zero_ratio_mask_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}},
 
-        # DynamicQuantizeLinear
+        # ==OP== DynamicQuantizeLinear
+        "test_dynamicquantizelinear_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_dynamicquantizelinear_max_adjusted_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_dynamicquantizelinear_min_adjusted_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # ==OP== Einsum
         # ==LIM== Limited to the types supported by ReduceSum and MatMul (which we decompose to in most cases) which exclude integers with width < 32
@@ -485,7 +493,9 @@ def get_test_models():
         "test_matmul_3d_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
         "test_matmul_4d_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
-        # MatMulInteger
+        # ==OP== MatMulInteger
+        # ==LIM== Only scalar and 1-D zero points are supported.
+        "test_matmulinteger_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # ==OP== Max
         # ==LIM== No support for short floats and unsigned int.
@@ -645,11 +655,18 @@ def get_test_models():
         "test_prelu_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
         "test_prelu_broadcast_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
-        # QLinearConv
+        # ==OP== QLinearConv
+        # ==LIM== Only scalar x and y scales and zero points, and scalar or 1-D w scales and zero points are supported.
+        "test_qlinearconv_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
-        # QLinearMatmul
+        # ==OP== QLinearMatMul
+        # ==LIM== Only scalar and 1-D scales and zero points are supported.
+        "test_qlinearmatmul_2D_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_qlinearmatmul_3D_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
-        # QuantizeLinear
+        # ==OP== QuantizeLinear
+        "test_quantizelinear_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_quantizelinear_axis_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # ==OP== Range
         "test_range_float_type_positive_delta_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
@@ -775,7 +792,7 @@ def get_test_models():
         "test_reshape_zero_dim_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{-1}}, CONSTANT_INPUT:{-1}},
 
         # ==OP== Resize
-        # ==LIM== Missing support for linear, cubic, crop, pytorch_half_pixel, and floor.
+        # ==LIM== Missing support for tf_crop_and_resize, and for nearest with coordinate transformation modes other than asymmetric and half_pixel.
         # Resize
 
         #All test cases in onnx v1.11.0. yes for currently supported
@@ -784,21 +801,21 @@ def get_test_models():
         #yes name='test_resize_upsample_sizes_nearest')
         #yes name='test_resize_downsample_sizes_nearest')
         #yes name='test_resize_upsample_scales_linear')
-        #name='test_resize_upsample_scales_linear_align_corners')
+        #yes name='test_resize_upsample_scales_linear_align_corners')
         #yes name='test_resize_downsample_scales_linear')
-        #name='test_resize_downsample_scales_linear_align_corners')
+        #yes name='test_resize_downsample_scales_linear_align_corners')
         #yes name='test_resize_upsample_scales_cubic')
-        #name='test_resize_upsample_scales_cubic_align_corners')
+        #yes name='test_resize_upsample_scales_cubic_align_corners')
         #yes name='test_resize_downsample_scales_cubic')
-        #name='test_resize_downsample_scales_cubic_align_corners')
+        #yes name='test_resize_downsample_scales_cubic_align_corners')
         #yes name='test_resize_upsample_sizes_cubic')
         #yes name='test_resize_downsample_sizes_cubic')
-        #name='test_resize_upsample_scales_cubic_A_n0p5_exclude_outside')
-        #name='test_resize_downsample_scales_cubic_A_n0p5_exclude_outside')
-        #name='test_resize_upsample_scales_cubic_asymmetric')
+        #yes name='test_resize_upsample_scales_cubic_A_n0p5_exclude_outside')
+        #yes name='test_resize_downsample_scales_cubic_A_n0p5_exclude_outside')
+        #yes name='test_resize_upsample_scales_cubic_asymmetric')
         #name='test_resize_tf_crop_and_resize')
         #name='test_resize_tf_crop_and_resize')
-        #name='test_resize_downsample_sizes_linear_pytorch_half_pixel')
+        #yes name='test_resize_downsample_sizes_linear_pytorch_half_pixel')
         #name='test_resize_upsample_sizes_nearest_floor_align_corners')
         #yes name='test_resize_upsample_sizes_nearest_round_prefer_ceil_asymmetric')
         #yes name='test_resize_upsample_sizes_nearest_ceil_half_pixel')
@@ -815,6 +832,14 @@ def get_test_models():
         "test_resize_downsample_scales_cubic_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
         "test_resize_upsample_sizes_cubic_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
         "test_resize_downsample_sizes_cubic_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_upsample_scales_linear_align_corners_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_downsample_scales_linear_align_corners_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_upsample_scales_cubic_align_corners_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_downsample_scales_cubic_align_corners_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_upsample_scales_cubic_A_n0p5_exclude_outside_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_downsample_scales_cubic_A_n0p5_exclude_outside_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_upsample_scales_cubic_asymmetric_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
+        "test_resize_downsample_sizes_linear_pytorch_half_pixel_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE: {0:{-1}}, CONSTANT_INPUT:{-1}},
 
         # ==OP== ReverseSequence
         "test_reversesequence_time_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
@@ -77,6 +77,15 @@ def load_model_tests(kind):
             ],
             'Wrong size for the dimension 2 of the input 0: expect 5, but got 1',
         ),
+        (
+            "wrong_byte_order",
+            [
+                np.ones((3, 4, 5)).astype(
+                    np.dtype('float32').newbyteorder('S')),
+                np.ones((3, 4, 5)).astype('float32')
+            ],
+            'Numpy array with non-native byte order not supported',
+        ),
     ]
 
     testcases = []
@@ -205,12 +214,16 @@ class InputVerificationExecutionSession(object):
 
         session = OMExecutionSession(self.exec_name)
         f = io.BytesIO()
+        error = ''
         with redirect_c_stdout(f):
             try:
                 session.run(inputs)
             except RuntimeError as re:
                 pass
-        output = f.getvalue().decode('utf-8')
+            except ValueError as ve:
+                # Inputs rejected before the model is called.
+                error = str(ve)
+        output = f.getvalue().decode('utf-8') + error
         return output
 
 
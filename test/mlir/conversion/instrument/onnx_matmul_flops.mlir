@@ -0,0 +1,16 @@
+// RUN: onnx-mlir --printIR --EmitMLIR --instrument-ops=onnx.MatMul,onnx.Relu --InstrumentBeforeOp --InstrumentAfterOp --InstrumentReportTime %s | FileCheck %s
+
+// The FLOP estimate of MatMul, 2 * 16 * 64 * 32, is in the tag bits above the
+// actions: 5 + (65536 << 8) before, and 6 + (65536 << 8) after. Relu has no
+// estimate.
+func.func @test_instrument_matmul_flops(%arg0 : tensor<16x32xf32>, %arg1 : tensor<32x64xf32>) -> tensor<*xf32> {
+  %0 = "onnx.MatMul"(%arg0, %arg1) {onnx_node_name = "model/matmul1"} : (tensor<16x32xf32>, tensor<32x64xf32>) -> tensor<*xf32>
+  %1 = "onnx.Relu"(%0) {onnx_node_name = "model/relu1"} : (tensor<*xf32>) -> tensor<*xf32>
+  "func.return"(%1) : (tensor<*xf32>) -> ()
+}
+
+// CHECK-LABEL:  func.func @test_instrument_matmul_flops
+// CHECK:           "krnl.runtime_instrument"() {nodeName = "model/matmul1", opName = "onnx.MatMul", tag = 16777221 : i64} : () -> ()
+// CHECK:           "krnl.runtime_instrument"() {nodeName = "model/matmul1", opName = "onnx.MatMul", tag = 16777222 : i64} : () -> ()
+// CHECK:           "krnl.runtime_instrument"() {nodeName = "model/relu1", opName = "onnx.Relu", tag = 5 : i64} : () -> ()
+// CHECK:           "krnl.runtime_instrument"() {nodeName = "model/relu1", opName = "onnx.Relu", tag = 6 : i64} : () -> ()
@@ -0,0 +1,18 @@
+// RUN: onnx-mlir-opt --instrument="instrument-ops=onnx.Loop,onnx.Return instrument-before=true instrument-after=true report-time=true" %s -split-input-file | FileCheck %s
+
+// Ops without results, here the terminator of the loop body, are instrumented
+// without a FLOP estimate, and only before since they are terminators.
+func.func @test_instrument_zero_result(%arg0: tensor<i64>, %arg1: tensor<i1>, %arg2: tensor<1xf32>) -> tensor<1xf32> {
+  %0 = "onnx.Loop"(%arg0, %arg1, %arg2) ({
+  ^bb0(%arg3: tensor<i64>, %arg4: tensor<i1>, %arg5: tensor<1xf32>):
+    onnx.Return %arg4, %arg5 : tensor<i1>, tensor<1xf32>
+  }) {onnx_node_name = "model/loop1"} : (tensor<i64>, tensor<i1>, tensor<1xf32>) -> tensor<1xf32>
+  return %0 : tensor<1xf32>
+
+// CHECK-LABEL:  func.func @test_instrument_zero_result
+// CHECK:           "krnl.runtime_instrument"() {nodeName = "model/loop1", opName = "onnx.Loop", tag = 5 : i64} : () -> ()
+// CHECK:           "onnx.Loop"
+// CHECK:             "krnl.runtime_instrument"() {{.*}}opName = "onnx.Return", tag = 5 : i64} : () -> ()
+// CHECK-NEXT:        onnx.Return
+// CHECK:           "krnl.runtime_instrument"() {nodeName = "model/loop1", opName = "onnx.Loop", tag = 6 : i64} : () -> ()
+}
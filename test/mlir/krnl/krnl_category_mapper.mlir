@@ -47,6 +47,58 @@ func.func private @test_find_index_int(%val: i64) -> index {
 
 // -----
 
+// Test that 'krnl.find_index_batch' can be called with a memref of strings.
+func.func private @test_find_index_batch_str(%strs: memref<2x2x!krnl.string>, %indices: memref<2x2xi64>) {
+  %G = "krnl.global"() {name = "G", shape = [3], value = dense<[0,1,0]> : tensor<3xi32>} : () -> memref<3xi32>
+  %V = "krnl.global"() {name = "V", shape = [3], value = dense<[2,1,0]> : tensor<3xi32>} : () -> memref<3xi32>
+  %keys = "krnl.global"() {name = "keys", shape = [3], value = dense<["cat", "dog", "cow"]> : tensor<3x!krnl.string>} : () -> memref<3x!krnl.string>
+  %lens = "krnl.global"() {name = "lens", shape = [3], value = dense<3> : tensor<3xi32>} : () -> memref<3xi32>
+  %c3 = arith.constant 3 : i32
+  %c4 = arith.constant 4 : index
+  "krnl.find_index_batch"(%strs, %G, %V, %c3, %keys, %c4, %indices, %lens) : (memref<2x2x!krnl.string>, memref<3xi32>, memref<3xi32>, i32, memref<3x!krnl.string>, index, memref<2x2xi64>, memref<3xi32>) -> ()
+  return
+
+// CHECK-DAG:   llvm.func @find_index_str_batch(!llvm.ptr<ptr<i8>>, i64, !llvm.ptr<i32>, !llvm.ptr<i32>, i32, !llvm.ptr<ptr<i8>>, !llvm.ptr<i32>, !llvm.ptr<i64>)
+// CHECK-LABEL: @test_find_index_batch_str
+// CHECK-DAG:   [[LEN:%.+]] = llvm.mlir.constant(3 : i32) : i32
+// CHECK-DAG:   [[NUM:%.+]] = llvm.mlir.constant(4 : index) : i64
+// CHECK-DAG:   [[STRS:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i64>, ptr<i64>, i64, array<2 x i64>, array<2 x i64>)>
+// CHECK-DAG:   [[G:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i32>, ptr<i32>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK-DAG:   [[V:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i32>, ptr<i32>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK-DAG:   [[KEYS:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i64>, ptr<i64>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK-DAG:   [[STRS_PTR:%.+]] = llvm.bitcast [[STRS]] : !llvm.ptr<i64> to !llvm.ptr<ptr<i8>>
+// CHECK-DAG:   [[KEYS_PTR:%.+]] = llvm.bitcast [[KEYS]] : !llvm.ptr<i64> to !llvm.ptr<ptr<i8>>
+// CHECK-DAG:   [[LENS:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i32>, ptr<i32>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK:       [[INDICES:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i64>, ptr<i64>, i64, array<2 x i64>, array<2 x i64>)>
+// CHECK:       llvm.call @find_index_str_batch([[STRS_PTR]], [[NUM]], [[G]], [[V]], [[LEN]], [[KEYS_PTR]], [[LENS]], [[INDICES]]) : (!llvm.ptr<ptr<i8>>, i64, !llvm.ptr<i32>, !llvm.ptr<i32>, i32, !llvm.ptr<ptr<i8>>, !llvm.ptr<i32>, !llvm.ptr<i64>) -> ()
+}
+
+// -----
+
+// Test that 'krnl.find_index_batch' can be called with a memref of int64_t.
+func.func private @test_find_index_batch_int(%vals: memref<4xi64>, %indices: memref<4xi64>) {
+  %G = "krnl.global"() {name = "G", shape = [3], value = dense<[0,12,0]> : tensor<3xi32>} : () -> memref<3xi32>
+  %V = "krnl.global"() {name = "V", shape = [3], value = dense<[1,0,2]> : tensor<3xi32>} : () -> memref<3xi32>
+  %keys = "krnl.global"() {name = "keys", shape = [3], value = dense<[1,2,3]> : tensor<3xi64>} : () -> memref<3xi64>
+  %c3 = arith.constant 3 : i32
+  %c4 = arith.constant 4 : index
+  "krnl.find_index_batch"(%vals, %G, %V, %c3, %keys, %c4, %indices) : (memref<4xi64>, memref<3xi32>, memref<3xi32>, i32, memref<3xi64>, index, memref<4xi64>) -> ()
+  return
+
+// CHECK-DAG:   llvm.func @find_index_i64_batch(!llvm.ptr<i64>, i64, !llvm.ptr<i32>, !llvm.ptr<i32>, i32, !llvm.ptr<i64>, !llvm.ptr<i64>)
+// CHECK-LABEL: @test_find_index_batch_int
+// CHECK-DAG:   [[LEN:%.+]] = llvm.mlir.constant(3 : i32) : i32
+// CHECK-DAG:   [[NUM:%.+]] = llvm.mlir.constant(4 : index) : i64
+// CHECK-DAG:   [[VALS:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i64>, ptr<i64>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK-DAG:   [[G:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i32>, ptr<i32>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK-DAG:   [[V:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i32>, ptr<i32>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK-DAG:   [[KEYS:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i64>, ptr<i64>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK:       [[INDICES:%.+]] = llvm.extractvalue {{.*}}[1] : !llvm.struct<(ptr<i64>, ptr<i64>, i64, array<1 x i64>, array<1 x i64>)>
+// CHECK:       llvm.call @find_index_i64_batch([[VALS]], [[NUM]], [[G]], [[V]], [[LEN]], [[KEYS]], [[INDICES]]) : (!llvm.ptr<i64>, i64, !llvm.ptr<i32>, !llvm.ptr<i32>, i32, !llvm.ptr<i64>, !llvm.ptr<i64>) -> ()
+}
+
+// -----
+
 // Test CategorMapper lowering when the input is a list of strings.
 func.func private @test_category_mapper_string_to_int64(%arg0: memref<2x2x!krnl.string>) -> memref<2x2xi64> {
   %c0_i32 = arith.constant 0 : i32
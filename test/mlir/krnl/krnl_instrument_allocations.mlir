@@ -0,0 +1,31 @@
+// RUN: onnx-mlir-opt -O3 --convert-krnl-to-llvm="instrument-allocations=true" %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt -O3 --convert-krnl-to-llvm="instrument-allocations=true" %s -split-input-file | FileCheck %s --check-prefix=NOMALLOC
+
+// NOMALLOC-NOT: llvm.call @malloc
+// NOMALLOC-NOT: llvm.call @free
+
+// Check that allocations, including the output list of the entry point, and
+// deallocations are routed through the runtime.
+module {
+  func.func @test_instrument_allocations(%arg0: memref<10xf32>) -> memref<10xf32> {
+    %0 = memref.alloc() : memref<10xf32>
+    %1 = memref.alloc() : memref<10xf32>
+    memref.copy %arg0, %1 : memref<10xf32> to memref<10xf32>
+    memref.copy %1, %0 : memref<10xf32> to memref<10xf32>
+    memref.dealloc %1 : memref<10xf32>
+    return %0 : memref<10xf32>
+  }
+  "krnl.entry_point"() {func = @test_instrument_allocations, numInputs = 1 : i32, numOutputs = 1 : i32, signature = "[    ]"} : () -> ()
+
+  // CHECK-DAG:  llvm.func @omInstrumentMalloc(i64) -> !llvm.ptr<i8>
+  // CHECK-DAG:  llvm.func @omInstrumentFree(!llvm.ptr<i8>)
+
+  // CHECK-LABEL: llvm.func @test_instrument_allocations
+  // CHECK:       llvm.call @omInstrumentMalloc({{.*}}) : (i64) -> !llvm.ptr<i8>
+  // CHECK:       llvm.call @omInstrumentMalloc({{.*}}) : (i64) -> !llvm.ptr<i8>
+  // CHECK:       llvm.call @omInstrumentFree({{.*}}) : (!llvm.ptr<i8>) -> ()
+
+  // CHECK-LABEL: llvm.func @run_test_instrument_allocations
+  // CHECK:       llvm.call @omInstrumentMalloc({{.*}}) : (i64) -> !llvm.ptr<i8>
+  // CHECK:       llvm.call @omTensorListCreateWithOwnership
+}
@@ -76,3 +76,26 @@ func.func @test_random_normal_dynamic_lowering(%arg0: memref<3x4x?x?xf32>) -> me
   // CHECK: llvm.call @get_random_normal_value_f32([[ALIGNED_TENSOR_MEMORY]], [[ALL_VALUES3]], [[MEAN]], [[SCALE]], [[SEED]]) : (!llvm.ptr<f32>, i64, f32, f32, f32) -> ()
   // CHECK: llvm.return [[OUTPUT_TENSOR]] : !llvm.struct<(ptr<f32>, ptr<f32>, i64, array<4 x i64>, array<4 x i64>)>
 }
+
+// -----
+
+func.func @test_random_normal_range_lowering() -> memref<3x4x5xf32> {
+  %0 = memref.alloc() {alignment = 16 : i64} : memref<3x4x5xf32>
+  %c10 = arith.constant 10 : index
+  %c20 = arith.constant 20 : index
+  %cst = arith.constant 0.000000e+00 : f32
+  %cst_0 = arith.constant 1.000000e+00 : f32
+  %cst_1 = arith.constant 2.000000e+00 : f32
+  "krnl.random_normal"(%0, %c10, %cst, %cst_0, %cst_1, %c20) : (memref<3x4x5xf32>, index, f32, f32, f32, index) -> ()
+  return %0 : memref<3x4x5xf32>
+
+  // CHECK-LABEL: llvm.func @get_random_normal_range_value_f32(!llvm.ptr<f32>, i64, i64, f32, f32, f32)
+  // CHECK-LABEL: llvm.func @test_random_normal_range_lowering()
+  // CHECK-DAG: [[SEED:%.+]] = llvm.mlir.constant(2.000000e+00 : f32) : f32
+  // CHECK-DAG: [[SCALE:%.+]] = llvm.mlir.constant(1.000000e+00 : f32) : f32
+  // CHECK-DAG: [[MEAN:%.+]] = llvm.mlir.constant(0.000000e+00 : f32) : f32
+  // CHECK-DAG: [[COUNT:%.+]] = llvm.mlir.constant(10 : index) : i64
+  // CHECK-DAG: [[BEGIN:%.+]] = llvm.mlir.constant(20 : index) : i64
+  // CHECK: [[END:%.+]] = llvm.add [[BEGIN]], [[COUNT]] : i64
+  // CHECK: llvm.call @get_random_normal_range_value_f32({{.*}}, [[BEGIN]], [[END]], [[MEAN]], [[SCALE]], [[SEED]]) : (!llvm.ptr<f32>, i64, i64, f32, f32, f32) -> ()
+}
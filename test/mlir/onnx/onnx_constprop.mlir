@@ -772,3 +772,88 @@ func.func @test_reshape() -> tensor<*xf32> {
 // CHECK:           return [[VAR_0_]] : tensor<1x9xf32>
 // CHECK:         }
 }
+
+// -----
+
+func.func @test_matmul_2d() -> tensor<*xi32> {
+  %0 = onnx.Constant dense<[[1, 2], [3, 4], [5, 6]]> : tensor<3x2xi32>
+  %1 = onnx.Constant dense<[[1, 0, 2], [0, 1, 3]]> : tensor<2x3xi32>
+  %2 = "onnx.MatMul"(%0, %1) : (tensor<3x2xi32>, tensor<2x3xi32>) -> tensor<*xi32>
+  "func.return"(%2) : (tensor<*xi32>) -> ()
+
+// CHECK-LABEL:  func.func @test_matmul_2d
+// CHECK-SAME:   () -> tensor<3x3xi32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}[1, 2, 8], [3, 4, 18], [5, 6, 28]{{.}}> : tensor<3x3xi32>
+// CHECK:           return [[VAR_0_]] : tensor<3x3xi32>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_matmul_batch_1d() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[[1.0, 2.0]], [[3.0, 4.0]]]> : tensor<2x1x2xf32>
+  %1 = onnx.Constant dense<[5.0, 6.0]> : tensor<2xf32>
+  %2 = "onnx.MatMul"(%0, %1) : (tensor<2x1x2xf32>, tensor<2xf32>) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_matmul_batch_1d
+// CHECK-SAME:   () -> tensor<2x1xf32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}[1.700000e+01], [3.900000e+01]{{.}}> : tensor<2x1xf32>
+// CHECK:           return [[VAR_0_]] : tensor<2x1xf32>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_matmul_broadcast_batch() -> tensor<*xi64> {
+  %0 = onnx.Constant dense<[[1, 2], [3, 4]]> : tensor<2x2xi64>
+  %1 = onnx.Constant dense<[[[1, 0], [0, 1]], [[0, 1], [1, 0]]]> : tensor<2x2x2xi64>
+  %2 = "onnx.MatMul"(%0, %1) : (tensor<2x2xi64>, tensor<2x2x2xi64>) -> tensor<*xi64>
+  "func.return"(%2) : (tensor<*xi64>) -> ()
+
+// CHECK-LABEL:  func.func @test_matmul_broadcast_batch
+// CHECK-SAME:   () -> tensor<2x2x2xi64> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}{{.}}[1, 2], [3, 4]{{.}}, {{.}}[2, 1], [4, 3]{{.}}{{.}}> : tensor<2x2x2xi64>
+// CHECK:           return [[VAR_0_]] : tensor<2x2x2xi64>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_transpose_cast_f16() -> tensor<*xf16> {
+  %0 = onnx.Constant dense<[[1.0, 2.0], [3.0, 4.5]]> : tensor<2x2xf32>
+  %1 = "onnx.Transpose"(%0) {perm = [1, 0]} : (tensor<2x2xf32>) -> tensor<*xf32>
+  %2 = "onnx.Cast"(%1) {to = f16} : (tensor<*xf32>) -> tensor<*xf16>
+  "func.return"(%2) : (tensor<*xf16>) -> ()
+
+// CHECK-LABEL:  func.func @test_transpose_cast_f16
+// CHECK-SAME:   () -> tensor<2x2xf16> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}[1.000000e+00, 3.000000e+00], [2.000000e+00, 4.500000e+00]{{.}}> : tensor<2x2xf16>
+// CHECK:           return [[VAR_0_]] : tensor<2x2xf16>
+// CHECK:         }
+}
+
+// -----
+
+// COM: A dense resource read by a fold keeps its resource value.
+func.func @test_dense_resource_kept() -> (tensor<2xf32>, tensor<*xf32>) {
+  %0 = "onnx.Constant"() {value = dense_resource<weights> : tensor<2xf32>} : () -> tensor<2xf32>
+  %1 = onnx.Constant dense<[3.0, 4.0]> : tensor<2xf32>
+  %2 = "onnx.Add"(%0, %1) : (tensor<2xf32>, tensor<2xf32>) -> tensor<*xf32>
+  "func.return"(%0, %2) : (tensor<2xf32>, tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_dense_resource_kept
+// CHECK-SAME:   () -> (tensor<2xf32>, tensor<2xf32>) {
+// CHECK-DAG:       [[VAR_0_:%.+]] = onnx.Constant dense_resource<weights> : tensor<2xf32>
+// CHECK-DAG:       [[VAR_1_:%.+]] = onnx.Constant dense<[4.000000e+00, 6.000000e+00]> : tensor<2xf32>
+// CHECK:           return [[VAR_0_]], [[VAR_1_]] : tensor<2xf32>, tensor<2xf32>
+// CHECK:         }
+}
+
+{-#
+  dialect_resources: {
+    builtin: {
+      weights: "0x040000000000803F00000040"
+    }
+  }
+#-}
@@ -0,0 +1,55 @@
+// RUN: onnx-mlir-opt --shape-inference --constprop-onnx="expansion-bound=16" %s -split-input-file | FileCheck %s
+
+// -----
+
+// Broadcast grows the 2x1 and 1x8 constants into a 2x8 constant beyond the bound.
+func.func @test_add_broadcast_not_folded() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[1.0], [2.0]]> : tensor<2x1xf32>
+  %1 = onnx.Constant dense<[[1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]]> : tensor<1x8xf32>
+  %2 = "onnx.Add"(%0, %1) : (tensor<2x1xf32>, tensor<1x8xf32>) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL:  func @test_add_broadcast_not_folded
+  // CHECK:           [[VAR_0_:%.+]] = "onnx.Add"({{.*}}) : (tensor<2x1xf32>, tensor<1x8xf32>) -> tensor<2x8xf32>
+  // CHECK:           return [[VAR_0_]] : tensor<2x8xf32>
+}
+
+// -----
+
+// The result is larger than the bound but not larger than the operands.
+func.func @test_add_folded() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[1.0, 2.0, 3.0, 4.0, 5.0, 6.0]> : tensor<6xf32>
+  %1 = onnx.Constant dense<1.0> : tensor<6xf32>
+  %2 = "onnx.Add"(%0, %1) : (tensor<6xf32>, tensor<6xf32>) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL:  func @test_add_folded
+  // CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<[2.000000e+00, 3.000000e+00, 4.000000e+00, 5.000000e+00, 6.000000e+00, 7.000000e+00]> : tensor<6xf32>
+  // CHECK:           return [[VAR_0_]] : tensor<6xf32>
+}
+
+// -----
+
+func.func @test_expand_not_folded() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[1.0], [3.0], [5.0]]> : tensor<3x1xf32>
+  %1 = onnx.Constant dense<[2, 3, 2]> : tensor<3xi64>
+  %2 = "onnx.Expand"(%0, %1) : (tensor<3x1xf32>, tensor<3xi64>) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL:  func @test_expand_not_folded
+  // CHECK:           [[VAR_0_:%.+]] = "onnx.Expand"({{.*}}) : (tensor<3x1xf32>, tensor<3xi64>) -> tensor<2x3x2xf32>
+  // CHECK:           return [[VAR_0_]] : tensor<2x3x2xf32>
+}
+
+// -----
+
+func.func @test_small_expand_folded() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[1.0]> : tensor<1xf32>
+  %1 = onnx.Constant dense<[4]> : tensor<1xi64>
+  %2 = "onnx.Expand"(%0, %1) : (tensor<1xf32>, tensor<1xi64>) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL:  func @test_small_expand_folded
+  // CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<1.000000e+00> : tensor<4xf32>
+  // CHECK:           return [[VAR_0_]] : tensor<4xf32>
+}
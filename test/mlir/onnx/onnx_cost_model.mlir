@@ -0,0 +1,85 @@
+// RUN: onnx-mlir-opt --onnx-cost-model %s | FileCheck %s
+
+func.func @test_static(%arg0: tensor<2x3xf32>, %arg1: tensor<3x4xf32>) -> tensor<2x4xf32> {
+  %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<2x3xf32>, tensor<3x4xf32>) -> tensor<2x4xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<2x4xf32>) -> tensor<2x4xf32>
+  "func.return"(%1) : (tensor<2x4xf32>) -> ()
+}
+
+// Dynamic dimensions are named after the input they are equal to.
+func.func @test_dynamic(%arg0: tensor<?x768xf32>) -> tensor<?x10xf32> attributes {input_names = ["input"], output_names = ["output"]} {
+  %0 = "onnx.Constant"() {value = dense<1.0> : tensor<768x10xf32>} : () -> tensor<768x10xf32>
+  %1 = "onnx.MatMul"(%arg0, %0) {onnx_node_name = "matmul0"} : (tensor<?x768xf32>, tensor<768x10xf32>) -> tensor<?x10xf32>
+  %2 = "onnx.Relu"(%1) : (tensor<?x10xf32>) -> tensor<?x10xf32>
+  "func.return"(%2) : (tensor<?x10xf32>) -> ()
+}
+
+// The FLOPs of a Gemm with an unranked operand are unknown.
+func.func @test_unranked_gemm(%arg0: tensor<*xf32>, %arg1: tensor<3x4xf32>) -> tensor<*xf32> {
+  %none = "onnx.NoValue"() {value} : () -> none
+  %0 = "onnx.Gemm"(%arg0, %arg1, %none) : (tensor<*xf32>, tensor<3x4xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+}
+
+// CHECK-LABEL: "Cost model": [
+// CHECK:           "function": "test_static",
+// CHECK-NEXT:      "nodes": [
+// CHECK-NEXT:        {
+// CHECK-NEXT:          "arithmeticIntensity": 0.46{{[0-9]*}},
+// CHECK-NEXT:          "flops": 48,
+// CHECK-NEXT:          "inputBytes": 72,
+// CHECK-NEXT:          "location": "{{.*}}",
+// CHECK-NEXT:          "op": "onnx.MatMul",
+// CHECK-NEXT:          "outputBytes": 32
+// CHECK-NEXT:        },
+// CHECK-NEXT:        {
+// CHECK-NEXT:          "arithmeticIntensity": 0.125,
+// CHECK-NEXT:          "flops": 8,
+// CHECK-NEXT:          "inputBytes": 32,
+// CHECK-NEXT:          "location": "{{.*}}",
+// CHECK-NEXT:          "op": "onnx.Relu",
+// CHECK-NEXT:          "outputBytes": 32
+// CHECK-NEXT:        }
+// CHECK-NEXT:      ],
+// CHECK-NEXT:      "total": {
+// CHECK-NEXT:        "arithmeticIntensity": 0.33{{[0-9]*}},
+// CHECK-NEXT:        "flops": 56,
+// CHECK-NEXT:        "inputBytes": 104,
+// CHECK-NEXT:        "outputBytes": 64,
+// CHECK-NEXT:        "weightBytes": 0
+// CHECK-NEXT:      }
+
+// CHECK:           "function": "test_dynamic",
+// CHECK-NEXT:      "nodes": [
+// CHECK-NEXT:        {
+// CHECK-NEXT:          "arithmeticIntensity": null,
+// CHECK-NEXT:          "flops": "15360*input[0]",
+// CHECK-NEXT:          "inputBytes": "3072*input[0] + 30720",
+// CHECK-NEXT:          "location": "{{.*}}",
+// CHECK-NEXT:          "node": "matmul0",
+// CHECK-NEXT:          "op": "onnx.MatMul",
+// CHECK-NEXT:          "outputBytes": "40*input[0]"
+// CHECK-NEXT:        },
+// CHECK-NEXT:        {
+// CHECK-NEXT:          "arithmeticIntensity": null,
+// CHECK-NEXT:          "flops": "10*input[0]",
+// CHECK-NEXT:          "inputBytes": "40*input[0]",
+// CHECK-NEXT:          "location": "{{.*}}",
+// CHECK-NEXT:          "op": "onnx.Relu",
+// CHECK-NEXT:          "outputBytes": "40*input[0]"
+// CHECK-NEXT:        }
+// CHECK-NEXT:      ],
+// CHECK-NEXT:      "total": {
+// CHECK-NEXT:        "arithmeticIntensity": null,
+// CHECK-NEXT:        "flops": "15370*input[0]",
+// CHECK-NEXT:        "inputBytes": "3112*input[0] + 30720",
+// CHECK-NEXT:        "outputBytes": "80*input[0]",
+// CHECK-NEXT:        "weightBytes": 30720
+// CHECK-NEXT:      }
+
+// CHECK:           "function": "test_unranked_gemm",
+// CHECK-NEXT:      "nodes": [
+// CHECK-NEXT:        {
+// CHECK-NEXT:          "arithmeticIntensity": null,
+// CHECK-NEXT:          "flops": "?",
+// CHECK:               "op": "onnx.Gemm",
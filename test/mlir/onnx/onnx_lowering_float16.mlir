@@ -0,0 +1,70 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// 16-bit floats are loaded and stored as such, but computed in f32.
+func.func @test_add_f16(%arg0 : tensor<10x10xf16>, %arg1 : tensor<10x10xf16>) -> tensor<*xf16> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<10x10xf16>, tensor<10x10xf16>) -> tensor<*xf16>
+  "func.return"(%0) : (tensor<*xf16>) -> ()
+
+// CHECK-LABEL:  func @test_add_f16
+// CHECK:           krnl.iterate
+// CHECK:             [[LHS_:%.+]] = krnl.load {{.*}} : memref<10x10xf16>
+// CHECK:             [[RHS_:%.+]] = krnl.load {{.*}} : memref<10x10xf16>
+// CHECK-DAG:         [[LHS_F32_:%.+]] = arith.extf [[LHS_]] : f16 to f32
+// CHECK-DAG:         [[RHS_F32_:%.+]] = arith.extf [[RHS_]] : f16 to f32
+// CHECK:             [[SUM_:%.+]] = arith.addf [[LHS_F32_]], [[RHS_F32_]] : f32
+// CHECK:             [[RES_:%.+]] = arith.truncf [[SUM_]] : f32 to f16
+// CHECK:             krnl.store [[RES_]], {{.*}} : memref<10x10xf16>
+}
+
+// -----
+
+// MatMul of bf16 accumulates in a f32 result, truncated into the output.
+func.func @test_matmul_bf16(%arg0 : tensor<16x32xbf16>, %arg1 : tensor<32x64xbf16>) -> tensor<*xbf16> {
+  %0 ="onnx.MatMul"(%arg0, %arg1) : (tensor<16x32xbf16>, tensor<32x64xbf16>) -> tensor<*xbf16>
+  "func.return"(%0) : (tensor<*xbf16>) -> ()
+
+// CHECK-LABEL:  func @test_matmul_bf16
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<16x32xbf16>, [[PARAM_1_:%.+]]: memref<32x64xbf16>) -> memref<16x64xbf16> {
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}} : memref<16x64xbf16>
+// CHECK-DAG:       [[ACC_:%.+]] = memref.alloc() {{.*}} : memref<16x64xf32>
+// CHECK:           krnl.matmul [[PARAM_0_]]{{.*}}, [[PARAM_1_]]{{.*}}, [[ACC_]]
+// CHECK:           krnl.iterate
+// CHECK:             [[VAL_:%.+]] = krnl.load [[ACC_]]{{.*}} : memref<16x64xf32>
+// CHECK:             [[TRUNC_:%.+]] = arith.truncf [[VAL_]] : f32 to bf16
+// CHECK:             krnl.store [[TRUNC_]], [[RES_]]{{.*}} : memref<16x64xbf16>
+// CHECK:           memref.dealloc [[ACC_]] : memref<16x64xf32>
+// CHECK:           return [[RES_]] : memref<16x64xbf16>
+}
+
+// -----
+
+// Softmax keeps its max and sum accumulators in f32.
+func.func @test_softmax_f16(%arg0 : tensor<10x20xf16>) -> tensor<*xf16> {
+  %0 = "onnx.Softmax"(%arg0) {axis = 1 : si64} : (tensor<10x20xf16>) -> tensor<*xf16>
+  "func.return"(%0) : (tensor<*xf16>) -> ()
+
+// CHECK-LABEL:  func @test_softmax_f16
+// CHECK-DAG:       memref.alloc() : memref<f32>
+// CHECK-DAG:       memref.alloc() : memref<f32>
+// CHECK:           math.exp {{.*}} : f32
+// CHECK:           arith.truncf {{.*}} : f32 to f16
+// CHECK:           arith.divf {{.*}} : f32
+// CHECK:           arith.truncf {{.*}} : f32 to f16
+}
+
+// -----
+
+// ReduceMean of f16 accumulates and divides in f32.
+func.func @test_reducemean_f16(%arg0 : tensor<3x2x2xf16>) -> tensor<*xf16> {
+  %0 ="onnx.ReduceMean"(%arg0) {axes=[1], keepdims = 0 : si64} : (tensor<3x2x2xf16>)-> tensor<*xf16>
+  "func.return"(%0) : (tensor<*xf16>) -> ()
+
+// CHECK-LABEL:  func @test_reducemean_f16
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}} : memref<3x2xf16>
+// CHECK-DAG:       [[ACC_:%.+]] = memref.alloc() {{.*}} : memref<3x2xf32>
+// CHECK:           arith.extf {{.*}} : f16 to f32
+// CHECK:           arith.addf {{.*}} : f32
+// CHECK:           arith.divf {{.*}} : f32
+// CHECK:           arith.truncf {{.*}} : f32 to f16
+// CHECK:           return [[RES_]] : memref<3x2xf16>
+}
@@ -0,0 +1,89 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl --canonicalize --mlir-elide-elementsattrs-if-larger=16 %s -split-input-file | FileCheck %s
+
+// Gemm with a constant B is lowered with B packed at compile time into
+// panels clamped to the 4x16 size of B, and only tiles of A are copied into
+// buffers at runtime.
+func.func @test_gemm_packed_b(%arg0 : tensor<10x4xf32>) -> tensor<*xf32> {
+  %b = onnx.Constant dense<[[0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 13.0, 14.0, 15.0], [16.0, 17.0, 18.0, 19.0, 20.0, 21.0, 22.0, 23.0, 24.0, 25.0, 26.0, 27.0, 28.0, 29.0, 30.0, 31.0], [32.0, 33.0, 34.0, 35.0, 36.0, 37.0, 38.0, 39.0, 40.0, 41.0, 42.0, 43.0, 44.0, 45.0, 46.0, 47.0], [48.0, 49.0, 50.0, 51.0, 52.0, 53.0, 54.0, 55.0, 56.0, 57.0, 58.0, 59.0, 60.0, 61.0, 62.0, 63.0]]> : tensor<4x16xf32>
+  %c = "onnx.NoValue"() {value} : () -> none
+  %0 ="onnx.Gemm"(%arg0, %b, %c) {alpha = 1.0 : f32, beta = 1.0 : f32, transA = 0 : si64, transB = 0 : si64} : (tensor<10x4xf32>, tensor<4x16xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_gemm_packed_b
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<10x4xf32>) -> memref<10x16xf32> {
+// CHECK-NOT:       "krnl.global"() {name = "constant_{{[0-9]+}}"
+// CHECK:           [[PACKED_:%.+]] = "krnl.global"() {name = "constant_packed_{{[0-9]+}}", shape = [4, 16]
+// CHECK-SAME:      () -> memref<4x16xf32>
+// CHECK:           [[A_BUFF_:%.+]] = memref.alloc() {{.*}} : memref<32x4xf32>
+// CHECK:           krnl.copy_to_tile_buffer [[A_BUFF_]], [[PARAM_0_]]
+// CHECK-NOT:       krnl.copy_to_tile_buffer
+// CHECK:           krnl.matmul {{.*}}, [[PACKED_]]
+// CHECK-NOT:       krnl.copy_to_tile_buffer
+// CHECK:         }
+}
+
+// -----
+
+// The transposed constant B[J, K] is packed in the same [K, J] panel layout.
+func.func @test_gemm_packed_trans_b(%arg0 : tensor<10x4xf32>) -> tensor<*xf32> {
+  %b = onnx.Constant dense<[[0.0, 1.0, 2.0, 3.0], [4.0, 5.0, 6.0, 7.0], [8.0, 9.0, 10.0, 11.0], [12.0, 13.0, 14.0, 15.0], [16.0, 17.0, 18.0, 19.0], [20.0, 21.0, 22.0, 23.0], [24.0, 25.0, 26.0, 27.0], [28.0, 29.0, 30.0, 31.0], [32.0, 33.0, 34.0, 35.0], [36.0, 37.0, 38.0, 39.0], [40.0, 41.0, 42.0, 43.0], [44.0, 45.0, 46.0, 47.0], [48.0, 49.0, 50.0, 51.0], [52.0, 53.0, 54.0, 55.0], [56.0, 57.0, 58.0, 59.0], [60.0, 61.0, 62.0, 63.0]]> : tensor<16x4xf32>
+  %c = "onnx.NoValue"() {value} : () -> none
+  %0 ="onnx.Gemm"(%arg0, %b, %c) {alpha = 1.0 : f32, beta = 1.0 : f32, transA = 0 : si64, transB = 1 : si64} : (tensor<10x4xf32>, tensor<16x4xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_gemm_packed_trans_b
+// CHECK:           [[PACKED_:%.+]] = "krnl.global"() {name = "constant_packed_{{[0-9]+}}", shape = [4, 16]
+// CHECK-SAME:      () -> memref<4x16xf32>
+// CHECK:           krnl.matmul {{.*}}, [[PACKED_]]
+// CHECK-NOT:       krnl.copy_to_tile_buffer {{.*}} {transpose = true}
+// CHECK:         }
+}
+
+// -----
+
+// A splat B is not expanded into packed panels, and is copied into tiles.
+func.func @test_gemm_splat_b(%arg0 : tensor<10x300xf32>) -> tensor<*xf32> {
+  %b = onnx.Constant dense<1.0> : tensor<300x70xf32>
+  %c = "onnx.NoValue"() {value} : () -> none
+  %0 ="onnx.Gemm"(%arg0, %b, %c) {alpha = 1.0 : f32, beta = 1.0 : f32, transA = 0 : si64, transB = 0 : si64} : (tensor<10x300xf32>, tensor<300x70xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_gemm_splat_b
+// CHECK-NOT:       "krnl.global"() {name = "constant_packed_{{[0-9]+}}"
+// CHECK:           [[B_:%.+]] = "krnl.global"() {name = "constant_{{[0-9]+}}", shape = [300, 70]
+// CHECK:           krnl.copy_to_tile_buffer {{.*}}, [[B_]]
+// CHECK:         }
+}
+
+// -----
+
+// A B narrower than a register tile is not padded into packed panels.
+func.func @test_gemm_narrow_b(%arg0 : tensor<10x4xf32>) -> tensor<*xf32> {
+  %b = onnx.Constant dense<[[0.0, 1.0, 2.0, 3.0], [4.0, 5.0, 6.0, 7.0], [8.0, 9.0, 10.0, 11.0], [12.0, 13.0, 14.0, 15.0]]> : tensor<4x4xf32>
+  %c = "onnx.NoValue"() {value} : () -> none
+  %0 ="onnx.Gemm"(%arg0, %b, %c) {alpha = 1.0 : f32, beta = 1.0 : f32, transA = 0 : si64, transB = 0 : si64} : (tensor<10x4xf32>, tensor<4x4xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_gemm_narrow_b
+// CHECK-NOT:       "krnl.global"() {name = "constant_packed_{{[0-9]+}}"
+// CHECK:           [[B_:%.+]] = "krnl.global"() {name = "constant_{{[0-9]+}}", shape = [4, 4]
+// CHECK:           krnl.copy_to_tile_buffer {{.*}}, [[B_]]
+// CHECK:         }
+}
+
+// -----
+
+// The J panel of a B whose width is not a multiple of the register tile is
+// padded to the next multiple only, not to a full 64 wide cache tile.
+func.func @test_gemm_packed_b_partial_j(%arg0 : tensor<10x2xf32>) -> tensor<*xf32> {
+  %b = onnx.Constant dense<[[0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0], [20.0, 21.0, 22.0, 23.0, 24.0, 25.0, 26.0, 27.0, 28.0, 29.0, 30.0, 31.0, 32.0, 33.0, 34.0, 35.0, 36.0, 37.0, 38.0, 39.0]]> : tensor<2x20xf32>
+  %c = "onnx.NoValue"() {value} : () -> none
+  %0 ="onnx.Gemm"(%arg0, %b, %c) {alpha = 1.0 : f32, beta = 1.0 : f32, transA = 0 : si64, transB = 0 : si64} : (tensor<10x2xf32>, tensor<2x20xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_gemm_packed_b_partial_j
+// CHECK:           [[PACKED_:%.+]] = "krnl.global"() {name = "constant_packed_{{[0-9]+}}", shape = [2, 32]
+// CHECK-SAME:      () -> memref<2x32xf32>
+// CHECK:           krnl.matmul {{.*}}, [[PACKED_]]
+// CHECK:         }
+}
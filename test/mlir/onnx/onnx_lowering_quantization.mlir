@@ -0,0 +1,183 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// QuantizeLinear rounds half to even, adds the zero point and saturates to the
+// range of ui8 before truncating.
+func.func @test_quantize_linear(%arg0: tensor<6xf32>, %arg1: tensor<f32>, %arg2: tensor<ui8>) -> tensor<*xui8> {
+  %0 = "onnx.QuantizeLinear"(%arg0, %arg1, %arg2) : (tensor<6xf32>, tensor<f32>, tensor<ui8>) -> tensor<*xui8>
+  return %0 : tensor<*xui8>
+
+// CHECK-LABEL:  func @test_quantize_linear
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<6xf32>, [[PARAM_1_:%.+]]: memref<f32>, [[PARAM_2_:%.+]]: memref<ui8>) -> memref<6xui8> {
+// CHECK:           krnl.iterate
+// CHECK:             [[X_:%.+]] = krnl.load [[PARAM_0_]]{{.}}{{.*}}{{.}} : memref<6xf32>
+// CHECK:             [[SCALE_:%.+]] = krnl.load [[PARAM_1_]][] : memref<f32>
+// CHECK:             [[ZP_:%.+]] = krnl.load [[PARAM_2_]][] : memref<ui8>
+// CHECK:             arith.extui {{.*}} : i8 to i32
+// CHECK:             arith.divf [[X_]], [[SCALE_]] : f32
+// CHECK:             math.floor
+// CHECK:             arith.minf
+// CHECK:             arith.maxf
+// CHECK:             arith.fptosi {{.*}} : f32 to i32
+// CHECK:             arith.trunci {{.*}} : i32 to i8
+// CHECK:             krnl.store {{.*}} : memref<6xui8>
+}
+
+// -----
+
+// Per-axis DequantizeLinear indexes the scale and zero point by the axis loop
+// index and subtracts the zero point in i32.
+func.func @test_dequantize_linear_axis(%arg0: tensor<2x3xi8>, %arg1: tensor<3xf32>, %arg2: tensor<3xi8>) -> tensor<*xf32> {
+  %0 = "onnx.DequantizeLinear"(%arg0, %arg1, %arg2) {axis = 1 : si64} : (tensor<2x3xi8>, tensor<3xf32>, tensor<3xi8>) -> tensor<*xf32>
+  return %0 : tensor<*xf32>
+
+// CHECK-LABEL:  func @test_dequantize_linear_axis
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<2x3xi8>, [[PARAM_1_:%.+]]: memref<3xf32>, [[PARAM_2_:%.+]]: memref<3xi8>) -> memref<2x3xf32> {
+// CHECK:           krnl.iterate
+// CHECK:             [[IV_:%.+]]:2 = krnl.get_induction_var_value
+// CHECK:             [[X_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[IV_]]#0, [[IV_]]#1{{.}} : memref<2x3xi8>
+// CHECK:             arith.extsi [[X_]] : i8 to i32
+// CHECK:             krnl.load [[PARAM_1_]]{{.}}[[IV_]]#1{{.}} : memref<3xf32>
+// CHECK:             krnl.load [[PARAM_2_]]{{.}}[[IV_]]#1{{.}} : memref<3xi8>
+// CHECK:             arith.subi
+// CHECK:             arith.sitofp
+// CHECK:             arith.mulf
+}
+
+// -----
+
+// MatMulInteger accumulates A * B in i32 with krnl.matmul, then subtracts
+// the A zero point times the column sums of B.
+func.func @test_matmul_integer(%arg0: tensor<4x3xui8>, %arg1: tensor<3x2xi8>, %arg2: tensor<ui8>) -> tensor<*xi32> {
+  %none = "onnx.NoValue"() {value} : () -> none
+  %0 = "onnx.MatMulInteger"(%arg0, %arg1, %arg2, %none) : (tensor<4x3xui8>, tensor<3x2xi8>, tensor<ui8>, none) -> tensor<*xi32>
+  return %0 : tensor<*xi32>
+
+// CHECK-LABEL:  func @test_matmul_integer
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<4x3xui8>, [[PARAM_1_:%.+]]: memref<3x2xi8>, [[PARAM_2_:%.+]]: memref<ui8>) -> memref<4x2xi32> {
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<4x2xi32>
+// CHECK-DAG:       [[ACC_:%.+]] = memref.alloc() {{.*}}: memref<4x2xi32>
+// CHECK:           krnl.memset [[ACC_]]
+// CHECK:           krnl.matmul [[PARAM_0_]]{{.*}}, [[PARAM_1_]]{{.*}}, [[ACC_]]{{.*}} : memref<4x3xui8>, memref<3x2xi8>, memref<4x2xi32>
+// CHECK:           [[COL_SUM_:%.+]] = memref.alloc() {{.*}}: memref<2xi32>
+// CHECK:           krnl.memset [[COL_SUM_]]
+// CHECK:           krnl.iterate
+// CHECK:             krnl.load [[PARAM_1_]]{{.*}} : memref<3x2xi8>
+// CHECK:             arith.extsi {{.*}} : i8 to i32
+// CHECK:             arith.addi
+// CHECK:             krnl.store {{.*}}, [[COL_SUM_]]{{.*}} : memref<2xi32>
+// CHECK:           krnl.iterate
+// CHECK:             krnl.load [[ACC_]]{{.*}} : memref<4x2xi32>
+// CHECK:             krnl.load [[PARAM_2_]][] : memref<ui8>
+// CHECK:             arith.extui {{.*}} : i8 to i32
+// CHECK:             krnl.load [[COL_SUM_]]{{.*}} : memref<2xi32>
+// CHECK:             arith.muli
+// CHECK:             arith.subi
+// CHECK:             krnl.store {{.*}}, [[RES_]]{{.*}} : memref<4x2xi32>
+}
+
+// -----
+
+// QLinearMatMul requantizes the i32 accumulator with a_scale * b_scale /
+// y_scale.
+func.func @test_qlinear_matmul(%arg0: tensor<2x4xui8>, %arg1: tensor<f32>, %arg2: tensor<ui8>, %arg3: tensor<4x3xui8>, %arg4: tensor<f32>, %arg5: tensor<ui8>, %arg6: tensor<f32>, %arg7: tensor<ui8>) -> tensor<*xui8> {
+  %0 = "onnx.QLinearMatMul"(%arg0, %arg1, %arg2, %arg3, %arg4, %arg5, %arg6, %arg7) : (tensor<2x4xui8>, tensor<f32>, tensor<ui8>, tensor<4x3xui8>, tensor<f32>, tensor<ui8>, tensor<f32>, tensor<ui8>) -> tensor<*xui8>
+  return %0 : tensor<*xui8>
+
+// CHECK-LABEL:  func @test_qlinear_matmul
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<2x4xui8>, {{.*}}, [[PARAM_3_:%.+]]: memref<4x3xui8>, {{.*}}) -> memref<2x3xui8> {
+// CHECK:           krnl.matmul [[PARAM_0_]]{{.*}}, [[PARAM_3_]]{{.*}}, [[ACC_:%.+]][{{.*}} : memref<2x4xui8>, memref<4x3xui8>, memref<2x3xi32>
+// CHECK:           krnl.iterate
+// CHECK:             arith.addi
+// CHECK:           krnl.iterate
+// CHECK:             arith.addi
+// CHECK:           krnl.iterate
+// CHECK:             krnl.load [[ACC_]]{{.*}} : memref<2x3xi32>
+// CHECK:             arith.subi
+// CHECK:             arith.subi
+// CHECK:             arith.muli
+// CHECK:             arith.addi
+// CHECK:             arith.sitofp {{.*}} : i32 to f32
+// CHECK:             arith.mulf
+// CHECK:             arith.divf
+// CHECK:             arith.divf
+// CHECK:             math.floor
+// CHECK:             arith.fptosi {{.*}} : f32 to i32
+// CHECK:             krnl.store {{.*}} : memref<2x3xui8>
+}
+
+// -----
+
+// ConvInteger accumulates the products of the operands minus their zero
+// points in i32, with the reduction restricted to the unpadded window.
+func.func @test_conv_integer(%arg0: tensor<1x1x3x3xui8>, %arg1: tensor<1x1x2x2xui8>, %arg2: tensor<ui8>) -> tensor<*xi32> {
+  %none = "onnx.NoValue"() {value} : () -> none
+  %0 = "onnx.ConvInteger"(%arg0, %arg1, %arg2, %none) {pads = [1, 1, 1, 1]} : (tensor<1x1x3x3xui8>, tensor<1x1x2x2xui8>, tensor<ui8>, none) -> tensor<*xi32>
+  return %0 : tensor<*xi32>
+
+// CHECK-LABEL:  func @test_conv_integer
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<1x1x3x3xui8>, [[PARAM_1_:%.+]]: memref<1x1x2x2xui8>, [[PARAM_2_:%.+]]: memref<ui8>) -> memref<1x1x4x4xi32> {
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<1x1x4x4xi32>
+// CHECK:           krnl.load [[PARAM_2_]][] : memref<ui8>
+// CHECK:           [[ACC_:%.+]] = memref.alloca() : memref<i32>
+// CHECK:           krnl.iterate
+// CHECK:             krnl.iterate
+// CHECK:               krnl.store {{.*}}, [[ACC_]][] : memref<i32>
+// CHECK:               krnl.iterate
+// CHECK:                 krnl.load [[PARAM_0_]]{{.*}} : memref<1x1x3x3xui8>
+// CHECK:                 arith.extui {{.*}} : i8 to i32
+// CHECK:                 krnl.load [[PARAM_1_]]{{.*}} : memref<1x1x2x2xui8>
+// CHECK:                 arith.extui {{.*}} : i8 to i32
+// CHECK:                 arith.subi
+// CHECK:                 arith.muli
+// CHECK:                 arith.addi
+// CHECK:                 krnl.store {{.*}}, [[ACC_]][] : memref<i32>
+// CHECK:               krnl.store {{.*}}, [[RES_]]{{.*}} : memref<1x1x4x4xi32>
+}
+
+// -----
+
+// QLinearConv adds the i32 bias to the accumulator and requantizes it with
+// x_scale * w_scale / y_scale, without going through a float Conv.
+func.func @test_qlinear_conv(%arg0: tensor<1x1x7x7xui8>, %arg1: tensor<f32>, %arg2: tensor<ui8>, %arg3: tensor<1x1x1x1xui8>, %arg4: tensor<1xf32>, %arg5: tensor<1xui8>, %arg6: tensor<f32>, %arg7: tensor<ui8>, %arg8: tensor<1xi32>) -> tensor<*xui8> {
+  %0 = "onnx.QLinearConv"(%arg0, %arg1, %arg2, %arg3, %arg4, %arg5, %arg6, %arg7, %arg8) {group = 1 : si64} : (tensor<1x1x7x7xui8>, tensor<f32>, tensor<ui8>, tensor<1x1x1x1xui8>, tensor<1xf32>, tensor<1xui8>, tensor<f32>, tensor<ui8>, tensor<1xi32>) -> tensor<*xui8>
+  return %0 : tensor<*xui8>
+
+// CHECK-LABEL:  func @test_qlinear_conv
+// CHECK-SAME:   -> memref<1x1x7x7xui8> {
+// CHECK-NOT:       onnx.Conv
+// CHECK:           krnl.iterate
+// CHECK:             krnl.iterate
+// CHECK:               krnl.iterate
+// CHECK:                 arith.subi
+// CHECK:                 arith.muli
+// CHECK:                 arith.addi
+// CHECK:               krnl.load %arg8{{.*}} : memref<1xi32>
+// CHECK:               arith.addi
+// CHECK:               arith.sitofp {{.*}} : i32 to f32
+// CHECK:               arith.mulf
+// CHECK:               arith.divf
+// CHECK:               math.floor
+// CHECK:               arith.fptosi {{.*}} : f32 to i32
+// CHECK:               krnl.store {{.*}} : memref<1x1x7x7xui8>
+}
+
+// -----
+
+// DynamicQuantizeLinear computes the range of x, including 0, before
+// quantizing it to ui8.
+func.func @test_dynamic_quantize_linear(%arg0: tensor<5xf32>) -> (tensor<*xui8>, tensor<*xf32>, tensor<*xui8>) {
+  %y, %scale, %zp = "onnx.DynamicQuantizeLinear"(%arg0) : (tensor<5xf32>) -> (tensor<*xui8>, tensor<*xf32>, tensor<*xui8>)
+  return %y, %scale, %zp : tensor<*xui8>, tensor<*xf32>, tensor<*xui8>
+
+// CHECK-LABEL:  func @test_dynamic_quantize_linear
+// CHECK-SAME:   -> (memref<5xui8>, memref<f32>, memref<ui8>) {
+// CHECK:           krnl.iterate
+// CHECK:             arith.minf
+// CHECK:             arith.maxf
+// CHECK:           arith.subf
+// CHECK:           arith.cmpf oeq
+// CHECK:           krnl.iterate
+// CHECK:             arith.divf
+// CHECK:             math.floor
+// CHECK:             krnl.store {{.*}} : memref<5xui8>
+}
@@ -0,0 +1,32 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl=enable-parallel=true --canonicalize %s -split-input-file | FileCheck %s
+
+// A large RandomNormal is generated by chunks of 65536 values in parallel.
+func.func @test_random_normal_parallel() -> tensor<*xf32> {
+  %0 = "onnx.RandomNormal"() {shape = [3, 256, 256], dtype = 1 : si64, mean = 0.0 :f32, scale = 1.0 : f32, seed = 2.0 : f32} : () -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_random_normal_parallel
+// CHECK-DAG:       [[CHUNK_:%.+]] = arith.constant 65536 : index
+// CHECK-DAG:       [[TOTAL_:%.+]] = arith.constant 196608 : index
+// CHECK-DAG:       [[CHUNKS_:%.+]] = arith.constant 3 : index
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}} : memref<3x256x256xf32>
+// CHECK:           scf.parallel ([[I_:%.+]]) = ({{.*}}) to ([[CHUNKS_]]) step ({{.*}}) {
+// CHECK:             [[BEGIN_:%.+]] = arith.muli [[I_]], [[CHUNK_]] : index
+// CHECK:             [[LEFT_:%.+]] = arith.subi [[TOTAL_]], [[BEGIN_]] : index
+// CHECK:             [[COUNT_:%.+]] = arith.minsi [[LEFT_]], [[CHUNK_]] : index
+// CHECK:             "krnl.random_normal"([[RES_]], [[COUNT_]], {{.*}}, {{.*}}, {{.*}}, [[BEGIN_]]) : (memref<3x256x256xf32>, index, f32, f32, f32, index) -> ()
+// CHECK:           }
+// CHECK:           return [[RES_]] : memref<3x256x256xf32>
+}
+
+// -----
+
+// A small RandomNormal is generated at once.
+func.func @test_random_normal_small() -> tensor<*xf32> {
+  %0 = "onnx.RandomNormal"() {shape = [3, 4, 5], dtype = 1 : si64, mean = 0.0 :f32, scale = 1.0 : f32, seed = 2.0 : f32} : () -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_random_normal_small
+// CHECK-NOT:       scf.parallel
+// CHECK:           "krnl.random_normal"({{.*}}) : (memref<3x4x5xf32>, index, f32, f32, f32) -> ()
+}
@@ -0,0 +1,36 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl=enable-parallel=true --canonicalize %s -split-input-file | FileCheck %s
+
+// The N and C axes are not resized, and their 6 planes are resized in
+// parallel by the runtime.
+func.func @test_resize_parallel(%arg0 : tensor<2x3x4x4xf32>) -> tensor<*xf32> {
+  %cst = "onnx.NoValue"() {value} : () -> none
+  %0 = onnx.Constant dense<[1.000000e+00, 1.000000e+00, 2.000000e+00, 2.000000e+00]> : tensor<4xf32>
+  %1 = "onnx.Resize"(%arg0, %cst, %0, %cst) {mode = "linear"} : (tensor<2x3x4x4xf32>, none, tensor<4xf32>, none) -> tensor<*xf32>
+  "func.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_resize_parallel
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<2x3x4x4xf32>) -> memref<2x3x8x8xf32> {
+// CHECK-DAG:       [[OUTER_RANK_:%.+]] = arith.constant 2 : i64
+// CHECK-DAG:       [[PLANES_:%.+]] = arith.constant 6 : index
+// CHECK-DAG:       [[SCALES_:%.+]] = "krnl.global"() {name = {{.*}}, shape = [4]
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<2x3x8x8xf32>
+// CHECK:           scf.parallel ([[I_:%.+]]) = ({{.*}}) to ([[PLANES_]]) step ({{.*}}) {
+// CHECK:             [[END_:%.+]] = arith.addi [[I_]], {{.*}} : index
+// CHECK:             "krnl.call"([[RES_]], [[PARAM_0_]], [[SCALES_]], [[OUTER_RANK_]], [[I_]], [[END_]]) {{.*}}funcName = "Resize_Scales_Planes"{{.*}} : (memref<2x3x8x8xf32>, memref<2x3x4x4xf32>, memref<4xf32>, i64, index, index) -> ()
+// CHECK:           }
+// CHECK:           return [[RES_]] : memref<2x3x8x8xf32>
+}
+
+// -----
+
+// Without constant scales, the axes that are not resized are not known, and
+// the whole tensor is resized at once.
+func.func @test_resize_dynamic_scales(%arg0 : tensor<2x3x4x4xf32>, %arg1 : tensor<4xf32>) -> tensor<*xf32> {
+  %cst = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Resize"(%arg0, %cst, %arg1, %cst) {mode = "linear"} : (tensor<2x3x4x4xf32>, none, tensor<4xf32>, none) -> tensor<*xf32>
+  "func.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_resize_dynamic_scales
+// CHECK-NOT:       scf.parallel
+// CHECK:           "krnl.call"({{.*}}) {{.*}}funcName = "Resize_Scales",
+}
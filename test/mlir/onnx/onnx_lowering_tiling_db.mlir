@@ -0,0 +1,43 @@
+// RUN: echo '{"entries": [{"op": "matmul", "mcpu": "skylake-avx512", "dtype": "f32", "I": 16, "J": 32, "K": 64, "iRegTile": 2, "jRegTile": 16, "kRegTile": 4}, {"op": "gemm", "dtype": "f32", "I": 64, "J": 128, "K": 256, "iCacheTile": 16, "jCacheTile": 128, "kCacheTile": 128, "iRegTile": 4, "jRegTile": 16}]}' > %t.json
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl="enable-tiling=true tiling-db=%t.json mcpu=skylake-avx512" %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl="enable-tiling=true tiling-db=%t.json mcpu=znver3" %s -split-input-file | FileCheck %s --check-prefix=OTHERCPU
+
+// MatMul tile sizes tuned for skylake-avx512 only.
+func.func @test_matmul_tuned(%arg0 : tensor<16x64xf32>, %arg1 : tensor<64x32xf32>) -> tensor<*xf32> {
+  %0 ="onnx.MatMul"(%arg0, %arg1) : (tensor<16x64xf32>, tensor<64x32xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_matmul_tuned
+// CHECK:           [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
+// CHECK:           {{.*}} = krnl.block [[LOOP_0_]]#0 2 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// CHECK:           {{.*}} = krnl.block [[LOOP_0_]]#1 16 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// CHECK:           {{.*}} = krnl.block [[LOOP_0_]]#2 4 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+
+// OTHERCPU-LABEL:  func @test_matmul_tuned
+// OTHERCPU:           [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
+// OTHERCPU:           {{.*}} = krnl.block [[LOOP_0_]]#0 4 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// OTHERCPU:           {{.*}} = krnl.block [[LOOP_0_]]#1 8 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// OTHERCPU:           {{.*}} = krnl.block [[LOOP_0_]]#2 8 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+}
+
+// -----
+
+// Gemm tile sizes tuned for any cpu.
+func.func @test_gemm_tuned(%arg0 : tensor<64x256xf32>, %arg1 : tensor<256x128xf32>) -> tensor<*xf32> {
+  %c = "onnx.NoValue"() {value} : () -> none
+  %0 ="onnx.Gemm"(%arg0, %arg1, %c) {alpha = 1.0 : f32, beta = 1.0 : f32, transA = 0 : si64, transB = 0 : si64} : (tensor<64x256xf32>, tensor<256x128xf32>, none) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_gemm_tuned
+// CHECK:           [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
+// CHECK:           {{.*}} = krnl.block [[LOOP_0_]]#0 16 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// CHECK:           {{.*}} = krnl.block {{.*}} 4 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// CHECK:           {{.*}} = krnl.block [[LOOP_0_]]#1 128 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// CHECK:           {{.*}} = krnl.block {{.*}} 16 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// CHECK:           {{.*}} = krnl.block [[LOOP_0_]]#2 128 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+
+// OTHERCPU-LABEL:  func @test_gemm_tuned
+// OTHERCPU:           [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
+// OTHERCPU:           {{.*}} = krnl.block [[LOOP_0_]]#0 16 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+// OTHERCPU:           {{.*}} = krnl.block [[LOOP_0_]]#2 128 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+}
@@ -0,0 +1,43 @@
+// RUN: onnx-mlir-opt --mixed-precision-onnx %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt --mixed-precision-onnx='ops=onnx.*,!gemm_1' %s -split-input-file | FileCheck %s --check-prefix=OPS
+
+// MatMul computes in bf16, its weights and activations are cast.
+func.func @test_matmul(%arg0 : tensor<16x32xf32>, %arg1 : tensor<32x64xf32>) -> tensor<16x64xf32> {
+  %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<16x32xf32>, tensor<32x64xf32>) -> tensor<16x64xf32>
+  "func.return"(%0) : (tensor<16x64xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_matmul
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<16x32xf32>, [[PARAM_1_:%.+]]: tensor<32x64xf32>) -> tensor<16x64xf32> {
+// CHECK-DAG:       [[VAR_0_:%.+]] = "onnx.Cast"([[PARAM_0_]]) {to = bf16} : (tensor<16x32xf32>) -> tensor<16x32xbf16>
+// CHECK-DAG:       [[VAR_1_:%.+]] = "onnx.Cast"([[PARAM_1_]]) {to = bf16} : (tensor<32x64xf32>) -> tensor<32x64xbf16>
+// CHECK:           [[VAR_2_:%.+]] = "onnx.MatMul"([[VAR_0_]], [[VAR_1_]]) : (tensor<16x32xbf16>, tensor<32x64xbf16>) -> tensor<16x64xbf16>
+// CHECK:           [[VAR_3_:%.+]] = "onnx.Cast"([[VAR_2_]]) {to = f32} : (tensor<16x64xbf16>) -> tensor<16x64xf32>
+// CHECK:           return [[VAR_3_]] : tensor<16x64xf32>
+
+// OPS-LABEL:    func.func @test_matmul
+// OPS:             "onnx.MatMul"({{.*}}) : (tensor<16x32xbf16>, tensor<32x64xbf16>) -> tensor<16x64xbf16>
+}
+
+// -----
+
+// Softmax stays in f32 whatever the op list, and Add is only converted when
+// selected.
+func.func @test_gemm_add_softmax(%arg0 : tensor<8x16xf32>, %arg1 : tensor<16x16xf32>, %arg2 : tensor<16xf32>) -> tensor<8x16xf32> {
+  %0 = "onnx.Gemm"(%arg0, %arg1, %arg2) {onnx_node_name = "gemm_0"} : (tensor<8x16xf32>, tensor<16x16xf32>, tensor<16xf32>) -> tensor<8x16xf32>
+  %1 = "onnx.Add"(%0, %arg0) : (tensor<8x16xf32>, tensor<8x16xf32>) -> tensor<8x16xf32>
+  %2 = "onnx.Gemm"(%1, %arg1, %arg2) {onnx_node_name = "gemm_1"} : (tensor<8x16xf32>, tensor<16x16xf32>, tensor<16xf32>) -> tensor<8x16xf32>
+  %3 = "onnx.Softmax"(%2) {axis = 1 : si64} : (tensor<8x16xf32>) -> tensor<8x16xf32>
+  "func.return"(%3) : (tensor<8x16xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_gemm_add_softmax
+// CHECK:           "onnx.Gemm"({{.*}}) {onnx_node_name = "gemm_0"} : (tensor<8x16xbf16>, tensor<16x16xbf16>, tensor<16xbf16>) -> tensor<8x16xbf16>
+// CHECK:           "onnx.Add"({{.*}}) : (tensor<8x16xf32>, tensor<8x16xf32>) -> tensor<8x16xf32>
+// CHECK:           "onnx.Gemm"({{.*}}) {onnx_node_name = "gemm_1"} : (tensor<8x16xbf16>, tensor<16x16xbf16>, tensor<16xbf16>) -> tensor<8x16xbf16>
+// CHECK:           "onnx.Softmax"({{.*}}) {axis = 1 : si64} : (tensor<8x16xf32>) -> tensor<8x16xf32>
+
+// OPS-LABEL:    func.func @test_gemm_add_softmax
+// OPS:             "onnx.Gemm"({{.*}}) {onnx_node_name = "gemm_0"} : (tensor<8x16xbf16>, tensor<16x16xbf16>, tensor<16xbf16>) -> tensor<8x16xbf16>
+// OPS:             "onnx.Add"({{.*}}) : (tensor<8x16xbf16>, tensor<8x16xbf16>) -> tensor<8x16xbf16>
+// OPS:             "onnx.Gemm"({{.*}}) {onnx_node_name = "gemm_1"} : (tensor<8x16xf32>, tensor<16x16xf32>, tensor<16xf32>) -> tensor<8x16xf32>
+// OPS:             "onnx.Softmax"({{.*}}) {axis = 1 : si64} : (tensor<8x16xf32>) -> tensor<8x16xf32>
+}
@@ -0,0 +1,63 @@
+// RUN: onnx-mlir-opt --qdq-fusion-onnx %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt --qdq-fusion-onnx='report=TXT' %s -split-input-file | FileCheck %s --check-prefix=REPORT
+
+func.func @test_fuse_matmul(%arg0: tensor<2x3xui8>, %arg1: tensor<3x4xi8>, %arg2: tensor<f32>, %arg3: tensor<ui8>, %arg4: tensor<f32>, %arg5: tensor<i8>, %arg6: tensor<f32>, %arg7: tensor<ui8>) -> tensor<2x4xui8> {
+  %0 = "onnx.DequantizeLinear"(%arg0, %arg2, %arg3) : (tensor<2x3xui8>, tensor<f32>, tensor<ui8>) -> tensor<2x3xf32>
+  %1 = "onnx.DequantizeLinear"(%arg1, %arg4, %arg5) : (tensor<3x4xi8>, tensor<f32>, tensor<i8>) -> tensor<3x4xf32>
+  %2 = "onnx.MatMul"(%0, %1) : (tensor<2x3xf32>, tensor<3x4xf32>) -> tensor<2x4xf32>
+  %3 = "onnx.QuantizeLinear"(%2, %arg6, %arg7) : (tensor<2x4xf32>, tensor<f32>, tensor<ui8>) -> tensor<2x4xui8>
+  return %3 : tensor<2x4xui8>
+
+// CHECK-LABEL:  func @test_fuse_matmul
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<2x3xui8>, [[PARAM_1_:%.+]]: tensor<3x4xi8>, [[PARAM_2_:%.+]]: tensor<f32>, [[PARAM_3_:%.+]]: tensor<ui8>, [[PARAM_4_:%.+]]: tensor<f32>, [[PARAM_5_:%.+]]: tensor<i8>, [[PARAM_6_:%.+]]: tensor<f32>, [[PARAM_7_:%.+]]: tensor<ui8>) -> tensor<2x4xui8> {
+// CHECK:           [[VAR_0_:%.+]] = "onnx.QLinearMatMul"([[PARAM_0_]], [[PARAM_2_]], [[PARAM_3_]], [[PARAM_1_]], [[PARAM_4_]], [[PARAM_5_]], [[PARAM_6_]], [[PARAM_7_]]) : (tensor<2x3xui8>, tensor<f32>, tensor<ui8>, tensor<3x4xi8>, tensor<f32>, tensor<i8>, tensor<f32>, tensor<ui8>) -> tensor<2x4xui8>
+// CHECK-NOT:       onnx.MatMul
+// CHECK:           return [[VAR_0_]] : tensor<2x4xui8>
+
+// REPORT: QDQ islands in test_fuse_matmul: 1 fused, 0 unfused
+}
+
+// -----
+
+// Gemm without bias and per-column weight scales, missing zero points are
+// replaced by constant zeros.
+func.func @test_fuse_gemm_per_column(%arg0: tensor<2x3xi8>, %arg1: tensor<3x4xi8>, %arg2: tensor<f32>, %arg3: tensor<4xf32>, %arg4: tensor<f32>) -> tensor<2x4xi8> {
+  %none = "onnx.NoValue"() {value} : () -> none
+  %0 = "onnx.DequantizeLinear"(%arg0, %arg2, %none) : (tensor<2x3xi8>, tensor<f32>, none) -> tensor<2x3xf32>
+  %1 = "onnx.DequantizeLinear"(%arg1, %arg3, %none) {axis = 1 : si64} : (tensor<3x4xi8>, tensor<4xf32>, none) -> tensor<3x4xf32>
+  %2 = "onnx.Gemm"(%0, %1, %none) : (tensor<2x3xf32>, tensor<3x4xf32>, none) -> tensor<2x4xf32>
+  %3 = "onnx.QuantizeLinear"(%2, %arg4, %none) : (tensor<2x4xf32>, tensor<f32>, none) -> tensor<2x4xi8>
+  return %3 : tensor<2x4xi8>
+
+// CHECK-LABEL:  func @test_fuse_gemm_per_column
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<2x3xi8>, [[PARAM_1_:%.+]]: tensor<3x4xi8>, [[PARAM_2_:%.+]]: tensor<f32>, [[PARAM_3_:%.+]]: tensor<4xf32>, [[PARAM_4_:%.+]]: tensor<f32>) -> tensor<2x4xi8> {
+// CHECK-DAG:       [[VAR_0_:%.+]] = "onnx.Constant"() {value = dense<0> : tensor<i8>} : () -> tensor<i8>
+// CHECK:           [[VAR_1_:%.+]] = "onnx.QLinearMatMul"([[PARAM_0_]], [[PARAM_2_]], [[VAR_0_]], [[PARAM_1_]], [[PARAM_3_]], [[VAR_0_]], [[PARAM_4_]], [[VAR_0_]])
+// CHECK-NOT:       onnx.Gemm
+// CHECK:           return [[VAR_1_]] : tensor<2x4xi8>
+}
+
+// -----
+
+// Islands with a Gemm bias or a Conv are left unfused and reported.
+func.func @test_unfused(%arg0: tensor<2x3xi8>, %arg1: tensor<3x4xi8>, %arg2: tensor<4xf32>, %arg3: tensor<1x1x5x5xi8>, %arg4: tensor<1x1x3x3xi8>, %arg5: tensor<f32>) -> (tensor<2x4xi8>, tensor<1x1x3x3xi8>) {
+  %none = "onnx.NoValue"() {value} : () -> none
+  %0 = "onnx.DequantizeLinear"(%arg0, %arg5, %none) : (tensor<2x3xi8>, tensor<f32>, none) -> tensor<2x3xf32>
+  %1 = "onnx.DequantizeLinear"(%arg1, %arg5, %none) : (tensor<3x4xi8>, tensor<f32>, none) -> tensor<3x4xf32>
+  %2 = "onnx.Gemm"(%0, %1, %arg2) : (tensor<2x3xf32>, tensor<3x4xf32>, tensor<4xf32>) -> tensor<2x4xf32>
+  %3 = "onnx.QuantizeLinear"(%2, %arg5, %none) : (tensor<2x4xf32>, tensor<f32>, none) -> tensor<2x4xi8>
+  %4 = "onnx.DequantizeLinear"(%arg3, %arg5, %none) : (tensor<1x1x5x5xi8>, tensor<f32>, none) -> tensor<1x1x5x5xf32>
+  %5 = "onnx.DequantizeLinear"(%arg4, %arg5, %none) : (tensor<1x1x3x3xi8>, tensor<f32>, none) -> tensor<1x1x3x3xf32>
+  %6 = "onnx.Conv"(%4, %5, %none) : (tensor<1x1x5x5xf32>, tensor<1x1x3x3xf32>, none) -> tensor<1x1x3x3xf32>
+  %7 = "onnx.QuantizeLinear"(%6, %arg5, %none) : (tensor<1x1x3x3xf32>, tensor<f32>, none) -> tensor<1x1x3x3xi8>
+  return %3, %7 : tensor<2x4xi8>, tensor<1x1x3x3xi8>
+
+// CHECK-LABEL:  func @test_unfused
+// CHECK-NOT:       onnx.QLinearMatMul
+// CHECK:           "onnx.Gemm"
+// CHECK:           "onnx.Conv"
+
+// REPORT:      QDQ islands in test_unfused: 0 fused, 2 unfused
+// REPORT-NEXT:   unfused onnx.Gemm at {{.*}}: Gemm has a bias
+// REPORT-NEXT:   unfused onnx.Conv at {{.*}}: there is no integer operation for onnx.Conv
+}
@@ -286,5 +286,82 @@ bool MatMulSingleBroadcastLibBuilder::verifyOutputs() {
   return ok;
 }
 
+// =============================================================================
+// 2D MatMulInteger without broadcast
+
+MatMulInteger2DLibBuilder::MatMulInteger2DLibBuilder(
+    const std::string &modelName, const int I, const int J, const int K)
+    : ModelLibBuilder(modelName), I(I), J(J), K(K) {}
+
+bool MatMulInteger2DLibBuilder::build() {
+  llvm::SmallVector<int64_t, 4> aShape = {I, K};
+  llvm::SmallVector<int64_t, 1> bShape = {K, J};
+  llvm::SmallVector<int64_t, 1> aZeroPointShape = {1};
+  llvm::SmallVector<int64_t, 4> cShape = {I, J};
+  Type ui8Type = builder.getIntegerType(8, /*isSigned=*/false);
+  auto aType = RankedTensorType::get(aShape, ui8Type);
+  auto bType = RankedTensorType::get(bShape, builder.getI8Type());
+  auto aZeroPointType = RankedTensorType::get(aZeroPointShape, ui8Type);
+  auto yType = RankedTensorType::get(cShape, builder.getI32Type());
+
+  llvm::SmallVector<Type, 3> inputsType{aType, bType, aZeroPointType};
+  llvm::SmallVector<Type, 1> outputsType{yType};
+
+  func::FuncOp funcOp = createEmptyTestFunction(inputsType, outputsType);
+  Block &entryBlock = funcOp.getBody().front();
+  auto aVal = entryBlock.getArgument(0);
+  auto bVal = entryBlock.getArgument(1);
+  auto aZeroPointVal = entryBlock.getArgument(2);
+  auto noneVal = builder.create<ONNXNoneOp>(loc).getResult();
+
+  auto matMulIntegerOp = builder.create<ONNXMatMulIntegerOp>(loc,
+      /*Y=*/yType, /*A=*/aVal, /*B=*/bVal, /*a_zero_point=*/aZeroPointVal,
+      /*b_zero_point=*/noneVal);
+
+  llvm::SmallVector<Value, 1> results = {matMulIntegerOp.getResult()};
+  builder.create<func::ReturnOp>(loc, results);
+  module.push_back(funcOp);
+
+  createEntryPoint(funcOp);
+  return true;
+}
+
+bool MatMulInteger2DLibBuilder::prepareInputs() {
+  constexpr int num = 3;
+  OMTensor **list = (OMTensor **)malloc(num * sizeof(OMTensor *));
+  if (!list)
+    return false;
+  list[0] = omTensorCreateWithRandomData<uint8_t>({I, K}, 0, 255);
+  list[1] = omTensorCreateWithRandomData<int8_t>({K, J}, -128, 127);
+  list[2] = omTensorCreateWithRandomData<uint8_t>({1}, 0, 255);
+  inputs = omTensorListCreateWithOwnership(list, num, true);
+  return inputs && list[0] && list[1] && list[2];
+}
+
+bool MatMulInteger2DLibBuilder::verifyOutputs() {
+  // Get inputs and outputs.
+  if (!inputs || !outputs)
+    return false;
+  OMTensor *a = omTensorListGetOmtByIndex(inputs, 0);
+  OMTensor *b = omTensorListGetOmtByIndex(inputs, 1);
+  OMTensor *aZeroPoint = omTensorListGetOmtByIndex(inputs, 2);
+  OMTensor *res = omTensorListGetOmtByIndex(outputs, 0);
+  if (!a || !b || !aZeroPoint || !res)
+    return false;
+  // Compute reference, MatMul (A - a_zero_point) * B, and compare exactly.
+  int32_t aZp = omTensorGetElem<uint8_t>(aZeroPoint, {0});
+  for (int64_t i = 0; i < I; ++i) {
+    for (int64_t j = 0; j < J; ++j) {
+      int32_t ref = 0;
+      for (int64_t k = 0; k < K; k++)
+        ref += (omTensorGetElem<uint8_t>(a, {i, k}) - aZp) *
+               omTensorGetElem<int8_t>(b, {k, j});
+      if (omTensorGetElem<int32_t>(res, {i, j}) != ref)
+        return false;
+    }
+  }
+  return true;
+}
+
 } // namespace test
 } // namespace onnx_mlir
@@ -320,6 +320,21 @@ private:
   std::vector<int64_t> aShape, bShape, yShape;
 };
 
+// 2x2 MatMulInteger with no broadcast, of a ui8 A with a 1-element zero point
+// and an i8 B without zero point, accumulated in i32.
+class MatMulInteger2DLibBuilder : public ModelLibBuilder {
+public:
+  MatMulInteger2DLibBuilder(
+      const std::string &modelName, const int I, const int J, const int K);
+  bool build() final;
+  bool prepareInputs() final;
+  bool verifyOutputs() final;
+
+private:
+  // Data that defines model.
+  const int I, J, K;
+};
+
 // Padding schemes for Convolutions.
 enum ConvAutoPad {
   NOTSET = 0,
@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//====-- TestMatMulInteger2D.cpp - test integer matmul without broadcast -====//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains the code to test 2D integer matrix multiply code.
+//
+//===----------------------------------------------------------------------===//
+
+// Common.hpp needs to be included first to correctly suppress the rapidcheck.h
+// warnings.
+#include "Common.hpp"
+
+static const llvm::StringRef SHARED_LIB_BASE(
+    "./TestMatMulInteger2D_main_graph");
+
+using namespace mlir;
+
+namespace onnx_mlir {
+namespace test {
+
+// Returns whether onnx-mlir compiled MatMulInteger is producing the same
+// results as a naive implementation of MatMulInteger for a specific set of
+// parameters. MatMulInteger: (A[IxK] - a_zero_point) * B[KxJ] = C[IxJ]
+static bool isOMMatMulIntegerTheSameAsNaiveImplFor(
+    const int I, const int J, const int K) {
+  static int testNum = 0;
+  printf("attempt %d with i %d, j %d, k %d\n", ++testNum, I, J, K);
+  MatMulInteger2DLibBuilder matmul(SHARED_LIB_BASE.str(), I, J, K);
+  return matmul.build() && matmul.compileAndLoad() &&
+         matmul.prepareInputs() && matmul.run() && matmul.verifyOutputs();
+}
+} // namespace test
+} // namespace onnx_mlir
+
+int main(int argc, char *argv[]) {
+  using namespace onnx_mlir;
+  using namespace onnx_mlir::test;
+
+  llvm::FileRemover remover(
+      onnx_mlir::getTargetFilename(SHARED_LIB_BASE.str(), onnx_mlir::EmitLib));
+
+  ModelLibBuilder::setRandomNumberGeneratorSeed("TEST_SEED");
+  setCompilerOption(OptionKind::CompilerOptLevel, "3");
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "TestMatMulInteger2D\n", nullptr, "TEST_ARGS");
+
+  printf("RapidCheck Matrix-Matrix test case generation.\n");
+  bool success =
+      rc::check("Matrix-Matrix MatMulInteger implementation correctness", []() {
+        const int I = *rc::gen::inRange(1, 50);
+        const int J = *rc::gen::inRange(1, 50);
+        const int K = *rc::gen::inRange(1, 50);
+
+        RC_ASSERT(isOMMatMulIntegerTheSameAsNaiveImplFor(I, J, K));
+      });
+  if (!success)
+    return 1;
+
+  printf("\n\nExhaustive test case generation.\n");
+  for (int I = 1; I < 9; I++)
+    for (int J = 1; J < 9; J++)
+      for (int K = 1; K < 9; K++)
+        assert(isOMMatMulIntegerTheSameAsNaiveImplFor(I, J, K));
+
+  return 0;
+}
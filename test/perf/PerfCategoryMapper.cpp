@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//==============-- PerfCategoryMapper.cpp - CategoryMapper perf tests -=======//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains performance tests of CategoryMapper for dictionaries of
+// increasing sizes. Half of the input values are in the dictionary, so that
+// both the hits and the misses of the lookup are measured.
+//   * Time is set to report in microseconds (us)
+//   * Complexity is calculated on the size of the dictionary.
+//   * Default opt level is O3, options found in PERF_ARGS override default.
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "include/OnnxMlirCompiler.h"
+#include "test/modellib/ModelLib.hpp"
+#include "test/perf/PerfHelper.hpp"
+
+const std::string modelName("./perfcategorymapper");
+
+// Number of values looked up per inference.
+const int64_t numInputs = 4096;
+
+static void BM_CategoryMapperStringToInt64(benchmark::State &state) {
+  int64_t dictSize = state.range(0);
+  std::vector<std::string> keys, values;
+  std::vector<llvm::StringRef> catStrings;
+  std::vector<int64_t> catInt64s;
+  for (int64_t i = 0; i < dictSize; ++i) {
+    keys.emplace_back("category_" + std::to_string(i));
+    catInt64s.emplace_back(i);
+  }
+  for (const std::string &key : keys)
+    catStrings.emplace_back(key);
+  // Even inputs are in the dictionary, odd inputs are not.
+  std::vector<const char *> input;
+  std::vector<int64_t> expOutput;
+  for (int64_t i = 0; i < numInputs; ++i) {
+    bool hit = (i % 2) == 0;
+    values.emplace_back(
+        hit ? keys[(i / 2) % dictSize] : "unknown_" + std::to_string(i));
+    expOutput.emplace_back(hit ? (i / 2) % dictSize : -1);
+  }
+  for (const std::string &value : values)
+    input.emplace_back(value.c_str());
+
+  using CategoryMapperBuilder =
+      onnx_mlir::test::CategoryMapperLibBuilder<const char *, int64_t>;
+  CategoryMapperBuilder::CMAttributes attributes = {
+      catInt64s, catStrings, -1, "none"};
+  CategoryMapperBuilder model(modelName, attributes, input, expOutput);
+  assert(model.build() && model.compileAndLoad() && model.prepareInputs() &&
+         "failed category mapper");
+  for (auto _ : state)
+    model.run();
+  state.SetComplexityN(dictSize);
+  state.SetItemsProcessed(state.iterations() * numInputs);
+}
+BENCHMARK(BM_CategoryMapperStringToInt64)
+    ->RangeMultiplier(8)
+    ->Range(8, 32768)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+static void BM_CategoryMapperInt64ToString(benchmark::State &state) {
+  int64_t dictSize = state.range(0);
+  std::vector<std::string> keys;
+  std::vector<llvm::StringRef> catStrings;
+  std::vector<int64_t> catInt64s;
+  for (int64_t i = 0; i < dictSize; ++i) {
+    keys.emplace_back("category_" + std::to_string(i));
+    // Spread the keys so that they are not a dense range.
+    catInt64s.emplace_back(i * 7919 + 13);
+  }
+  for (const std::string &key : keys)
+    catStrings.emplace_back(key);
+  // Even inputs are in the dictionary, odd inputs are not.
+  std::vector<int64_t> input;
+  std::vector<const char *> expOutput;
+  for (int64_t i = 0; i < numInputs; ++i) {
+    bool hit = (i % 2) == 0;
+    int64_t index = (i / 2) % dictSize;
+    input.emplace_back(hit ? catInt64s[index] : -i);
+    expOutput.emplace_back(hit ? keys[index].c_str() : "none");
+  }
+
+  using CategoryMapperBuilder =
+      onnx_mlir::test::CategoryMapperLibBuilder<int64_t, const char *>;
+  CategoryMapperBuilder::CMAttributes attributes = {
+      catInt64s, catStrings, -1, "none"};
+  CategoryMapperBuilder model(modelName, attributes, input, expOutput);
+  assert(model.build() && model.compileAndLoad() && model.prepareInputs() &&
+         "failed category mapper");
+  for (auto _ : state)
+    model.run();
+  state.SetComplexityN(dictSize);
+  state.SetItemsProcessed(state.iterations() * numInputs);
+}
+BENCHMARK(BM_CategoryMapperInt64ToString)
+    ->RangeMultiplier(8)
+    ->Range(8, 32768)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+// Will set opt at -O3.
+PERF_MAIN()
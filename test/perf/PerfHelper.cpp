@@ -27,8 +27,9 @@ void perf_recordFlops(benchmark::State &state, float f) {
 }
 
 // Define performance main, with default opt level of 3, and scan PERF_ARGS to
-// override default onnx-mlir compiler options.
-int perf_main(int argc, char **argv) {
+// override default onnx-mlir compiler options. Benchmarks that depend on these
+// options are registered by registerBenchmarks, if any.
+int perf_main(int argc, char **argv, void (*registerBenchmarks)()) {
   ::benchmark::Initialize(&argc, argv);
   const int onnxMlirArgc = 2;
   const char *onnxMlirArgv[onnxMlirArgc];
@@ -37,6 +38,8 @@ int perf_main(int argc, char **argv) {
   if (!llvm::cl::ParseCommandLineOptions(onnxMlirArgc, onnxMlirArgv,
           "set options for perf-algo", nullptr, /*env var*/ "PERF_ARGS"))
     return 2;
+  if (registerBenchmarks)
+    registerBenchmarks();
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return 1;
   ::benchmark::RunSpecifiedBenchmarks();
@@ -19,8 +19,10 @@
 void perf_recordFlops(benchmark::State &state, float f);
 
 // Define performance main, with default opt level of 3, and scan PERF_ARGS to
-// override default onnx-mlir compiler options.
-int perf_main(int argc, char **argv);
+// override default onnx-mlir compiler options. Benchmarks that depend on these
+// options are registered by registerBenchmarks, if any.
+int perf_main(
+    int argc, char **argv, void (*registerBenchmarks)() = nullptr);
 
 #define PERF_MAIN()                                                            \
   int main(int argc, char **argv) { return perf_main(argc, argv); }
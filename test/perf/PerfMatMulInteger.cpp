@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//============-- PerfMatMulInteger.cpp - Integer MatMul perf tests -==========//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file compares the MatMulInteger of ui8 and i8 matrices, accumulated in
+// i32, with the float MatMul of the same sizes.
+//   * Time is set to report in miliseconds (ms)
+//   * Complexity is calculated in the original nanoseconds.
+//   * Default opt level is O3, options found in PERF_ARGS override default.
+//
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include "include/OnnxMlirCompiler.h"
+#include "test/modellib/ModelLib.hpp"
+#include "test/perf/PerfHelper.hpp"
+
+const std::string modelName("./perfmatmulinteger");
+
+static void BM_MatMulIntegerSquare(benchmark::State &state) {
+  int I = state.range(0);
+  int J = state.range(0);
+  int K = state.range(0);
+  onnx_mlir::test::MatMulInteger2DLibBuilder model(modelName, I, J, K);
+  assert(model.build() && model.compileAndLoad() && model.prepareInputs() &&
+         "failed matmul integer");
+  for (auto _ : state)
+    model.run();
+  state.SetComplexityN(I);
+  perf_recordFlops(state, 2.0 * I * J * K);
+}
+BENCHMARK(BM_MatMulIntegerSquare)
+    ->RangeMultiplier(2)
+    ->Range(16, 2048)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+// Same sizes in float, as the baseline.
+static void BM_MatMulFloatSquare(benchmark::State &state) {
+  int I = state.range(0);
+  int J = state.range(0);
+  int K = state.range(0);
+  onnx_mlir::test::MatMul2DLibBuilder model(modelName, I, J, K);
+  assert(model.build() && model.compileAndLoad() && model.prepareInputs() &&
+         "failed matmul");
+  for (auto _ : state)
+    model.run();
+  state.SetComplexityN(I);
+  perf_recordFlops(state, 2.0 * I * J * K);
+}
+BENCHMARK(BM_MatMulFloatSquare)
+    ->RangeMultiplier(2)
+    ->Range(16, 2048)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+// Will set opt at -O3.
+PERF_MAIN()
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//=================-- PerfMatMulTuning.cpp - MatMul tiling tuning -==========//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains benchmarks of MatMul and Gemm for the problem sizes given
+// by --perf-tuning-shapes, used by utils/TuneMatMulTiles.py to time candidate
+// tile sizes passed with --tiling-db.
+//   * Time is set to report in miliseconds (ms)
+//   * Default opt level is O3, options found in PERF_ARGS override default.
+//
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/CommandLine.h"
+
+#include "include/OnnxMlirCompiler.h"
+#include "test/modellib/ModelLib.hpp"
+#include "test/perf/PerfHelper.hpp"
+
+const std::string modelName("./perfmatmultuning");
+
+static llvm::cl::opt<std::string> tuningShapes("perf-tuning-shapes",
+    llvm::cl::desc("Comma separated list of op:IxJxK problem sizes to "
+                   "benchmark, where op is gemm or matmul."),
+    llvm::cl::init("gemm:256x256x256,matmul:256x256x256"));
+
+static void BM_TunedGemm(benchmark::State &state, int I, int J, int K) {
+  onnx_mlir::test::GemmLibBuilder model(
+      modelName, I, J, K, false, false, 1, 1.0, 0.0);
+  assert(model.build() && model.compileAndLoad() && model.prepareInputs() &&
+         "failed gemm");
+  for (auto _ : state)
+    model.run();
+  perf_recordFlops(state, 1.0 * I * J * (2.0 * K - 1.0));
+}
+
+static void BM_TunedMatMul(benchmark::State &state, int I, int J, int K) {
+  onnx_mlir::test::MatMul2DLibBuilder model(modelName, I, J, K);
+  assert(model.build() && model.compileAndLoad() && model.prepareInputs() &&
+         "failed matmul");
+  for (auto _ : state)
+    model.run();
+  perf_recordFlops(state, 2.0 * I * J * K);
+}
+
+// Register one benchmark per problem size, named after the op and the size
+// e.g. "gemm:128x1024x1024", once the options in PERF_ARGS are known.
+static void registerTuningBenchmarks() {
+  llvm::SmallVector<llvm::StringRef, 4> shapes;
+  llvm::StringRef(tuningShapes).split(shapes, ',', -1, false);
+  for (llvm::StringRef shape : shapes) {
+    shape = shape.trim();
+    auto opAndSizes = shape.split(':');
+    llvm::SmallVector<llvm::StringRef, 3> sizes;
+    opAndSizes.second.split(sizes, 'x');
+    int I, J, K;
+    if (sizes.size() != 3 || sizes[0].getAsInteger(10, I) ||
+        sizes[1].getAsInteger(10, J) || sizes[2].getAsInteger(10, K)) {
+      llvm::errs() << "ignore ill-formed tuning shape '" << shape << "'\n";
+      continue;
+    }
+    benchmark::internal::Benchmark *bm;
+    if (opAndSizes.first == "gemm")
+      bm = benchmark::RegisterBenchmark(
+          shape.str().c_str(), BM_TunedGemm, I, J, K);
+    else if (opAndSizes.first == "matmul")
+      bm = benchmark::RegisterBenchmark(
+          shape.str().c_str(), BM_TunedMatMul, I, J, K);
+    else {
+      llvm::errs() << "ignore tuning shape of unknown op '" << shape << "'\n";
+      continue;
+    }
+    bm->Unit(benchmark::kMillisecond);
+  }
+}
+
+// Will set opt at -O3.
+int main(int argc, char **argv) {
+  return perf_main(argc, argv, registerTuningBenchmarks);
+}
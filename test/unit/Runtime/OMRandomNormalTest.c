@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------- OMRandomNormalTest.c - OMRandomNormal Unit Test --------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the random normal values of the runtime.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void get_random_normal_value_f64(
+    double *result, int64_t size, double mean, double scale, double seed);
+void get_random_normal_value_f32(
+    float *result, int64_t size, float mean, float scale, float seed);
+void get_random_normal_range_value_f64(double *result, int64_t begin,
+    int64_t end, double mean, double scale, double seed);
+void get_random_normal_range_value_f32(float *result, int64_t begin,
+    int64_t end, float mean, float scale, float seed);
+
+#define SIZE 100003
+
+// Check the mean and standard deviation of the values.
+static void assertMoments(const double *values, int64_t size, double mean,
+    double scale) {
+  double sum = 0, sumSquares = 0;
+  for (int64_t i = 0; i < size; ++i) {
+    sum += values[i];
+    sumSquares += (values[i] - mean) * (values[i] - mean);
+  }
+  assert(fabs(sum / size - mean) < 0.02 * scale);
+  assert(fabs(sqrt(sumSquares / size) - scale) < 0.02 * scale);
+}
+
+void testRandomNormalF64() {
+  double *values = (double *)malloc(SIZE * sizeof(double));
+  double *other = (double *)malloc(SIZE * sizeof(double));
+  assert(values && other);
+
+  get_random_normal_value_f64(values, SIZE, 2.0, 3.0, 42.0);
+  assertMoments(values, SIZE, 2.0, 3.0);
+
+  // Same seed, same values, whatever the size of the output.
+  get_random_normal_value_f64(other, SIZE, 2.0, 3.0, 42.0);
+  assert(memcmp(values, other, SIZE * sizeof(double)) == 0);
+  get_random_normal_value_f64(other, 5001, 2.0, 3.0, 42.0);
+  assert(memcmp(values, other, 5001 * sizeof(double)) == 0);
+
+  // Ranges, as filled in parallel by the compiled code, give the same values.
+  memset(other, 0, SIZE * sizeof(double));
+  get_random_normal_range_value_f64(other, 5001, SIZE, 2.0, 3.0, 42.0);
+  get_random_normal_range_value_f64(other, 0, 5001, 2.0, 3.0, 42.0);
+  assert(memcmp(values, other, SIZE * sizeof(double)) == 0);
+
+  // Different seeds, different values.
+  get_random_normal_value_f64(other, SIZE, 2.0, 3.0, 43.0);
+  assert(memcmp(values, other, SIZE * sizeof(double)) != 0);
+
+  free(values);
+  free(other);
+}
+
+void testRandomNormalF32() {
+  float *values = (float *)malloc(SIZE * sizeof(float));
+  float *other = (float *)malloc(SIZE * sizeof(float));
+  double *moments = (double *)malloc(SIZE * sizeof(double));
+  assert(values && other && moments);
+
+  get_random_normal_value_f32(values, SIZE, -1.0f, 0.5f, 7.0f);
+  for (int64_t i = 0; i < SIZE; ++i) {
+    assert(isfinite(values[i]));
+    moments[i] = values[i];
+  }
+  assertMoments(moments, SIZE, -1.0, 0.5);
+
+  // Same seed, same values, whatever the size of the output.
+  get_random_normal_value_f32(other, SIZE, -1.0f, 0.5f, 7.0f);
+  assert(memcmp(values, other, SIZE * sizeof(float)) == 0);
+  for (int64_t size = 1; size < 10; ++size) {
+    get_random_normal_value_f32(other, size, -1.0f, 0.5f, 7.0f);
+    assert(memcmp(values, other, size * sizeof(float)) == 0);
+  }
+  get_random_normal_value_f32(other, 4097, -1.0f, 0.5f, 7.0f);
+  assert(memcmp(values, other, 4097 * sizeof(float)) == 0);
+
+  // Ranges, as filled in parallel by the compiled code, give the same values.
+  memset(other, 0, SIZE * sizeof(float));
+  for (int64_t begin = 0; begin < SIZE; begin += 65537) {
+    int64_t end = begin + 65537 < SIZE ? begin + 65537 : SIZE;
+    get_random_normal_range_value_f32(other, begin, end, -1.0f, 0.5f, 7.0f);
+  }
+  assert(memcmp(values, other, SIZE * sizeof(float)) == 0);
+  get_random_normal_range_value_f32(other, 3, 6, -1.0f, 0.5f, 7.0f);
+  assert(memcmp(values, other, SIZE * sizeof(float)) == 0);
+
+  // Different seeds, different values.
+  get_random_normal_value_f32(other, SIZE, -1.0f, 0.5f, 7.5f);
+  assert(memcmp(values, other, SIZE * sizeof(float)) != 0);
+
+  free(values);
+  free(other);
+  free(moments);
+}
+
+int main(int argc, char *argv[]) {
+  testRandomNormalF64();
+  testRandomNormalF32();
+  printf("All tests passed\n");
+  return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------------ OMResizeTest.c - OMResize Unit Test ---------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the Resize runtime, with the expected
+// values of the ONNX backend tests.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "OnnxMlirRuntime.h"
+
+void Resize_Scales(OMTensor *output, OMTensor *data, OMTensor *scales,
+    char *coordinate_transformation_mode_str, double coeff_a,
+    int64_t exclude_outside, double extrapolation_value, char *mode_str,
+    char *nearest_mode);
+void Resize_Size(OMTensor *output, OMTensor *data, OMTensor *size,
+    char *coordinate_transformation_mode_str, double coeff_a,
+    int64_t exclude_outside, double extrapolation_value, char *mode_str,
+    char *nearest_mode);
+void Resize_Scales_Planes(OMTensor *output, OMTensor *data, OMTensor *scales,
+    int64_t outerRank, int64_t begin, int64_t end,
+    char *coordinate_transformation_mode_str, double coeff_a,
+    int64_t exclude_outside, double extrapolation_value, char *mode_str,
+    char *nearest_mode);
+
+static float data2x2[4] = {1, 2, 3, 4};
+static float data2x4[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+static float data4x4[16] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+// Resize a 1x1xHxW float tensor with scales 1x1xSxS and compare the output to
+// the expected one.
+static void checkResizeScales(float *input, int64_t h, int64_t w, float scale,
+    int64_t outH, int64_t outW, const char *coordMode, double coeffA,
+    int64_t excludeOutside, const char *mode, const float *expected) {
+  int64_t inShape[4] = {1, 1, h, w};
+  int64_t outShape[4] = {1, 1, outH, outW};
+  int64_t scalesShape[1] = {4};
+  float scales[4] = {1, 1, scale, scale};
+  float output[64];
+  assert(outH * outW <= 64);
+  OMTensor *in = omTensorCreate(input, inShape, 4, ONNX_TYPE_FLOAT);
+  OMTensor *out = omTensorCreate(output, outShape, 4, ONNX_TYPE_FLOAT);
+  OMTensor *sc = omTensorCreate(scales, scalesShape, 1, ONNX_TYPE_FLOAT);
+  Resize_Scales(out, in, sc, (char *)coordMode, coeffA, excludeOutside, 0.0,
+      (char *)mode, (char *)"round_prefer_floor");
+  for (int64_t i = 0; i < outH * outW; ++i)
+    assert(fabsf(output[i] - expected[i]) < 1e-5f);
+  omTensorDestroy(in);
+  omTensorDestroy(out);
+  omTensorDestroy(sc);
+}
+
+void testResizeLinear() {
+  const float upsample[16] = {1.0, 1.25, 1.75, 2.0, 1.5, 1.75, 2.25, 2.5, 2.5,
+      2.75, 3.25, 3.5, 3.0, 3.25, 3.75, 4.0};
+  checkResizeScales(data2x2, 2, 2, 2.0f, 4, 4, "half_pixel", -0.75, 0,
+      "linear", upsample);
+
+  const float downsample[2] = {2.6666665, 4.3333331};
+  checkResizeScales(data2x4, 2, 4, 0.6f, 1, 2, "half_pixel", -0.75, 0,
+      "linear", downsample);
+
+  const float alignCorners[16] = {1.0, 1.33333333, 1.66666667, 2.0,
+      1.66666667, 2.0, 2.33333333, 2.66666667, 2.33333333, 2.66666667, 3.0,
+      3.33333333, 3.0, 3.33333333, 3.66666667, 4.0};
+  checkResizeScales(data2x2, 2, 2, 2.0f, 4, 4, "align_corners", -0.75, 0,
+      "linear", alignCorners);
+
+  // The resized length of align_corners is not rounded, here 2.4 for 4.
+  const float downsampleAlignCorners[2] = {1.0, 3.142857};
+  checkResizeScales(data2x4, 2, 4, 0.6f, 1, 2, "align_corners", -0.75, 0,
+      "linear", downsampleAlignCorners);
+}
+
+void testResizeCubic() {
+  const float upsample[64] = {0.47265625, 0.76953125, 1.24609375, 1.875,
+      2.28125, 2.91015625, 3.38671875, 3.68359375, 1.66015625, 1.95703125,
+      2.43359375, 3.0625, 3.46875, 4.09765625, 4.57421875, 4.87109375,
+      3.56640625, 3.86328125, 4.33984375, 4.96875, 5.375, 6.00390625,
+      6.48046875, 6.77734375, 6.08203125, 6.37890625, 6.85546875, 7.484375,
+      7.890625, 8.51953125, 8.99609375, 9.29296875, 7.70703125, 8.00390625,
+      8.48046875, 9.109375, 9.515625, 10.14453125, 10.62109375, 10.91796875,
+      10.22265625, 10.51953125, 10.99609375, 11.625, 12.03125, 12.66015625,
+      13.13671875, 13.43359375, 12.12890625, 12.42578125, 12.90234375,
+      13.53125, 13.9375, 14.56640625, 15.04296875, 15.33984375, 13.31640625,
+      13.61328125, 14.08984375, 14.71875, 15.125, 15.75390625, 16.23046875,
+      16.52734375};
+  checkResizeScales(data4x4, 4, 4, 2.0f, 8, 8, "half_pixel", -0.75, 0,
+      "cubic", upsample);
+
+  const float downsample[9] = {1.47119141, 2.78125, 4.08251953, 6.71142578,
+      8.02148438, 9.32275391, 11.91650391, 13.2265625, 14.52783203};
+  checkResizeScales(data4x4, 4, 4, 0.8f, 3, 3, "half_pixel", -0.75, 0,
+      "cubic", downsample);
+
+  const float excludeOutside[9] = {1.36812675, 2.6695014, 4.0133367,
+      6.57362535, 7.875, 9.2188353, 11.94896657, 13.25034122, 14.59417652};
+  checkResizeScales(data4x4, 4, 4, 0.8f, 3, 3, "half_pixel", -0.5, 1,
+      "cubic", excludeOutside);
+}
+
+void testResizeSize() {
+  // Same as the linear upsample, with sizes instead of scales.
+  const float expected[16] = {1.0, 1.25, 1.75, 2.0, 1.5, 1.75, 2.25, 2.5, 2.5,
+      2.75, 3.25, 3.5, 3.0, 3.25, 3.75, 4.0};
+  int64_t inShape[4] = {1, 1, 2, 2};
+  int64_t outShape[4] = {1, 1, 4, 4};
+  int64_t sizesShape[1] = {4};
+  int64_t sizes[4] = {1, 1, 4, 4};
+  float output[16];
+  OMTensor *in = omTensorCreate(data2x2, inShape, 4, ONNX_TYPE_FLOAT);
+  OMTensor *out = omTensorCreate(output, outShape, 4, ONNX_TYPE_FLOAT);
+  OMTensor *sz = omTensorCreate(sizes, sizesShape, 1, ONNX_TYPE_INT64);
+  Resize_Size(out, in, sz, (char *)"half_pixel", -0.75, 0, 0.0,
+      (char *)"linear", (char *)"round_prefer_floor");
+  for (int64_t i = 0; i < 16; ++i)
+    assert(fabsf(output[i] - expected[i]) < 1e-5f);
+  omTensorDestroy(in);
+  omTensorDestroy(out);
+  omTensorDestroy(sz);
+}
+
+void testResizeScalar() {
+  // A scalar has no axis to resize and is copied.
+  float input = 3.5f, output = 0.0f, scales[1] = {1};
+  int64_t scalesShape[1] = {0};
+  OMTensor *in = omTensorCreate(&input, NULL, 0, ONNX_TYPE_FLOAT);
+  OMTensor *out = omTensorCreate(&output, NULL, 0, ONNX_TYPE_FLOAT);
+  OMTensor *sc = omTensorCreate(scales, scalesShape, 1, ONNX_TYPE_FLOAT);
+  Resize_Scales(out, in, sc, (char *)"half_pixel", -0.75, 0, 0.0,
+      (char *)"linear", (char *)"round_prefer_floor");
+  assert(output == input);
+  omTensorDestroy(in);
+  omTensorDestroy(out);
+  omTensorDestroy(sc);
+}
+
+void testResizePlanes() {
+  // Resizing the 2x3 planes of a 2x3x2x2 tensor one range of planes at a
+  // time, as the parallel loop of the lowering does, gives the whole output.
+  int64_t inShape[4] = {2, 3, 2, 2};
+  int64_t outShape[4] = {2, 3, 4, 4};
+  int64_t scalesShape[1] = {4};
+  float scales[4] = {1, 1, 2, 2};
+  float input[24], expected[96], output[96];
+  for (int64_t i = 0; i < 24; ++i)
+    input[i] = (float)(i * i % 7);
+  OMTensor *in = omTensorCreate(input, inShape, 4, ONNX_TYPE_FLOAT);
+  OMTensor *sc = omTensorCreate(scales, scalesShape, 1, ONNX_TYPE_FLOAT);
+  OMTensor *whole = omTensorCreate(expected, outShape, 4, ONNX_TYPE_FLOAT);
+  OMTensor *out = omTensorCreate(output, outShape, 4, ONNX_TYPE_FLOAT);
+  Resize_Scales(whole, in, sc, (char *)"half_pixel", -0.75, 0, 0.0,
+      (char *)"cubic", (char *)"round_prefer_floor");
+  Resize_Scales_Planes(out, in, sc, 2, 0, 4, (char *)"half_pixel", -0.75, 0,
+      0.0, (char *)"cubic", (char *)"round_prefer_floor");
+  Resize_Scales_Planes(out, in, sc, 2, 4, 6, (char *)"half_pixel", -0.75, 0,
+      0.0, (char *)"cubic", (char *)"round_prefer_floor");
+  for (int64_t i = 0; i < 96; ++i)
+    assert(output[i] == expected[i]);
+  omTensorDestroy(in);
+  omTensorDestroy(sc);
+  omTensorDestroy(whole);
+  omTensorDestroy(out);
+}
+
+int main(int argc, char *argv[]) {
+  testResizeLinear();
+  testResizeCubic();
+  testResizeSize();
+  testResizeScalar();
+  testResizePlanes();
+  printf("All tests passed\n");
+  return 0;
+}
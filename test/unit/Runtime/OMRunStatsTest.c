@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------------- OMRunStatsTest.c - OMRunStats Unit Test -------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the statistics of the inferences.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Check that the measured latency is within 1.6% of the expected one.
+static void assertLatency(double latencyNs, double expectedNs) {
+  assert(fabs(latencyNs - expectedNs) <= 0.016 * expectedNs);
+}
+
+void testOMRunStatsRecord() {
+  OMRunStats *stats = omRunStatsCreate("mnist");
+  assert(stats);
+  assert(omRunStatsGetCalls(stats, "run_main_graph") == 0);
+  assert(omRunStatsGetLatencyNs(stats, "run_main_graph", 0.5) == -1);
+
+  // 1000 inferences from 1 to 1000 us, and 10 errors.
+  for (int i = 1; i <= 1000; ++i)
+    omRunStatsRecord(stats, "run_main_graph", (uint64_t)i * 1000, false);
+  for (int i = 0; i < 10; ++i)
+    omRunStatsRecord(stats, "run_main_graph", 0, true);
+  omRunStatsRecord(stats, "run_other", 20, false);
+
+  assert(omRunStatsGetCalls(stats, "run_main_graph") == 1010);
+  assert(omRunStatsGetErrors(stats, "run_main_graph") == 10);
+  assertLatency(omRunStatsGetLatencyNs(stats, "run_main_graph", 0.5), 500e3);
+  assertLatency(omRunStatsGetLatencyNs(stats, "run_main_graph", 0.9), 900e3);
+  assertLatency(omRunStatsGetLatencyNs(stats, "run_main_graph", 0.99), 990e3);
+  assertLatency(omRunStatsGetLatencyNs(stats, "run_main_graph", 1.0), 1000e3);
+  // Latencies below 64 ns are exact.
+  assert(omRunStatsGetLatencyNs(stats, "run_other", 0.5) == 20.5);
+
+  char *text = omRunStatsToPrometheus(stats);
+  assert(text);
+  assert(strstr(text, "# TYPE onnx_mlir_inference_latency_seconds summary\n"));
+  assert(strstr(text, "onnx_mlir_inference_calls_total{entry_point="
+                      "\"run_main_graph\",model=\"mnist\"} 1010\n"));
+  assert(strstr(text, "onnx_mlir_inference_errors_total{entry_point="
+                      "\"run_main_graph\",model=\"mnist\"} 10\n"));
+  assert(strstr(text, "onnx_mlir_inference_latency_seconds{entry_point="
+                      "\"run_main_graph\",model=\"mnist\","
+                      "quantile=\"0.999\"}"));
+  assert(strstr(text, "onnx_mlir_inference_latency_seconds_sum{entry_point="
+                      "\"run_main_graph\",model=\"mnist\"} 0.5005\n"));
+  assert(strstr(text, "onnx_mlir_inference_latency_seconds_count{entry_point="
+                      "\"run_main_graph\",model=\"mnist\"} 1000\n"));
+  free(text);
+
+  omRunStatsReset(stats);
+  assert(omRunStatsGetCalls(stats, "run_main_graph") == 0);
+  assert(omRunStatsGetLatencyNs(stats, "run_main_graph", 0.5) == -1);
+  omRunStatsDestroy(stats);
+}
+
+int main() {
+  testOMRunStatsRecord();
+  return 0;
+}
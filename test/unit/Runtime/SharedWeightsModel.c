@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- SharedWeightsModel.c - Model library with weights --------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains a model library defining the symbols that the compiler
+// emits for a model with constants, so that the sharing of libraries between
+// execution sessions can be tested without compiling a model. The model
+// returns the sum of its input and of its first weight.
+//
+//===----------------------------------------------------------------------===//
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Large enough to span many pages of the read-only segment.
+static const float weights[1 << 18] = {42.0f};
+
+OMTensorList *run_main_graph(OMTensorList *input) {
+  if (omTensorListGetSize(input) != 1) {
+    errno = EINVAL;
+    return NULL;
+  }
+  OMTensor *x = omTensorListGetOmtByIndex(input, 0);
+  int64_t shape[1] = {1};
+  OMTensor *y = omTensorCreateEmpty(shape, 1, ONNX_TYPE_FLOAT);
+  OMTensor **outputs = (OMTensor **)malloc(sizeof(OMTensor *));
+  if (!y || !outputs) {
+    omTensorDestroy(y);
+    free(outputs);
+    errno = ENOMEM;
+    return NULL;
+  }
+  // The weight is indexed by a value only known at run time, so that the
+  // weights are not folded into the code and stay in the library.
+  ((float *)omTensorGetDataPtr(y))[0] =
+      ((float *)omTensorGetDataPtr(x))[0] +
+      weights[omTensorGetNumElems(x) - 1];
+  outputs[0] = y;
+  return omTensorListCreateWithOwnership(outputs, 1, /*owning=*/1);
+}
+
+static const char *entryPoints[] = {"run_main_graph", NULL};
+
+const char *const *omQueryEntryPoints(int64_t *numOfEntryPoints) {
+  if (numOfEntryPoints)
+    *numOfEntryPoints = 1;
+  return entryPoints;
+}
+
+const char *omInputSignature(const char *entryPointName) {
+  return "[ { \"type\" : \"f32\" , \"dims\" : [1] , \"name\" : \"x\" } ]";
+}
+
+const char *omOutputSignature(const char *entryPointName) {
+  return "[ { \"type\" : \"f32\" , \"dims\" : [1] , \"name\" : \"y\" } ]";
+}
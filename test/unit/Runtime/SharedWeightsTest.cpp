@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------- SharedWeightsTest.cpp - Sharing of model libraries test ------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains tests of the sharing of model libraries between the
+// execution sessions of a process. A session loading a copy of the library
+// of another session uses the library of that session, unless sharing is
+// disabled, and either session can be destroyed first. A copy whose weights
+// were changed loads its own library.
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "src/Runtime/ExecutionSession.hpp"
+
+using namespace onnx_mlir;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      return false;                                                            \
+    }                                                                          \
+  } while (0)
+
+// Run the model on 1 and check that it adds its first weight.
+static bool runModel(ExecutionSession &session, float weight = 42.0f) {
+  int64_t shape[1] = {1};
+  float x = 1.0f;
+  std::vector<OMTensorUniquePtr> inputs;
+  inputs.emplace_back(OMTensorUniquePtr(
+      omTensorCreate(&x, shape, 1, ONNX_TYPE_FLOAT), omTensorDestroy));
+  std::vector<OMTensorUniquePtr> outputs = session.run(std::move(inputs));
+  CHECK(outputs.size() == 1);
+  CHECK(((float *)omTensorGetDataPtr(outputs[0].get()))[0] == 1.0f + weight);
+  return true;
+}
+
+// Load the model and its copy, and destroy the session of the original model
+// first if destroyOriginalFirst, and the one of the copy first otherwise.
+static bool testSharing(const std::string &model, const std::string &copy,
+    bool destroyOriginalFirst) {
+  auto original = std::make_unique<ExecutionSession>(model);
+  auto shared = std::make_unique<ExecutionSession>(copy);
+  CHECK(!original->sharesWeights());
+  CHECK(shared->sharesWeights());
+  CHECK(
+      original->getSharedLibraryHandle().getAddressOfSymbol("run_main_graph") ==
+      shared->getSharedLibraryHandle().getAddressOfSymbol("run_main_graph"));
+
+  // A session that does not share loads its own library.
+  ExecutionSession unshared(copy, /*defaultEntryPoint=*/true,
+      /*prefaultConstants=*/false, /*shareWeights=*/false);
+  CHECK(!unshared.sharesWeights());
+  CHECK(runModel(unshared));
+
+  if (destroyOriginalFirst) {
+    original.reset();
+    CHECK(runModel(*shared));
+  } else {
+    shared.reset();
+    CHECK(runModel(*original));
+  }
+  return true;
+}
+
+// Copy the model, replacing its first weight, 42, by 24. The library has the
+// same size, code and signatures as the model but other constants.
+static bool copyWithOtherWeights(
+    const std::string &model, const std::string &copy) {
+  std::ifstream in(model, std::ios::binary);
+  std::string bytes(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  // The weight is followed by the zeros of the rest of the weights.
+  float weight = 42.0f;
+  std::string pattern(reinterpret_cast<const char *>(&weight), sizeof(float));
+  pattern.append(64, '\0');
+  size_t offset = bytes.find(pattern);
+  CHECK(offset != std::string::npos);
+  weight = 24.0f;
+  memcpy(&bytes[offset], &weight, sizeof(float));
+  std::ofstream out(copy, std::ios::binary);
+  out.write(bytes.data(), bytes.size());
+  CHECK(out.good());
+  return true;
+}
+
+// Load the model and a copy with other weights, which must not be shared.
+static bool testNoSharingOfOtherWeights(
+    const std::string &model, const std::string &copy) {
+  ExecutionSession original(model);
+  ExecutionSession other(copy);
+  CHECK(!other.sharesWeights());
+  CHECK(runModel(original));
+  CHECK(runModel(other, 24.0f));
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+#if defined(__linux__)
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <model library>\n", argv[0]);
+    return 1;
+  }
+  std::string model = argv[1];
+  llvm::SmallString<128> copy;
+  if (llvm::sys::fs::createTemporaryFile("SharedWeightsModel", "so", copy) ||
+      llvm::sys::fs::copy_file(model, copy)) {
+    fprintf(stderr, "Cannot copy %s\n", model.c_str());
+    return 1;
+  }
+  bool passed = testSharing(model, copy.str().str(), true) &&
+                testSharing(model, copy.str().str(), false);
+  llvm::sys::fs::remove(copy);
+  llvm::SmallString<128> otherCopy;
+  if (passed && llvm::sys::fs::createTemporaryFile(
+                    "SharedWeightsModelOther", "so", otherCopy)) {
+    fprintf(stderr, "Cannot create a copy of %s\n", model.c_str());
+    return 1;
+  }
+  passed = passed &&
+           copyWithOtherWeights(model, otherCopy.str().str()) &&
+           testNoSharingOfOtherWeights(model, otherCopy.str().str());
+  llvm::sys::fs::remove(otherCopy);
+  if (!passed)
+    return 1;
+#endif
+  // Libraries are only shared on Linux.
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "include/onnx-mlir/Runtime/OMInstrument.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// Tags of instrument points before and after an op.
+static const int64_t beforeTag = 1;
+static const int64_t afterTag = 2;
+
+// Run the allocations of a model compiled with --instrument-allocations: a
+// MatMul allocating its 1 MB output, freed after a Relu allocating 2 MB.
+static void runModel() {
+  OMInstrumentPoint("onnx.MatMul", beforeTag, "matmul/node");
+  void *matMulOutput = omInstrumentMalloc(1000000);
+  OMInstrumentPoint("onnx.MatMul", afterTag, "matmul/node");
+  OMInstrumentPoint("onnx.Relu", beforeTag, "NOTSET");
+  void *reluOutput = omInstrumentMalloc(2000000);
+  omInstrumentFree(matMulOutput);
+  OMInstrumentPoint("onnx.Relu", afterTag, "NOTSET");
+  omInstrumentFree(reluOutput);
+}
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      return 1;                                                                \
+    }                                                                          \
+  } while (0)
+
+int main(int argc, char *argv[]) {
+#ifdef _WIN32
+  // Allocation tracking is not supported on Windows.
+  return 0;
+#else
+  // Nothing is reported before a model allocates through the runtime.
+  CHECK(omInstrumentReport() == NULL);
+
+  std::thread worker(runModel);
+  worker.join();
+  runModel();
+  // An allocation outside of any instrumented op stays live.
+  void *modelBuffer = omInstrumentMalloc(500);
+
+  char *report = omInstrumentReport();
+  CHECK(report);
+  std::string reportStr(report);
+  free(report);
+  printf("%s", reportStr.c_str());
+  CHECK(reportStr.find("peak 3.000 MB, live 0.001 MB, 5 allocs, 4 frees") !=
+        std::string::npos);
+  CHECK(reportStr.find("peak reached in onnx.Relu\n") != std::string::npos);
+  // Relu allocates the most and comes first.
+  size_t reluPos = reportStr.find("onnx.Relu\n", reportStr.find("rank"));
+  size_t matMulPos = reportStr.find("onnx.MatMul (matmul/node)");
+  size_t modelPos = reportStr.find("(model)");
+  CHECK(reluPos != std::string::npos && matMulPos != std::string::npos &&
+        modelPos != std::string::npos);
+  CHECK(reluPos < matMulPos && matMulPos < modelPos);
+
+  // Live allocations are kept after a reset.
+  omInstrumentReset();
+  runModel();
+  report = omInstrumentReport();
+  CHECK(report);
+  reportStr = report;
+  free(report);
+  CHECK(reportStr.find("peak 3.001 MB, live 0.001 MB, 2 allocs, 2 frees") !=
+        std::string::npos);
+  omInstrumentFree(modelBuffer);
+  return 0;
+#endif
+}
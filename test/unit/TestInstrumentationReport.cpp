@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "include/onnx-mlir/Runtime/OMInstrument.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// Tags of instrument points before and after an op reporting time, and of a
+// MatMul of 1 MFLOP also reporting hardware counters.
+static const int64_t beforeTag = 1 | 4;
+static const int64_t afterTag = 2 | 4;
+static const int64_t matMulFlops =
+    ((int64_t)1000000 << OM_INSTRUMENT_FLOPS_SHIFT) | 16;
+
+static void runOps(int numOps) {
+  for (int i = 0; i < numOps; ++i) {
+    OMInstrumentPoint("onnx.MatMul", beforeTag | matMulFlops, "matmul/node");
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    OMInstrumentPoint("onnx.MatMul", afterTag | matMulFlops, "matmul/node");
+    OMInstrumentPoint("onnx.Relu", afterTag, "NOTSET");
+  }
+}
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      return 1;                                                                \
+    }                                                                          \
+  } while (0)
+
+int main(int argc, char *argv[]) {
+#ifdef _WIN32
+  // Profiling is not supported on Windows.
+  return 0;
+#else
+  setenv("OMINSTRUMENTPROFILE", "1", /*overwrite=*/1);
+  OMInstrumentInit();
+
+  // Nothing must be printed when profiling.
+  std::thread worker(runOps, 10);
+  runOps(10);
+  worker.join();
+
+  char *report = omInstrumentReport();
+  CHECK(report);
+  std::string reportStr(report);
+  free(report);
+  printf("%s", reportStr.c_str());
+  CHECK(reportStr.find("40 calls of 2 ops") != std::string::npos);
+  // MatMul is the hotspot, and comes first with its FLOP rate.
+  size_t matMulPos = reportStr.find("onnx.MatMul (matmul/node)");
+  size_t reluPos = reportStr.find("onnx.Relu\n");
+  CHECK(matMulPos != std::string::npos && reluPos != std::string::npos);
+  CHECK(matMulPos < reluPos);
+  CHECK(reportStr.find("      20 ") != std::string::npos);
+  // Hardware counters are not available in all environments, e.g. in
+  // containers, but come with instructions per cycle when they are.
+  if (reportStr.find("Cycles") != std::string::npos &&
+      reportStr.find("Instructions") != std::string::npos)
+    CHECK(reportStr.find("IPC") != std::string::npos);
+
+  omInstrumentReset();
+  report = omInstrumentReport();
+  CHECK(report);
+  reportStr = report;
+  free(report);
+  CHECK(reportStr.find("0 calls of 0 ops") != std::string::npos);
+  return 0;
+#endif
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "include/onnx-mlir/Runtime/OMInstrument.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+// Tag of instrument points before and after an op, reporting time and memory.
+static const int64_t beforeTag = 1 | 4 | 8;
+static const int64_t afterTag = 2 | 4 | 8;
+
+static void runOps(int numOps) {
+  for (int i = 0; i < numOps; ++i) {
+    OMInstrumentPoint("onnx.MatMul", beforeTag, "matmul/node");
+    OMInstrumentPoint("onnx.MatMul", afterTag, "matmul/node");
+    OMInstrumentPoint("onnx.Relu", afterTag, "NOTSET");
+  }
+}
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      return 1;                                                                \
+    }                                                                          \
+  } while (0)
+
+int main(int argc, char *argv[]) {
+#ifdef _WIN32
+  // Tracing is not supported on Windows.
+  return 0;
+#else
+  const std::string jsonPath = "./TestInstrumentationTrace.json";
+  const std::string binaryPath = "./TestInstrumentationTrace.bin";
+  setenv("OMINSTRUMENTTRACE", jsonPath.c_str(), /*overwrite=*/1);
+  OMInstrumentInit();
+
+  // Nothing must be printed when tracing.
+  std::thread worker(runOps, 10);
+  runOps(5);
+  worker.join();
+
+  CHECK(OMInstrumentTraceFlush(nullptr) == 0);
+  std::ifstream jsonFile(jsonPath);
+  std::stringstream json;
+  json << jsonFile.rdbuf();
+  CHECK(json.str().find("\"traceEvents\"") != std::string::npos);
+  CHECK(json.str().find("\"name\": \"onnx.MatMul\"") != std::string::npos);
+  CHECK(json.str().find("\"node\": \"matmul/node\"") != std::string::npos);
+  CHECK(json.str().find("\"ph\": \"X\"") != std::string::npos);
+  CHECK(json.str().find("\"ph\": \"B\"") == std::string::npos);
+
+  CHECK(OMInstrumentTraceFlush(binaryPath.c_str()) == 0);
+  FILE *binaryFile = fopen(binaryPath.c_str(), "rb");
+  CHECK(binaryFile);
+  OMTraceFileHeader header;
+  CHECK(fread(&header, sizeof(header), 1, binaryFile) == 1);
+  CHECK(strcmp(header.magic, OM_TRACE_MAGIC) == 0);
+  CHECK(header.version == OM_TRACE_VERSION);
+  CHECK(header.eventSize == sizeof(OMTraceEvent));
+  OMTraceEvent event;
+  int numEvents = 0, numMatMul = 0;
+  uint32_t tids = 0;
+  while (fread(&event, sizeof(event), 1, binaryFile) == 1) {
+    numEvents++;
+    tids |= 1 << event.tid;
+    if (strcmp(event.opName, "onnx.MatMul") == 0) {
+      numMatMul++;
+      CHECK(strcmp(event.nodeName, "matmul/node") == 0);
+    } else {
+      CHECK(event.nodeName[0] == 0);
+    }
+  }
+  fclose(binaryFile);
+  CHECK(numEvents == 3 * 15);
+  CHECK(numMatMul == 2 * 15);
+  CHECK(tids == 3);
+
+  // The json trace is written again at exit.
+  remove(binaryPath.c_str());
+  return 0;
+#endif
+}
@@ -58,6 +58,9 @@ auto printUsage = [](auto &out, const char *name) {
   command. When the input model is not found as is, the
   path to the local directory is also prepended.
 
+  When measuring, the latency percentiles, the throughput,
+  and the peak resident memory of the process are reported.
+
   Options:
     -d | -dim json-array
          Provide a json array to provide the value of every
@@ -72,24 +75,44 @@ auto printUsage = [](auto &out, const char *name) {
   out << R"""(
     -h | --help
          Print help message.
+    -j file | --json file
+         Write the measurements to a JSON file. Implies measuring.
     -n NUM | --iterations NUM
          Number of times to run the tests, default 1.
     -m NUM | --meas NUM
          Measure the kernel execution time NUM times.
+    -q QPS | --qps QPS
+         Open-loop mode: start inferences at a fixed rate of QPS
+         per second over all threads, regardless of completions.
+         Latencies are measured from the scheduled start time, so
+         they include queuing delays. Implies measuring.
     -r | -reuse true|false
          Reuse input data, default on
+    -t NUM | --threads NUM
+         Number of threads running inferences concurrently, each
+         with its own inputs, default 1. Each thread runs the
+         given number of iterations. Implies measuring.
     -v | --verbose
          Print the shape of the inputs and outputs.
+    -w NUM | --warmup NUM
+         Number of iterations run by each thread before measuring,
+         default 0.
 
   )""";
 };
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <dlfcn.h>
+#include <fstream>
+#include <future>
 #include <getopt.h>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Json reader & LLVM support.
@@ -103,7 +126,7 @@ using namespace std;
 #ifdef _WIN32
 // TO BE FIXED
 #else
-#include <sys/time.h>
+#include <sys/resource.h>
 #endif
 // Data structure to hold measurement times (in microseconds).
 vector<uint64_t> timeLogInMicroSec;
@@ -132,7 +155,7 @@ void (*dll_omTensorListDestroy)(OMTensorList *);
 #define OM_TENSOR_CREATE omTensorCreateWithOwnership
 #define OM_TENSOR_LIST_CREATE omTensorListCreateWithOwnership
 #define OM_TENSOR_LIST_DESTROY omTensorListDestroy
-#define OPTIONS "hn:m:vd:r:"
+#define OPTIONS "hj:n:m:q:t:vw:d:r:"
 #else
 #define RUN_MAIN_GRAPH dll_run_main_graph
 #define OM_INPUT_SIGNATURE dll_omInputSignature
@@ -140,7 +163,7 @@ void (*dll_omTensorListDestroy)(OMTensorList *);
 #define OM_TENSOR_CREATE dll_omTensorCreateWithOwnership
 #define OM_TENSOR_LIST_CREATE dll_omTensorListCreateWithOwnership
 #define OM_TENSOR_LIST_DESTROY dll_omTensorListDestroy
-#define OPTIONS "e:hn:m:vd:r:"
+#define OPTIONS "e:hj:n:m:q:t:vw:d:r:"
 #endif
 
 // Global variables to record what we should do in this run.
@@ -149,6 +172,12 @@ static bool verbose = false;
 static bool reuseInput = true;
 static bool measureExecTime = false;
 static vector<int64_t> dimKnownAtRuntime;
+static int sWarmup = 0;
+static int sThreads = 1;
+static double sTargetQPS = 0; // Closed loop when 0.
+static string sJsonFileName;
+static string sModelName;
+static string sEntryPointName("run_main_graph");
 
 void usage(const char *name) {
   printUsage(cout, name);
@@ -198,10 +227,14 @@ void parseArgs(int argc, char **argv) {
       {"dim", required_argument, 0, 'd'},         // dimensions.
       {"entry-point", required_argument, 0, 'e'}, // Entry point.
       {"help", no_argument, 0, 'h'},              // Help.
+      {"json", required_argument, 0, 'j'},        // JSON result file.
       {"iterations", required_argument, 0, 'n'},  // Number of iterations.
       {"meas", required_argument, 0, 'm'},        // Measurement of time.
+      {"qps", required_argument, 0, 'q'},         // Open-loop rate.
       {"reuse", required_argument, 0, 'r'},       // cached input.
+      {"threads", required_argument, 0, 't'},     // Concurrent threads.
       {"verbose", no_argument, 0, 'v'},           // Verbose.
+      {"warmup", required_argument, 0, 'w'},      // Warmup iterations.
       {0, 0, 0, 0}};
 
   while (true) {
@@ -231,17 +264,25 @@ void parseArgs(int argc, char **argv) {
     case 'e':
       entryPointName = optarg;
       break;
+    case 'j':
+      sJsonFileName = optarg;
+      measureExecTime = true;
+      break;
     case 'n':
       sIterations = atoi(optarg);
       break;
     case 'm':
-#ifdef _WIN32
-      cout << "> Measurement option currently not available, ignore." << endl;
-      break;
-#endif
       sIterations = atoi(optarg);
       measureExecTime = true;
       break;
+    case 'q':
+      sTargetQPS = atof(optarg);
+      measureExecTime = true;
+      break;
+    case 't':
+      sThreads = atoi(optarg);
+      measureExecTime = true;
+      break;
     case 'r':
       if (strcmp(optarg, "true") == 0) {
         reuseInput = true;
@@ -257,13 +298,22 @@ void parseArgs(int argc, char **argv) {
     case 'v':
       verbose = true;
       break;
+    case 'w':
+      sWarmup = atoi(optarg);
+      break;
     default:
       usage(argv[0]);
     }
   }
-  // Make sure that iterations are positive.
+  // Make sure that iterations and threads are positive.
   if (sIterations < 1)
     sIterations = 1;
+  if (sThreads < 1)
+    sThreads = 1;
+  if (sWarmup < 0)
+    sWarmup = 0;
+  if (sTargetQPS < 0)
+    sTargetQPS = 0;
 
 // Process the DLL.
 #if LOAD_MODEL_STATICALLY
@@ -271,6 +321,7 @@ void parseArgs(int argc, char **argv) {
     cout << "Error: model.so was compiled in, cannot provide one now" << endl;
     usage(argv[0]);
   }
+  sModelName = "(compiled in)";
 #else
   if (optind == argc) {
     cout << "Error: need one model.so dynamic library" << endl;
@@ -278,6 +329,8 @@ void parseArgs(int argc, char **argv) {
   } else if (optind + 1 == argc) {
     string name = argv[optind];
     loadDLL(name, entryPointName);
+    sModelName = name;
+    sEntryPointName = entryPointName;
   } else {
     cout << "Error: handle only one model.so dynamic library at a time" << endl;
     usage(argv[0]);
@@ -400,51 +453,82 @@ OMTensorList *omTensorListCreateFromInputSignature(
   return OM_TENSOR_LIST_CREATE(inputTensors, inputNum, true);
 }
 
-// Data structures for timing info.
-#ifdef _WIN32
-#else
-struct timeval startTime, stopTime, result;
-#endif
+using Clock = chrono::steady_clock;
 
-// Process start time.
-#ifdef _WIN32
-inline void processStartTime() {}
-#else
-inline void processStartTime() {
-  if (!measureExecTime)
-    return;
-  gettimeofday(&startTime, NULL);
+static uint64_t elapsedMicroSec(Clock::time_point from, Clock::time_point to) {
+  return chrono::duration_cast<chrono::microseconds>(to - from).count();
 }
-#endif
 
-// Process stop time, store result in log.
-#ifdef _WIN32
-inline void processStopTime() {}
-#else
-inline void processStopTime() {
-  if (!measureExecTime)
-    return;
-  gettimeofday(&stopTime, NULL);
-  timersub(&stopTime, &startTime, &result);
-  uint64_t time =
-      (uint64_t)result.tv_sec * 1000000ull + (uint64_t)result.tv_usec;
-  timeLogInMicroSec.emplace_back(time);
+// Percentile of the sorted measured times, by nearest rank.
+static double percentile(double q) {
+  int s = timeLogInMicroSec.size();
+  int rank = (int)ceil(q * s);
+  return (double)timeLogInMicroSec[rank < 1 ? 0 : rank - 1];
 }
-#endif
 
-// Print timing info, removing shortest/longest measured time.
+// Print timing info.
 void printTime(double avg, double std, double factor, string unit) {
   int s = timeLogInMicroSec.size();
   int m = s / 2;
   printf("@time, %s, median, %.1f, avg, %.1f, std, %.1f, min, %.1f, max, %.1f, "
-         "sample, %d\n",
+         "sample, %d, p90, %.1f, p99, %.1f\n",
       unit.c_str(), (double)timeLogInMicroSec[m] / factor,
       (double)(avg / factor), (double)(std / factor),
       (double)timeLogInMicroSec[0] / factor,
-      (double)timeLogInMicroSec[s - 1] / factor, s);
+      (double)timeLogInMicroSec[s - 1] / factor, s, percentile(0.9) / factor,
+      percentile(0.99) / factor);
 }
 
-void displayTime() {
+// Peak resident set size of the process in kilobytes, -1 if unknown.
+static long maxRSSInKB() {
+#ifdef _WIN32
+  return -1;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return -1;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024; // In bytes on Mac.
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+void writeJson(double avg, double std, double throughput, long rss) {
+  ofstream out(sJsonFileName);
+  if (!out) {
+    cout << "Error: could not write " << sJsonFileName << endl;
+    return;
+  }
+  int s = timeLogInMicroSec.size();
+  // Model names are paths, escape their backslashes and quotes.
+  string model;
+  for (char c : sModelName) {
+    if (c == '\\' || c == '"')
+      model += '\\';
+    model += c;
+  }
+  out << "{\n"
+      << "  \"model\": \"" << model << "\",\n"
+      << "  \"entry_point\": \"" << sEntryPointName << "\",\n"
+      << "  \"threads\": " << sThreads << ",\n"
+      << "  \"iterations\": " << sIterations << ",\n"
+      << "  \"warmup\": " << sWarmup << ",\n"
+      << "  \"target_qps\": " << sTargetQPS << ",\n"
+      << "  \"samples\": " << s << ",\n"
+      << "  \"throughput\": " << throughput << ",\n"
+      << "  \"max_rss_kb\": " << rss << ",\n"
+      << "  \"latency_us\": {\"avg\": " << avg << ", \"std\": " << std
+      << ", \"min\": " << timeLogInMicroSec[0]
+      << ", \"p50\": " << percentile(0.5) << ", \"p90\": " << percentile(0.9)
+      << ", \"p99\": " << percentile(0.99)
+      << ", \"max\": " << timeLogInMicroSec[s - 1] << "}\n"
+      << "}\n";
+  cout << "Wrote measurements to " << sJsonFileName << endl;
+}
+
+void displayTime(double wallTimeInSec) {
   int s = timeLogInMicroSec.size();
   if (s == 0)
     return;
@@ -465,26 +549,43 @@ void displayTime() {
   if (avg >= 1e6) {
     printTime(avg, std, 1e6, "second");
   }
+  double throughput = wallTimeInSec > 0 ? s / wallTimeInSec : 0;
+  long rss = maxRSSInKB();
+  printf("@throughput, %.1f, inferences per second, threads, %d\n", throughput,
+      sThreads);
+  printf("@memory, max rss, %ld, KB\n", rss);
+  if (!sJsonFileName.empty())
+    writeJson(avg, std, throughput, rss);
 }
 
-// Perform generation of input, run, measure time,...
-int main(int argc, char **argv) {
-  // Init args.
-  parseArgs(argc, argv);
-  // Init inputs.
-  OMTensorList *tensorListIn =
-      omTensorListCreateFromInputSignature(nullptr, true, verbose, false);
-  assert(tensorListIn && "failed to scan signature");
-  // Call the compiled onnx model function.
-  cout << "Start computing " << sIterations << " iterations" << endl;
+// Run the warmup and measured iterations of one thread, on its own inputs.
+// Measured iterations start once every thread is warm. In open-loop mode,
+// iteration i of thread t is scheduled at (i * threads + t) / qps seconds
+// from the start, and its time is measured from that scheduled time.
+void runIterations(int t, OMTensorList *tensorListIn, atomic<int> &warmThreads,
+    shared_future<Clock::time_point> start, vector<uint64_t> &timeLog) {
+  for (int i = 0; i < sWarmup; ++i) {
+    OMTensorList *tensorListOut = RUN_MAIN_GRAPH(tensorListIn);
+    if (tensorListOut)
+      OM_TENSOR_LIST_DESTROY(tensorListOut);
+  }
+  warmThreads++;
+  Clock::time_point startTime = start.get();
   for (int i = 0; i < sIterations; ++i) {
-    OMTensorList *tensorListOut = nullptr;
-    processStartTime();
-    tensorListOut = RUN_MAIN_GRAPH(tensorListIn);
-    processStopTime();
+    Clock::time_point iterationStart = Clock::now();
+    if (sTargetQPS > 0) {
+      iterationStart =
+          startTime + chrono::duration_cast<Clock::duration>(
+                          chrono::duration<double>((i * sThreads + t) /
+                                                   sTargetQPS));
+      this_thread::sleep_until(iterationStart);
+    }
+    OMTensorList *tensorListOut = RUN_MAIN_GRAPH(tensorListIn);
+    if (measureExecTime)
+      timeLog.emplace_back(elapsedMicroSec(iterationStart, Clock::now()));
     if (tensorListOut)
       OM_TENSOR_LIST_DESTROY(tensorListOut);
-    if (i > 0 && i % 10 == 0)
+    if (t == 0 && i > 0 && i % 10 == 0)
       cout << "  computed " << i << " iterations" << endl;
     if (!reuseInput) {
       OM_TENSOR_LIST_DESTROY(tensorListIn);
@@ -492,10 +593,55 @@ int main(int argc, char **argv) {
           omTensorListCreateFromInputSignature(nullptr, true, false, true);
     }
   }
+  OM_TENSOR_LIST_DESTROY(tensorListIn);
+}
+
+// Perform generation of input, run, measure time,...
+int main(int argc, char **argv) {
+  // Init args.
+  parseArgs(argc, argv);
+  // Init inputs, one list per thread.
+  vector<OMTensorList *> tensorListIns;
+  for (int t = 0; t < sThreads; ++t) {
+    OMTensorList *tensorListIn = omTensorListCreateFromInputSignature(
+        nullptr, true, verbose && t == 0, t > 0);
+    assert(tensorListIn && "failed to scan signature");
+    tensorListIns.emplace_back(tensorListIn);
+  }
+  // Call the compiled onnx model function.
+  cout << "Start computing " << sIterations << " iterations";
+  if (sThreads > 1)
+    cout << " on each of " << sThreads << " threads";
+  if (sWarmup > 0)
+    cout << " after " << sWarmup << " warmup iterations";
+  cout << endl;
+  atomic<int> warmThreads(0);
+  promise<Clock::time_point> startPromise;
+  shared_future<Clock::time_point> start = startPromise.get_future().share();
+  vector<vector<uint64_t>> timeLogs(sThreads);
+  vector<thread> threads;
+  for (int t = 1; t < sThreads; ++t)
+    threads.emplace_back(runIterations, t, tensorListIns[t], ref(warmThreads),
+        start, ref(timeLogs[t]));
+  // The main thread is thread 0, it starts the measurements once all the
+  // threads are warm.
+  thread starter([&]() {
+    while (warmThreads < sThreads)
+      this_thread::sleep_for(chrono::microseconds(100));
+    startPromise.set_value(Clock::now());
+  });
+  runIterations(0, tensorListIns[0], warmThreads, start, timeLogs[0]);
+  for (thread &th : threads)
+    th.join();
+  Clock::time_point stopTime = Clock::now();
+  starter.join();
   cout << "Finish computing " << sIterations << " iterations" << endl;
-  displayTime();
 
-  // Cleanup.
-  OM_TENSOR_LIST_DESTROY(tensorListIn);
+  for (vector<uint64_t> &timeLog : timeLogs)
+    timeLogInMicroSec.insert(
+        timeLogInMicroSec.end(), timeLog.begin(), timeLog.end());
+  double wallTimeInSec =
+      chrono::duration<double>(stopTime - start.get()).count();
+  displayTime(wallTimeInSec);
   return 0;
 }
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+
+##################### TuneMatMulTiles.py #######################################
+#
+# Copyright 2022 The IBM Research Authors.
+#
+################################################################################
+#
+# This script tunes the tile sizes of the MatMul and Gemm lowerings for a list
+# of problem sizes on the current host. Each candidate tiling is compiled and
+# timed with the PerfMatMulTuning benchmark of test/perf, and the fastest
+# tiling of each problem size is written to a tiling database that is passed
+# to onnx-mlir with --tiling-db. Problem sizes for which no candidate beats the
+# default heuristics are left out of the database.
+#
+# Example:
+#   TuneMatMulTiles.py --perf-binary build/test/perf/PerfMatMulTuning \
+#       --mcpu=skylake-avx512 --shapes gemm:128x1024x1024,matmul:64x768x768 \
+#       --output tiling-skylake.json
+#
+################################################################################
+
+import argparse
+import itertools
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--perf-binary',
+                    type=str,
+                    required=True,
+                    help="Path to the PerfMatMulTuning benchmark")
+parser.add_argument('--shapes',
+                    type=str,
+                    required=True,
+                    help="Comma separated list of op:IxJxK problem sizes,"
+                    " where op is gemm or matmul")
+parser.add_argument('--mcpu',
+                    type=str,
+                    default="",
+                    help="Target cpu passed to onnx-mlir and recorded in the"
+                    " database entries. Entries without mcpu apply to any cpu")
+parser.add_argument('--output',
+                    type=str,
+                    required=True,
+                    help="Tiling database to write. Entries of an existing"
+                    " database are kept unless they are tuned again")
+parser.add_argument('--min-time',
+                    type=float,
+                    default=0.5,
+                    help="Min time in seconds to run each candidate")
+parser.add_argument('--compile-args',
+                    type=str,
+                    default="",
+                    help="Additional onnx-mlir options for all candidates")
+parser.add_argument('--verbose',
+                    action='store_true',
+                    help="Print the time of each candidate")
+args = parser.parse_args()
+
+# Candidate tile sizes. Register tiles must divide cache tiles, and jRegTile
+# is the SIMD vector length in the Gemm lowering.
+GEMM_CANDIDATES = {
+    'iCacheTile': [16, 32, 64, 128],
+    'jCacheTile': [64, 128, 256],
+    'kCacheTile': [128, 256, 512],
+    'iRegTile': [4, 8],
+    'jRegTile': [8, 16, 32],
+}
+MATMUL_CANDIDATES = {
+    'iRegTile': [2, 4, 6, 8],
+    'jRegTile': [4, 8, 16, 32],
+    'kRegTile': [4, 8, 16],
+}
+
+
+def candidates(op):
+    space = GEMM_CANDIDATES if op == 'gemm' else MATMUL_CANDIDATES
+    names = list(space.keys())
+    for values in itertools.product(*[space[n] for n in names]):
+        tiles = dict(zip(names, values))
+        if op == 'gemm' and (tiles['iCacheTile'] % tiles['iRegTile'] or
+                             tiles['jCacheTile'] % tiles['jRegTile']):
+            continue
+        yield tiles
+
+
+def make_entry(op, sizes, tiles):
+    # The benchmarked models are in f32.
+    entry = {'op': op, 'dtype': 'f32'}
+    if args.mcpu:
+        entry['mcpu'] = args.mcpu
+    entry.update(dict(zip(['I', 'J', 'K'], sizes)))
+    entry.update(tiles)
+    return entry
+
+
+def run_benchmark(shape, database):
+    """Return the time in ms of one problem size, compiled with the given
+    tiling database (None for the default heuristics)."""
+    perf_args = ['-O3', '--perf-tuning-shapes=' + shape]
+    if args.mcpu:
+        perf_args.append('--mcpu=' + args.mcpu)
+    if database:
+        perf_args.append('--tiling-db=' + database)
+    if args.compile_args:
+        perf_args.append(args.compile_args)
+    env = os.environ.copy()
+    env['PERF_ARGS'] = ' '.join(perf_args)
+    with tempfile.TemporaryDirectory() as work_dir:
+        out = subprocess.run([
+            os.path.abspath(args.perf_binary), '--benchmark_format=json',
+            '--benchmark_min_time={}'.format(args.min_time)
+        ],
+                             env=env,
+                             cwd=work_dir,
+                             stdout=subprocess.PIPE,
+                             stderr=subprocess.PIPE,
+                             check=True)
+    results = json.loads(out.stdout)['benchmarks']
+    return min(r['real_time'] for r in results if r['name'] == shape)
+
+
+def tune(shape, tmp_dir):
+    op, dims = shape.split(':')
+    sizes = [int(d) for d in dims.split('x')]
+    best_time = run_benchmark(shape, None)
+    best_tiles = None
+    print('{}: default tiling {:.3f} ms'.format(shape, best_time))
+    database = os.path.join(tmp_dir, 'candidate.json')
+    for tiles in candidates(op):
+        with open(database, 'w') as f:
+            json.dump({'entries': [make_entry(op, sizes, tiles)]}, f)
+        try:
+            time = run_benchmark(shape, database)
+        except subprocess.CalledProcessError as e:
+            print('{}: {} failed: {}'.format(shape, tiles, e.stderr.decode()),
+                  file=sys.stderr)
+            continue
+        if args.verbose:
+            print('{}: {} {:.3f} ms'.format(shape, tiles, time))
+        if time < best_time:
+            best_time, best_tiles = time, tiles
+    if best_tiles is None:
+        print('{}: keep default tiling'.format(shape))
+        return None
+    print('{}: best {} {:.3f} ms'.format(shape, best_tiles, best_time))
+    return make_entry(op, sizes, best_tiles)
+
+
+def main():
+    entries = []
+    if os.path.exists(args.output):
+        with open(args.output) as f:
+            entries = json.load(f)['entries']
+
+    def key(entry):
+        return (entry['op'], entry.get('mcpu', ''), entry['dtype'],
+                entry['I'], entry['J'], entry['K'])
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        for shape in args.shapes.split(','):
+            entry = tune(shape.strip(), tmp_dir)
+            if entry is None:
+                continue
+            entries = [e for e in entries if key(e) != key(entry)]
+            entries.append(entry)
+
+    with open(args.output, 'w') as f:
+        json.dump({'entries': sorted(entries, key=key)}, f, indent=2)
+    print('Wrote {} entries to {}'.format(len(entries), args.output))
+
+
+if __name__ == '__main__':
+    main()